@@ -0,0 +1,324 @@
+#include "AnimationMixer.h"
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			подготовка микшера для модели
+	 *	входящие значения:	model - модель с анимациями
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationMixer::Init(Model* model)
+	{
+		this->model = model;
+
+		if (model->clips.size() != model->animations.size())
+			model->CompileAnimations(model->animationSampleRate);
+
+		const size_t count = model->linearNodes.size();
+		nodeSlots.clear();
+		bindPose.Resize(count);
+		for (size_t slot = 0; slot < count; slot++)
+		{
+			Node* node = model->linearNodes[slot];
+			nodeSlots[node] = static_cast<uint32_t>(slot);
+			bindPose.Set(slot, node->translation, node->rotation, node->scale);
+		}
+
+		//соответствие узлов клипа узлам модели и опорные позы для аддитивных слоев
+		clipSlots.resize(model->clips.size());
+		referencePoses.resize(model->clips.size());
+		for (size_t c = 0; c < model->clips.size(); c++)
+		{
+			const AnimationClip& clip = model->clips[c];
+			clipSlots[c].resize(clip.nodes.size());
+			for (size_t i = 0; i < clip.nodes.size(); i++)
+				clipSlots[c][i] = nodeSlots[clip.nodes[i]];
+			clip.Sample(clip.start, referencePoses[c]);
+		}
+
+		pose = bindPose;
+		layerPose.Resize(count);
+		referencePose.Resize(count);
+		layerWeights.resize(count);
+		weightSums.resize(count);
+	}
+
+	/***********************************************
+	 *	функция:			AddLayer()
+	 *	назначение:			добавить слой анимации
+	 *	входящие значения:	clip - индекс клипа модели
+	 *						weight - вес слоя
+	 *						mode - режим смешивания
+	 *	выходящие значения:	индекс слоя
+	 **********************************************/
+	uint32_t AnimationMixer::AddLayer(uint32_t clip, float weight, BlendMode mode)
+	{
+		Layer layer{};
+		layer.clip = clip;
+		layer.weight = weight;
+		layer.mode = mode;
+		layers.push_back(layer);
+		return static_cast<uint32_t>(layers.size() - 1);
+	}
+
+	/***********************************************
+	 *	функция:			SetMask()
+	 *	назначение:			ограничить слой поддеревом узлов
+	 *	входящие значения:	layer - индекс слоя
+	 *						root - корень поддерева (кость)
+	 *						weight - вес узлов поддерева
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationMixer::SetMask(uint32_t layer, Node* root, float weight)
+	{
+		vector<float>& mask = layers[layer].mask;
+		if (mask.empty())
+			mask.assign(model->linearNodes.size(), 0.0f);
+		MaskChildren(mask, root, weight);
+	}
+
+	void AnimationMixer::MaskChildren(vector<float>& mask, Node* node, float weight)
+	{
+		mask[nodeSlots[node]] = weight;
+		for (Node* child : node->children)
+			MaskChildren(mask, child, weight);
+	}
+
+	/***********************************************
+	 *	функция:			CrossFade()
+	 *	назначение:			перераспределить вес между двумя слоями
+	 *	входящие значения:	fromLayer, toLayer - индексы слоев
+	 *						factor - доля второго слоя [0..1]
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationMixer::CrossFade(uint32_t fromLayer, uint32_t toLayer, float factor)
+	{
+		factor = glm::clamp(factor, 0.0f, 1.0f);
+		layers[fromLayer].weight = 1.0f - factor;
+		layers[toLayer].weight = factor;
+	}
+
+	/***********************************************
+	 *	функция:			ScatterLayer()
+	 *	назначение:			разложить позу клипа по узлам модели
+	 *						и посчитать веса узлов для слоя
+	 *	входящие значения:	layer - слой анимации
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationMixer::ScatterLayer(const Layer& layer)
+	{
+		const AnimationClip& clip = model->clips[layer.clip];
+		const vector<uint32_t>& slots = clipSlots[layer.clip];
+		const AnimationPose& reference = referencePoses[layer.clip];
+
+		clip.Sample(clip.start + layer.time, clipPose);
+		fill(layerWeights.begin(), layerWeights.end(), 0.0f);
+
+		for (size_t i = 0; i < slots.size(); i++)
+		{
+			const uint32_t g = slots[i];
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				layerPose.translation[k][g] = clipPose.translation[k][i];
+				layerPose.scale[k][g] = clipPose.scale[k][i];
+				referencePose.translation[k][g] = reference.translation[k][i];
+				referencePose.scale[k][g] = reference.scale[k][i];
+			}
+			for (uint32_t k = 0; k < 4; k++)
+			{
+				layerPose.rotation[k][g] = clipPose.rotation[k][i];
+				referencePose.rotation[k][g] = reference.rotation[k][i];
+			}
+			layerWeights[g] = layer.weight * (layer.mask.empty() ? 1.0f : layer.mask[g]);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Evaluate()
+	 *	назначение:			смешать все слои в итоговую позу
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationMixer::Evaluate()
+	{
+		const size_t count = bindPose.Size();
+
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			fill(pose.translation[k].begin(), pose.translation[k].end(), 0.0f);
+			fill(pose.scale[k].begin(), pose.scale[k].end(), 0.0f);
+		}
+		for (uint32_t k = 0; k < 4; k++)
+			fill(pose.rotation[k].begin(), pose.rotation[k].end(), 0.0f);
+		fill(weightSums.begin(), weightSums.end(), 0.0f);
+
+		//слои замещения: взвешенная сумма, кватернионы выравниваются по исходной позе
+		for (const Layer& layer : layers)
+		{
+			if ((layer.mode != BLEND_OVERRIDE) || (layer.weight <= 0.0f))
+				continue;
+
+			ScatterLayer(layer);
+
+			const float* w = layerWeights.data();
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				float* t = pose.translation[k].data();
+				float* s = pose.scale[k].data();
+				const float* lt = layerPose.translation[k].data();
+				const float* ls = layerPose.scale[k].data();
+				for (size_t i = 0; i < count; i++)
+				{
+					t[i] += lt[i] * w[i];
+					s[i] += ls[i] * w[i];
+				}
+			}
+
+			float* rx = pose.rotation[0].data();
+			float* ry = pose.rotation[1].data();
+			float* rz = pose.rotation[2].data();
+			float* rw = pose.rotation[3].data();
+			const float* lx = layerPose.rotation[0].data();
+			const float* ly = layerPose.rotation[1].data();
+			const float* lz = layerPose.rotation[2].data();
+			const float* lw = layerPose.rotation[3].data();
+			const float* bx = bindPose.rotation[0].data();
+			const float* by = bindPose.rotation[1].data();
+			const float* bz = bindPose.rotation[2].data();
+			const float* bw = bindPose.rotation[3].data();
+			float* sum = weightSums.data();
+			for (size_t i = 0; i < count; i++)
+			{
+				const float dot = lx[i] * bx[i] + ly[i] * by[i] + lz[i] * bz[i] + lw[i] * bw[i];
+				const float sw = dot < 0.0f ? -w[i] : w[i];
+				rx[i] += lx[i] * sw;
+				ry[i] += ly[i] * sw;
+				rz[i] += lz[i] * sw;
+				rw[i] += lw[i] * sw;
+				sum[i] += w[i];
+			}
+		}
+
+		//недостающий до единицы вес берется из исходной позы
+		{
+			float* sum = weightSums.data();
+			for (size_t i = 0; i < count; i++)
+			{
+				const float rest = std::max(0.0f, 1.0f - sum[i]);
+				const float invSum = 1.0f / (sum[i] + rest);
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					pose.translation[k][i] = (pose.translation[k][i] + bindPose.translation[k][i] * rest) * invSum;
+					pose.scale[k][i] = (pose.scale[k][i] + bindPose.scale[k][i] * rest) * invSum;
+				}
+				float length = 0.0f;
+				for (uint32_t k = 0; k < 4; k++)
+				{
+					pose.rotation[k][i] += bindPose.rotation[k][i] * rest;
+					length += pose.rotation[k][i] * pose.rotation[k][i];
+				}
+				const float invLength = length > 0.0f ? 1.0f / sqrtf(length) : 0.0f;
+				for (uint32_t k = 0; k < 4; k++)
+					pose.rotation[k][i] *= invLength;
+			}
+		}
+
+		//аддитивные слои: разница относительно первого кадра клипа
+		for (const Layer& layer : layers)
+		{
+			if ((layer.mode != BLEND_ADDITIVE) || (layer.weight <= 0.0f))
+				continue;
+
+			ScatterLayer(layer);
+
+			const float* w = layerWeights.data();
+			for (uint32_t k = 0; k < 3; k++)
+			{
+				float* t = pose.translation[k].data();
+				float* s = pose.scale[k].data();
+				const float* lt = layerPose.translation[k].data();
+				const float* ls = layerPose.scale[k].data();
+				const float* rt = referencePose.translation[k].data();
+				const float* rs = referencePose.scale[k].data();
+				for (size_t i = 0; i < count; i++)
+				{
+					t[i] += (lt[i] - rt[i]) * w[i];
+					const float ratio = rs[i] != 0.0f ? ls[i] / rs[i] : 1.0f;
+					s[i] *= 1.0f + (ratio - 1.0f) * w[i];
+				}
+			}
+
+			float* px = pose.rotation[0].data();
+			float* py = pose.rotation[1].data();
+			float* pz = pose.rotation[2].data();
+			float* pw = pose.rotation[3].data();
+			const float* lx = layerPose.rotation[0].data();
+			const float* ly = layerPose.rotation[1].data();
+			const float* lz = layerPose.rotation[2].data();
+			const float* lw = layerPose.rotation[3].data();
+			const float* qx = referencePose.rotation[0].data();
+			const float* qy = referencePose.rotation[1].data();
+			const float* qz = referencePose.rotation[2].data();
+			const float* qw = referencePose.rotation[3].data();
+			for (size_t i = 0; i < count; i++)
+			{
+				// delta = layer * conjugate(reference)
+				float dx = -lw[i] * qx[i] + lx[i] * qw[i] - ly[i] * qz[i] + lz[i] * qy[i];
+				float dy = -lw[i] * qy[i] + lx[i] * qz[i] + ly[i] * qw[i] - lz[i] * qx[i];
+				float dz = -lw[i] * qz[i] - lx[i] * qy[i] + ly[i] * qx[i] + lz[i] * qw[i];
+				float dw = lw[i] * qw[i] + lx[i] * qx[i] + ly[i] * qy[i] + lz[i] * qz[i];
+				if (dw < 0.0f)
+				{
+					dx = -dx;
+					dy = -dy;
+					dz = -dz;
+					dw = -dw;
+				}
+
+				// nlerp(identity, delta, weight)
+				dx *= w[i];
+				dy *= w[i];
+				dz *= w[i];
+				dw = 1.0f + (dw - 1.0f) * w[i];
+				const float length = sqrtf(dx * dx + dy * dy + dz * dz + dw * dw);
+				const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+				dx *= invLength;
+				dy *= invLength;
+				dz *= invLength;
+				dw *= invLength;
+
+				// pose = delta * pose
+				const float x = dw * px[i] + dx * pw[i] + dy * pz[i] - dz * py[i];
+				const float y = dw * py[i] - dx * pz[i] + dy * pw[i] + dz * px[i];
+				const float z = dw * pz[i] + dx * py[i] - dy * px[i] + dz * pw[i];
+				const float qwNew = dw * pw[i] - dx * px[i] - dy * py[i] - dz * pz[i];
+				px[i] = x;
+				py[i] = y;
+				pz[i] = z;
+				pw[i] = qwNew;
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Apply()
+	 *	назначение:			записать итоговую позу в узлы модели
+	 *						и обновить иерархию трансформаций
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationMixer::Apply()
+	{
+		for (size_t slot = 0; slot < model->linearNodes.size(); slot++)
+		{
+			Node* node = model->linearNodes[slot];
+			node->translation = vec3(pose.translation[0][slot], pose.translation[1][slot], pose.translation[2][slot]);
+			node->rotation = quat(pose.rotation[3][slot], pose.rotation[0][slot], pose.rotation[1][slot], pose.rotation[2][slot]);
+			node->scale = vec3(pose.scale[0][slot], pose.scale[1][slot], pose.scale[2][slot]);
+		}
+
+		for (auto& node : model->nodes)
+			node->Update();
+	}
+}
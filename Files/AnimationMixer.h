@@ -0,0 +1,59 @@
+#pragma once
+
+#include <unordered_map>
+
+#include "VulkanglTfModel.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * смешивание нескольких клипов анимации в одну позу модели
+	 *
+	 * Поза хранится в формате SoA по всем узлам модели (linearNodes).
+	 * Слои BLEND_OVERRIDE усредняются по весам (кроссфейд), недостающий
+	 * до единицы вес заполняется исходной позой. Слои BLEND_ADDITIVE
+	 * добавляют разницу клипа относительно его первого кадра.
+	 *
+	***********************************************************************/
+	class AnimationMixer
+	{
+	public:
+		enum BlendMode { BLEND_OVERRIDE, BLEND_ADDITIVE };
+
+		struct Layer
+		{
+			uint32_t clip = 0;
+			float time = 0.0f;
+			float weight = 1.0f;
+			BlendMode mode = BLEND_OVERRIDE;
+			// вес по узлам модели (индекс в linearNodes), пустая маска - все узлы
+			vector<float> mask;
+		};
+
+		Model* model = nullptr;
+		vector<Layer> layers;
+		AnimationPose pose;
+
+		void Init(Model* model);
+		uint32_t AddLayer(uint32_t clip, float weight = 1.0f, BlendMode mode = BLEND_OVERRIDE);
+		void SetMask(uint32_t layer, Node* root, float weight = 1.0f);
+		void CrossFade(uint32_t fromLayer, uint32_t toLayer, float factor);
+		void Evaluate();
+		void Apply();
+
+	private:
+		unordered_map<Node*, uint32_t> nodeSlots;
+		vector<vector<uint32_t>> clipSlots;
+		vector<AnimationPose> referencePoses;
+
+		AnimationPose bindPose;
+		AnimationPose clipPose;
+		AnimationPose layerPose;
+		AnimationPose referencePose;
+		vector<float> layerWeights;
+		vector<float> weightSums;
+
+		void ScatterLayer(const Layer& layer);
+		void MaskChildren(vector<float>& mask, Node* node, float weight);
+	};
+}
@@ -0,0 +1,155 @@
+#include "AnimationWorker.h"
+
+namespace vkglTF
+{
+	AnimationWorker::~AnimationWorker()
+	{
+		Stop();
+	}
+
+	/***********************************************
+	 *	функция:			Start()
+	 *	назначение:			запустить рабочий поток
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationWorker::Start()
+	{
+		if (thread.joinable())
+			return;
+
+		running = true;
+		thread = std::thread(&AnimationWorker::Run, this);
+	}
+
+	/***********************************************
+	 *	функция:			Stop()
+	 *	назначение:			дождаться текущего задания и остановить
+	 *						рабочий поток
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationWorker::Stop()
+	{
+		if (!thread.joinable())
+			return;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+		condition.notify_all();
+		thread.join();
+	}
+
+	/***********************************************
+	 *	функция:			AddModel()
+	 *	назначение:			добавить модель в расчет (до Kick())
+	 *	входящие значения:	model - модель
+	 *						animation - индекс анимации
+	 *						time - время анимации
+	 *	выходящие значения:	задание модели
+	 **********************************************/
+	AnimationWorker::Job* AnimationWorker::AddModel(Model* model, uint32_t animation, float time)
+	{
+		jobs.push_back(std::make_unique<Job>());
+		Job* job = jobs.back().get();
+		job->model = model;
+		SetAnimation(job, animation, time);
+		return job;
+	}
+
+	/***********************************************
+	 *	функция:			SetAnimation()
+	 *	назначение:			задать анимацию и время следующего расчета
+	 *						(между Sync() и Kick())
+	 *	входящие значения:	job - задание модели
+	 *						animation - индекс анимации
+	 *						time - время анимации
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationWorker::SetAnimation(Job* job, uint32_t animation, float time)
+	{
+		job->animation = animation;
+		job->time = time;
+	}
+
+	/***********************************************
+	 *	функция:			Kick()
+	 *	назначение:			начать расчет поз следующего кадра
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationWorker::Kick()
+	{
+		if (!thread.joinable())
+		{
+			//без рабочего потока считаем сразу, Sync() только поменяет буферы
+			//(pending не ставится: его снимает лишь рабочий поток)
+			for (auto& job : jobs)
+			{
+				if (!job->model->animations.empty())
+					job->model->AnimateNodes(job->animation, job->time, &job->poses[front ^ 1]);
+				job->model->EvaluatePose(job->poses[front ^ 1]);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			pending = true;
+		}
+		condition.notify_all();
+	}
+
+	/***********************************************
+	 *	функция:			Sync()
+	 *	назначение:			дождаться расчета, поменять буферы поз
+	 *						и записать передний буфер в буферы моделей
+	 *						(в начале кадра, до записи команд)
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationWorker::Sync()
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			condition.wait(lock, [this] { return !pending; });
+		}
+
+		front ^= 1;
+		for (auto& job : jobs)
+			job->model->UploadPose(job->poses[front]);
+	}
+
+	/***********************************************
+	 *	функция:			Run()
+	 *	назначение:			цикл рабочего потока
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationWorker::Run()
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true)
+		{
+			condition.wait(lock, [this] { return pending || !running; });
+			//отправленное задание досчитывается и при остановке
+			if (!pending)
+				break;
+
+			const uint32_t back = front ^ 1;
+			lock.unlock();
+			for (auto& job : jobs)
+			{
+				if (!job->model->animations.empty())
+					job->model->AnimateNodes(job->animation, job->time, &job->poses[back]);
+				job->model->EvaluatePose(job->poses[back]);
+			}
+			lock.lock();
+
+			pending = false;
+			condition.notify_all();
+		}
+	}
+}
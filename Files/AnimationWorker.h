@@ -0,0 +1,56 @@
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+
+#include "VulkanglTfModel.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * расчет анимации моделей в рабочем потоке
+	 *
+	 * Пока поток отрисовки записывает кадр N, рабочий поток анимирует узлы
+	 * всех моделей для кадра N + 1 и считает позы в задний буфер. В начале
+	 * кадра Sync() дожидается завершения, меняет буферы местами и пишет
+	 * передний буфер в UBO граней и буфер суставов. Веса морфинга тоже
+	 * считаются в позу и попадают в Mesh::weights только в Sync(), так что
+	 * MorphBlender может читать их между Kick() и Sync(). Между Kick() и
+	 * Sync() поток отрисовки не должен менять узлы и анимации моделей задания.
+	 *
+	***********************************************************************/
+	class AnimationWorker
+	{
+	public:
+		struct Job
+		{
+			Model* model = nullptr;
+			uint32_t animation = 0;
+			float time = 0.0f;
+			ModelPose poses[2];
+		};
+
+		~AnimationWorker();
+
+		void Start();
+		void Stop();
+		Job* AddModel(Model* model, uint32_t animation = 0, float time = 0.0f);
+		void SetAnimation(Job* job, uint32_t animation, float time);
+		void Kick();
+		void Sync();
+
+	private:
+		vector<std::unique_ptr<Job>> jobs;
+		uint32_t front = 0;
+
+		std::thread thread;
+		std::mutex mutex;
+		std::condition_variable condition;
+		bool pending = false;
+		bool running = false;
+
+		void Run();
+	};
+}
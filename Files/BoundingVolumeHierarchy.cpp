@@ -0,0 +1,444 @@
+#include "BoundingVolumeHierarchy.h"
+
+#include <algorithm>
+
+namespace vkglTF
+{
+	static float SurfaceArea(vec3 min, vec3 max)
+	{
+		const vec3 size = glm::max(max - min, vec3(0.0f));
+		return 2.0f * (size.x * size.y + size.y * size.z + size.z * size.x);
+	}
+
+	/***********************************************
+	 *	функция:			Build()
+	 *	назначение:			построить иерархию по текущим мировым
+	 *						границам примитивов модели
+	 *	входящие значения:	model - модель
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void BoundingVolumeHierarchy::Build(Model* model)
+	{
+		this->model = model;
+		model->UpdateBounds();
+
+		const uint32_t count = static_cast<uint32_t>(model->worldBounds.count);
+		primitives.assign(count, nullptr);
+		primitiveNodes.assign(count, nullptr);
+		for (Node* node : model->linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+			for (Primitive* primitive : node->mesh->primitives)
+			{
+				primitives[primitive->cullIndex] = primitive;
+				primitiveNodes[primitive->cullIndex] = node;
+			}
+		}
+
+		items.resize(count);
+		centroids.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			items[i] = i;
+			centroids[i] = (ItemMin(i) + ItemMax(i)) * 0.5f;
+		}
+
+		nodes.clear();
+		nodes.resize(1);
+		if (count == 0)
+			return;
+
+		//верхние уровни строятся здесь, поддеревья до PARALLEL_SIZE - заданиями
+		vector<BuildTask> tasks;
+		BuildNode(nodes, 0, 0, count, count > PARALLEL_SIZE ? &tasks : nullptr);
+		RunTasks(tasks);
+	}
+
+	/***********************************************
+	 *	функция:			BuildNode()
+	 *	назначение:			построить узел и его поддерево
+	 *	входящие значения:	out - массив узлов
+	 *						index - место узла в out
+	 *						first, count - диапазон items
+	 *						tasks - отложить поддеревья до PARALLEL_SIZE
+	 *						(nullptr - строить сразу)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void BoundingVolumeHierarchy::BuildNode(vector<BvhNode>& out, uint32_t index, uint32_t first, uint32_t count, vector<BuildTask>* tasks)
+	{
+		BvhNode node;
+		node.first = first;
+		node.count = count;
+		vec3 centroidMin(FLT_MAX), centroidMax(-FLT_MAX);
+		for (uint32_t i = first; i < first + count; i++)
+		{
+			node.min = glm::min(node.min, ItemMin(items[i]));
+			node.max = glm::max(node.max, ItemMax(items[i]));
+			centroidMin = glm::min(centroidMin, centroids[items[i]]);
+			centroidMax = glm::max(centroidMax, centroids[items[i]]);
+		}
+		out[index] = node;
+
+		if (count <= LEAF_SIZE)
+			return;
+
+		if (tasks && count <= PARALLEL_SIZE)
+		{
+			tasks->push_back({ index, first, count, {} });
+			return;
+		}
+
+		//SAH по корзинам центров: стоимость = число * площадь для каждой половины
+		int bestAxis = -1;
+		uint32_t bestBin = 0;
+		float bestCost = FLT_MAX;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			const float extent = centroidMax[axis] - centroidMin[axis];
+			if (extent <= 0.0f)
+				continue;
+
+			uint32_t binCount[BINS] = {};
+			vec3 binMin[BINS], binMax[BINS];
+			for (uint32_t b = 0; b < BINS; b++)
+			{
+				binMin[b] = vec3(FLT_MAX);
+				binMax[b] = vec3(-FLT_MAX);
+			}
+
+			const float scale = BINS / extent;
+			for (uint32_t i = first; i < first + count; i++)
+			{
+				const uint32_t item = items[i];
+				const uint32_t b = std::min(static_cast<uint32_t>((centroids[item][axis] - centroidMin[axis]) * scale), BINS - 1);
+				binCount[b]++;
+				binMin[b] = glm::min(binMin[b], ItemMin(item));
+				binMax[b] = glm::max(binMax[b], ItemMax(item));
+			}
+
+			//площади правых частей накапливаются справа налево
+			float rightArea[BINS];
+			uint32_t rightCount[BINS];
+			vec3 accumulatedMin(FLT_MAX), accumulatedMax(-FLT_MAX);
+			uint32_t accumulatedCount = 0;
+			for (uint32_t b = BINS - 1; b > 0; b--)
+			{
+				accumulatedMin = glm::min(accumulatedMin, binMin[b]);
+				accumulatedMax = glm::max(accumulatedMax, binMax[b]);
+				accumulatedCount += binCount[b];
+				rightArea[b] = SurfaceArea(accumulatedMin, accumulatedMax);
+				rightCount[b] = accumulatedCount;
+			}
+
+			accumulatedMin = vec3(FLT_MAX);
+			accumulatedMax = vec3(-FLT_MAX);
+			accumulatedCount = 0;
+			for (uint32_t b = 0; b < BINS - 1; b++)
+			{
+				accumulatedMin = glm::min(accumulatedMin, binMin[b]);
+				accumulatedMax = glm::max(accumulatedMax, binMax[b]);
+				accumulatedCount += binCount[b];
+				if (accumulatedCount == 0 || rightCount[b + 1] == 0)
+					continue;
+
+				const float cost = accumulatedCount * SurfaceArea(accumulatedMin, accumulatedMax) + rightCount[b + 1] * rightArea[b + 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = b;
+				}
+			}
+		}
+
+		//разбиение не дешевле листа
+		const float leafCost = count * SurfaceArea(node.min, node.max);
+		if (count <= MAX_LEAF_SIZE && (bestAxis < 0 || bestCost >= leafCost))
+			return;
+
+		uint32_t* begin = items.data() + first;
+		uint32_t* end = begin + count;
+		uint32_t* middle = begin;
+		if (bestAxis >= 0)
+		{
+			const float scale = BINS / (centroidMax[bestAxis] - centroidMin[bestAxis]);
+			const float axisMin = centroidMin[bestAxis];
+			middle = std::partition(begin, end, [&](uint32_t item) {
+				return std::min(static_cast<uint32_t>((centroids[item][bestAxis] - axisMin) * scale), BINS - 1) <= bestBin;
+			});
+		}
+		if (middle == begin || middle == end)
+		{
+			//все центры совпадают: делим пополам по количеству
+			middle = begin + count / 2;
+			const int axis = bestAxis >= 0 ? bestAxis : 0;
+			std::nth_element(begin, middle, end, [&](uint32_t a, uint32_t b) { return centroids[a][axis] < centroids[b][axis]; });
+		}
+
+		const uint32_t leftCount = static_cast<uint32_t>(middle - begin);
+		const uint32_t left = static_cast<uint32_t>(out.size());
+		out.resize(out.size() + 2);
+		out[index].left = left;
+		BuildNode(out, left, first, leftCount, tasks);
+		BuildNode(out, left + 1, first + leftCount, count - leftCount, tasks);
+	}
+
+	/***********************************************
+	 *	функция:			RunTasks()
+	 *	назначение:			построить отложенные поддеревья в рабочих
+	 *						потоках и дописать их в nodes
+	 *	входящие значения:	tasks - поддеревья
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void BoundingVolumeHierarchy::RunTasks(vector<BuildTask>& tasks)
+	{
+		if (tasks.empty())
+			return;
+
+		//диапазоны items заданий не пересекаются, потоки делят только счетчик
+		std::atomic<size_t> next{ 0 };
+		auto worker = [&]() {
+			for (size_t t = next++; t < tasks.size(); t = next++)
+			{
+				BuildTask& task = tasks[t];
+				task.nodes.resize(1);
+				BuildNode(task.nodes, 0, task.first, task.count, nullptr);
+			}
+		};
+
+		const uint32_t threadCount = std::min<uint32_t>(std::max(std::thread::hardware_concurrency(), 1u), static_cast<uint32_t>(tasks.size()));
+		vector<std::thread> threads;
+		for (uint32_t i = 1; i < threadCount; i++)
+			threads.emplace_back(worker);
+		worker();
+		for (std::thread& thread : threads)
+			thread.join();
+
+		//корень задания занимает свое место, остальные узлы дописываются в конец
+		for (BuildTask& task : tasks)
+		{
+			const uint32_t offset = static_cast<uint32_t>(nodes.size()) - 1;
+			for (BvhNode& node : task.nodes)
+			{
+				if (node.left)
+					node.left += offset;
+			}
+			nodes[task.node] = task.nodes[0];
+			nodes.insert(nodes.end(), task.nodes.begin() + 1, task.nodes.end());
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Refit()
+	 *	назначение:			пересчитать коробки узлов по текущим
+	 *						границам примитивов без перестройки
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void BoundingVolumeHierarchy::Refit()
+	{
+		if (!model)
+			return;
+		model->UpdateBounds();
+
+		//дети всегда дальше родителя, поэтому обратный проход идет снизу вверх
+		for (size_t i = nodes.size(); i-- > 0;)
+		{
+			BvhNode& node = nodes[i];
+			if (node.left)
+			{
+				node.min = glm::min(nodes[node.left].min, nodes[node.left + 1].min);
+				node.max = glm::max(nodes[node.left].max, nodes[node.left + 1].max);
+				continue;
+			}
+
+			node.min = vec3(FLT_MAX);
+			node.max = vec3(-FLT_MAX);
+			for (uint32_t j = node.first; j < node.first + node.count; j++)
+			{
+				node.min = glm::min(node.min, ItemMin(items[j]));
+				node.max = glm::max(node.max, ItemMax(items[j]));
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Cull()
+	 *	назначение:			иерархическое отсечение: поддерево вне
+	 *						пирамиды отбрасывается целиком, полностью
+	 *						внутри - принимается без проверок
+	 *	входящие значения:	frustum - пирамида видимости
+	 *						visible - результат по Primitive::cullIndex
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void BoundingVolumeHierarchy::Cull(const vks::Frustum& frustum, uint8_t* visible) const
+	{
+		std::fill(visible, visible + items.size(), uint8_t(0));
+		if (items.empty())
+			return;
+
+		vector<uint32_t> stack{ 0 };
+		while (!stack.empty())
+		{
+			const BvhNode& node = nodes[stack.back()];
+			stack.pop_back();
+
+			bool inside = true;
+			bool outside = false;
+			for (const vec4& plane : frustum.planes)
+			{
+				//ближняя и дальняя по нормали вершины коробки
+				const vec3 positive(plane.x > 0.0f ? node.max.x : node.min.x, plane.y > 0.0f ? node.max.y : node.min.y, plane.z > 0.0f ? node.max.z : node.min.z);
+				const vec3 negative(plane.x > 0.0f ? node.min.x : node.max.x, plane.y > 0.0f ? node.min.y : node.max.y, plane.z > 0.0f ? node.min.z : node.max.z);
+				if (dot(vec3(plane), positive) + plane.w < 0.0f)
+				{
+					outside = true;
+					break;
+				}
+				if (dot(vec3(plane), negative) + plane.w < 0.0f)
+					inside = false;
+			}
+
+			if (outside)
+				continue;
+
+			if (inside)
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+					visible[items[i]] = 1;
+			}
+			else if (node.left)
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.left + 1);
+			}
+			else
+			{
+				for (uint32_t i = node.first; i < node.first + node.count; i++)
+					visible[items[i]] = frustum.CheckBox(ItemMin(items[i]), ItemMax(items[i]));
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Raycast()
+	 *	назначение:			ближайший примитив, коробку которого
+	 *						пересекает луч (выбор мышью, см.
+	 *						Camera::ScreenRay)
+	 *	входящие значения:	origin, direction - луч
+	 *						hit - результат
+	 *	выходящие значения:	true, если есть пересечение
+	 **********************************************/
+	bool BoundingVolumeHierarchy::Raycast(vec3 origin, vec3 direction, Hit& hit) const
+	{
+		hit = Hit();
+		if (items.empty())
+			return false;
+
+		const vec3 inverseDirection = 1.0f / direction;
+		auto intersect = [&](vec3 min, vec3 max, float& distance) {
+			const vec3 t0 = (min - origin) * inverseDirection;
+			const vec3 t1 = (max - origin) * inverseDirection;
+			const vec3 tmin = glm::min(t0, t1);
+			const vec3 tmax = glm::max(t0, t1);
+			const float enter = std::max(std::max(tmin.x, tmin.y), std::max(tmin.z, 0.0f));
+			const float exit = std::min(std::min(tmax.x, tmax.y), tmax.z);
+			distance = enter;
+			return enter <= exit && enter < hit.distance;
+		};
+
+		vector<uint32_t> stack{ 0 };
+		while (!stack.empty())
+		{
+			const BvhNode& node = nodes[stack.back()];
+			stack.pop_back();
+
+			float distance;
+			if (!intersect(node.min, node.max, distance))
+				continue;
+
+			if (node.left)
+			{
+				stack.push_back(node.left);
+				stack.push_back(node.left + 1);
+				continue;
+			}
+
+			for (uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				if (intersect(ItemMin(items[i]), ItemMax(items[i]), distance))
+					SetHit(items[i], distance, hit);
+			}
+		}
+		return hit.primitive != nullptr;
+	}
+
+	/***********************************************
+	 *	функция:			Nearest()
+	 *	назначение:			ближайший к точке примитив (расстояние
+	 *						до его коробки)
+	 *	входящие значения:	point - точка
+	 *						maxDistance - радиус поиска
+	 *						hit - результат
+	 *	выходящие значения:	true, если примитив найден
+	 **********************************************/
+	bool BoundingVolumeHierarchy::Nearest(vec3 point, float maxDistance, Hit& hit) const
+	{
+		hit = Hit();
+		hit.distance = maxDistance;
+		if (items.empty())
+			return false;
+
+		auto boxDistance = [&](vec3 min, vec3 max) {
+			return length(glm::max(glm::max(min - point, point - max), vec3(0.0f)));
+		};
+
+		vector<uint32_t> stack{ 0 };
+		while (!stack.empty())
+		{
+			const BvhNode& node = nodes[stack.back()];
+			stack.pop_back();
+
+			if (boxDistance(node.min, node.max) >= hit.distance)
+				continue;
+
+			if (node.left)
+			{
+				//ближний ребенок обходится первым, чтобы быстрее сузить радиус
+				const uint32_t left = node.left;
+				const bool leftFirst = boxDistance(nodes[left].min, nodes[left].max) <= boxDistance(nodes[left + 1].min, nodes[left + 1].max);
+				stack.push_back(leftFirst ? left + 1 : left);
+				stack.push_back(leftFirst ? left : left + 1);
+				continue;
+			}
+
+			for (uint32_t i = node.first; i < node.first + node.count; i++)
+			{
+				const float distance = boxDistance(ItemMin(items[i]), ItemMax(items[i]));
+				if (distance < hit.distance)
+					SetHit(items[i], distance, hit);
+			}
+		}
+		return hit.primitive != nullptr;
+	}
+
+	vec3 BoundingVolumeHierarchy::ItemMin(uint32_t item) const
+	{
+		const BoxArray& bounds = model->worldBounds;
+		return vec3(bounds.minX[item], bounds.minY[item], bounds.minZ[item]);
+	}
+
+	vec3 BoundingVolumeHierarchy::ItemMax(uint32_t item) const
+	{
+		const BoxArray& bounds = model->worldBounds;
+		return vec3(bounds.maxX[item], bounds.maxY[item], bounds.maxZ[item]);
+	}
+
+	void BoundingVolumeHierarchy::SetHit(uint32_t item, float distance, Hit& hit) const
+	{
+		hit.node = primitiveNodes[item];
+		hit.primitive = primitives[item];
+		hit.distance = distance;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <thread>
+#include <atomic>
+
+#include "VulkanglTfModel.h"
+#include "Frustum.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * иерархия ограничивающих коробок над примитивами модели
+	 *
+	 * Строится по мировым границам Model::worldBounds методом SAH с
+	 * разбиением центров на BINS корзин, крупные поддеревья строятся
+	 * параллельно. Примитивы поддерева лежат в items непрерывным
+	 * диапазоном, дети узла - соседние элементы nodes. При движении узлов
+	 * модели Refit() пересчитывает коробки снизу вверх без перестройки.
+	 * Индексы примитивов - Primitive::cullIndex.
+	 *
+	***********************************************************************/
+	class BoundingVolumeHierarchy
+	{
+	public:
+		static constexpr uint32_t BINS = 16;
+		static constexpr uint32_t LEAF_SIZE = 4;
+		static constexpr uint32_t MAX_LEAF_SIZE = 16;
+		//поддеревья не больше этого строятся одним заданием
+		static constexpr uint32_t PARALLEL_SIZE = 4096;
+
+		struct BvhNode
+		{
+			vec3 min{ FLT_MAX };
+			//индекс левого ребенка (правый следующий), 0 - лист
+			uint32_t left = 0;
+			vec3 max{ -FLT_MAX };
+			uint32_t first = 0;
+			uint32_t count = 0;
+		};
+
+		struct Hit
+		{
+			Node* node = nullptr;
+			Primitive* primitive = nullptr;
+			float distance = FLT_MAX;
+		};
+
+		Model* model = nullptr;
+		vector<BvhNode> nodes;
+		vector<uint32_t> items;
+
+		void Build(Model* model);
+		void Refit();
+		void Cull(const vks::Frustum& frustum, uint8_t* visible) const;
+		bool Raycast(vec3 origin, vec3 direction, Hit& hit) const;
+		bool Nearest(vec3 point, float maxDistance, Hit& hit) const;
+
+	private:
+		struct BuildTask
+		{
+			uint32_t node;
+			uint32_t first;
+			uint32_t count;
+			vector<BvhNode> nodes;
+		};
+
+		vector<Primitive*> primitives;
+		vector<Node*> primitiveNodes;
+		vector<vec3> centroids;
+
+		vec3 ItemMin(uint32_t item) const;
+		vec3 ItemMax(uint32_t item) const;
+		void BuildNode(vector<BvhNode>& out, uint32_t index, uint32_t first, uint32_t count, vector<BuildTask>* tasks);
+		void RunTasks(vector<BuildTask>& tasks);
+		void SetHit(uint32_t item, float distance, Hit& hit) const;
+	};
+}
@@ -0,0 +1,170 @@
+#include "CommandRecorder.h"
+
+#include <algorithm>
+
+namespace vks
+{
+	CommandRecorder::Statistics& CommandRecorder::Statistics::operator+=(const Statistics& other)
+	{
+		pipelineBinds += other.pipelineBinds;
+		descriptorSetBinds += other.descriptorSetBinds;
+		vertexBufferBinds += other.vertexBufferBinds;
+		indexBufferBinds += other.indexBufferBinds;
+		pushConstants += other.pushConstants;
+		draws += other.draws;
+		skippedBinds += other.skippedBinds;
+		return *this;
+	}
+
+	/***********************************************
+	 *	функция:			Begin()
+	 *	назначение:			начать запись в другой командный буфер
+	 *						(состояние сбрасывается, счетчики нет)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void CommandRecorder::Begin(VkCommandBuffer commandBuffer)
+	{
+		this->commandBuffer = commandBuffer;
+		Invalidate();
+	}
+
+	/***********************************************
+	 *	функция:			Invalidate()
+	 *	назначение:			забыть связанное состояние
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void CommandRecorder::Invalidate()
+	{
+		for (BindPointState& state : bindPoints)
+			state = {};
+		for (uint32_t binding = 0; binding < MAX_VERTEX_BINDINGS; binding++)
+		{
+			vertexBuffers[binding] = VK_NULL_HANDLE;
+			vertexOffsets[binding] = 0;
+		}
+		indexBuffer = VK_NULL_HANDLE;
+		indexOffset = 0;
+	}
+
+	void CommandRecorder::BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline)
+	{
+		VkPipeline& bound = bindPoints[bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE].pipeline;
+		if (bound == pipeline)
+		{
+			statistics.skippedBinds++;
+			return;
+		}
+		vkCmdBindPipeline(commandBuffer, bindPoint, pipeline);
+		bound = pipeline;
+		statistics.pipelineBinds++;
+	}
+
+	/***********************************************
+	 *	функция:			SetBound()
+	 *	назначение:			запомнить набор дескрипторов
+	 *	входящие значения:	set - номер набора в раскладке
+	 *						dynamicOffsetCount, dynamicOffsets -
+	 *						динамические смещения набора
+	 *	выходящие значения:	false - набор уже связан, привязка не нужна
+	 **********************************************/
+	bool CommandRecorder::SetBound(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets)
+	{
+		//наборы за пределами кэша всегда связываются
+		if (set >= MAX_DESCRIPTOR_SETS || dynamicOffsetCount > MAX_DYNAMIC_OFFSETS)
+			return true;
+
+		BindPointState& state = bindPoints[bindPoint == VK_PIPELINE_BIND_POINT_COMPUTE];
+		if (state.layout == layout && state.sets[set] == descriptorSet && state.dynamicOffsetCounts[set] == dynamicOffsetCount &&
+			std::equal(dynamicOffsets, dynamicOffsets + dynamicOffsetCount, state.dynamicOffsets[set]))
+		{
+			statistics.skippedBinds++;
+			return false;
+		}
+		//совместимость раскладок (в том числе по push-константам) здесь
+		//не проверяется, поэтому при смене раскладки забываются все наборы
+		if (state.layout != layout)
+		{
+			for (uint32_t i = 0; i < MAX_DESCRIPTOR_SETS; i++)
+				state.sets[i] = VK_NULL_HANDLE;
+			state.layout = layout;
+		}
+		state.sets[set] = descriptorSet;
+		state.dynamicOffsetCounts[set] = dynamicOffsetCount;
+		std::copy(dynamicOffsets, dynamicOffsets + dynamicOffsetCount, state.dynamicOffsets[set]);
+		return true;
+	}
+
+	void CommandRecorder::BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet)
+	{
+		BindDescriptorSet(bindPoint, layout, set, descriptorSet, 0, nullptr);
+	}
+
+	void CommandRecorder::BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffset)
+	{
+		BindDescriptorSet(bindPoint, layout, set, descriptorSet, 1, &dynamicOffset);
+	}
+
+	void CommandRecorder::BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets)
+	{
+		if (!SetBound(bindPoint, layout, set, descriptorSet, dynamicOffsetCount, dynamicOffsets))
+			return;
+		vkCmdBindDescriptorSets(commandBuffer, bindPoint, layout, set, 1, &descriptorSet, dynamicOffsetCount, dynamicOffsets);
+		statistics.descriptorSetBinds++;
+	}
+
+	void CommandRecorder::BindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset)
+	{
+		if (binding < MAX_VERTEX_BINDINGS)
+		{
+			if (vertexBuffers[binding] == buffer && vertexOffsets[binding] == offset)
+			{
+				statistics.skippedBinds++;
+				return;
+			}
+			vertexBuffers[binding] = buffer;
+			vertexOffsets[binding] = offset;
+		}
+		vkCmdBindVertexBuffers(commandBuffer, binding, 1, &buffer, &offset);
+		statistics.vertexBufferBinds++;
+	}
+
+	void CommandRecorder::BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset, VkIndexType indexType)
+	{
+		if (indexBuffer == buffer && indexOffset == offset && this->indexType == indexType)
+		{
+			statistics.skippedBinds++;
+			return;
+		}
+		vkCmdBindIndexBuffer(commandBuffer, buffer, offset, indexType);
+		indexBuffer = buffer;
+		indexOffset = offset;
+		this->indexType = indexType;
+		statistics.indexBufferBinds++;
+	}
+
+	void CommandRecorder::PushConstants(VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void* values)
+	{
+		vkCmdPushConstants(commandBuffer, layout, stages, offset, size, values);
+		statistics.pushConstants++;
+	}
+
+	void CommandRecorder::Draw(uint32_t vertexCount, uint32_t instanceCount, uint32_t firstVertex, uint32_t firstInstance)
+	{
+		vkCmdDraw(commandBuffer, vertexCount, instanceCount, firstVertex, firstInstance);
+		statistics.draws++;
+	}
+
+	void CommandRecorder::DrawIndexed(uint32_t indexCount, uint32_t instanceCount, uint32_t firstIndex, int32_t vertexOffset, uint32_t firstInstance)
+	{
+		vkCmdDrawIndexed(commandBuffer, indexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
+		statistics.draws++;
+	}
+
+	void CommandRecorder::DrawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride)
+	{
+		vkCmdDrawIndexedIndirect(commandBuffer, buffer, offset, drawCount, stride);
+		statistics.draws++;
+	}
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	/*************************************************************************
+	 * запись команд с отбрасыванием повторных привязок
+	 *
+	 * Тонкая обертка над VkCommandBuffer: помнит связанные конвейеры,
+	 * наборы дескрипторов (до MAX_DYNAMIC_OFFSETS динамических смещений),
+	 * буферы вершин и индексов и не записывает привязку того, что уже
+	 * связано. Смена раскладки конвейера забывает все связанные наборы:
+	 * совместимость раскладок не проверяется. Счетчики statistics копятся
+	 * до ResetStatistics(), обычно раз в кадр; у потоков свои обертки, их
+	 * счетчики складываются оператором +=. После команд, записанных в
+	 * обход обертки (vkCmdExecuteCommands, чужой код, перегрузки с
+	 * VkCommandBuffer, CullingPass::Draw, OcclusionPass::Draw), нужен
+	 * Invalidate().
+	 *
+	***********************************************************************/
+	class CommandRecorder
+	{
+	public:
+		static constexpr uint32_t MAX_DESCRIPTOR_SETS = 8;
+		static constexpr uint32_t MAX_VERTEX_BINDINGS = 8;
+		static constexpr uint32_t MAX_DYNAMIC_OFFSETS = 4;
+
+		struct Statistics
+		{
+			uint32_t pipelineBinds = 0;
+			uint32_t descriptorSetBinds = 0;
+			uint32_t vertexBufferBinds = 0;
+			uint32_t indexBufferBinds = 0;
+			uint32_t pushConstants = 0;
+			uint32_t draws = 0;
+			//отброшенные повторные привязки
+			uint32_t skippedBinds = 0;
+
+			Statistics& operator+=(const Statistics& other);
+		} statistics;
+
+		CommandRecorder() = default;
+		explicit CommandRecorder(VkCommandBuffer commandBuffer) : commandBuffer(commandBuffer) {}
+
+		void Begin(VkCommandBuffer commandBuffer);
+		void Invalidate();
+		void ResetStatistics() { statistics = {}; }
+		VkCommandBuffer Handle() const { return commandBuffer; }
+
+		void BindPipeline(VkPipelineBindPoint bindPoint, VkPipeline pipeline);
+		void BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet);
+		void BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffset);
+		void BindDescriptorSet(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets);
+		void BindVertexBuffer(uint32_t binding, VkBuffer buffer, VkDeviceSize offset = 0);
+		void BindIndexBuffer(VkBuffer buffer, VkDeviceSize offset = 0, VkIndexType indexType = VK_INDEX_TYPE_UINT32);
+		void PushConstants(VkPipelineLayout layout, VkShaderStageFlags stages, uint32_t offset, uint32_t size, const void* values);
+		void Draw(uint32_t vertexCount, uint32_t instanceCount = 1, uint32_t firstVertex = 0, uint32_t firstInstance = 0);
+		void DrawIndexed(uint32_t indexCount, uint32_t instanceCount = 1, uint32_t firstIndex = 0, int32_t vertexOffset = 0, uint32_t firstInstance = 0);
+		void DrawIndexedIndirect(VkBuffer buffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride);
+
+	private:
+		//0 - графика, 1 - вычисления
+		struct BindPointState
+		{
+			VkPipeline pipeline;
+			//раскладка последней привязки, наборы запомнены только для нее
+			VkPipelineLayout layout;
+			VkDescriptorSet sets[MAX_DESCRIPTOR_SETS];
+			uint32_t dynamicOffsets[MAX_DESCRIPTOR_SETS][MAX_DYNAMIC_OFFSETS];
+			uint32_t dynamicOffsetCounts[MAX_DESCRIPTOR_SETS];
+		};
+
+		VkCommandBuffer commandBuffer = VK_NULL_HANDLE;
+		BindPointState bindPoints[2]{};
+		VkBuffer vertexBuffers[MAX_VERTEX_BINDINGS]{};
+		VkDeviceSize vertexOffsets[MAX_VERTEX_BINDINGS]{};
+		VkBuffer indexBuffer = VK_NULL_HANDLE;
+		VkDeviceSize indexOffset = 0;
+		VkIndexType indexType = VK_INDEX_TYPE_UINT32;
+
+		bool SetBound(VkPipelineBindPoint bindPoint, VkPipelineLayout layout, uint32_t set, VkDescriptorSet descriptorSet, uint32_t dynamicOffsetCount, const uint32_t* dynamicOffsets);
+	};
+}
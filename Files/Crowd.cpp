@@ -0,0 +1,381 @@
+#include "Crowd.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * аффинные матрицы 3x4 в формате SoA: элемент (строка r, столбец c)
+	 * экземпляра i лежит в block[(r * 4 + c) * CHUNK + i]
+	 *
+	***********************************************************************/
+	static void MulAffine(const float* a, const float* b, float* out, uint32_t count)
+	{
+		const uint32_t stride = Crowd::CHUNK;
+		for (uint32_t r = 0; r < 3; r++)
+		{
+			const float* a0 = a + (r * 4 + 0) * stride;
+			const float* a1 = a + (r * 4 + 1) * stride;
+			const float* a2 = a + (r * 4 + 2) * stride;
+			const float* a3 = a + (r * 4 + 3) * stride;
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				const float* b0 = b + (0 * 4 + c) * stride;
+				const float* b1 = b + (1 * 4 + c) * stride;
+				const float* b2 = b + (2 * 4 + c) * stride;
+				float* o = out + (r * 4 + c) * stride;
+				if (c < 3)
+				{
+					for (uint32_t i = 0; i < count; i++)
+						o[i] = a0[i] * b0[i] + a1[i] * b1[i] + a2[i] * b2[i];
+				}
+				else
+				{
+					for (uint32_t i = 0; i < count; i++)
+						o[i] = a0[i] * b0[i] + a1[i] * b1[i] + a2[i] * b2[i] + a3[i];
+				}
+			}
+		}
+	}
+
+	static void BroadcastAffine(const mat4& m, float* out, uint32_t count)
+	{
+		for (uint32_t r = 0; r < 3; r++)
+		{
+			for (uint32_t c = 0; c < 4; c++)
+			{
+				float* o = out + (r * 4 + c) * Crowd::CHUNK;
+				const float value = m[c][r];
+				for (uint32_t i = 0; i < count; i++)
+					o[i] = value;
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			подготовить общий скелет и буфер палитр
+	 *	входящие значения:	model - модель персонажа
+	 *						skinIndex - индекс скина модели
+	 *						maxInstances - максимум экземпляров
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Crowd::Init(Model* model, uint32_t skinIndex, uint32_t maxInstances)
+	{
+		this->model = model;
+		this->maxInstances = maxInstances;
+
+		if (skinIndex >= model->skins.size())
+		{
+			std::cout << "No skin with index " << skinIndex << std::endl;
+			return;
+		}
+
+		if (model->clips.size() != model->animations.size())
+			model->CompileAnimations(model->animationSampleRate);
+
+		skin = model->skins[skinIndex];
+		jointCount = static_cast<uint32_t>(skin->joints.size());
+
+		//в скелет входят суставы и все их предки
+		uint32_t maxIndex = 0;
+		for (Node* node : model->linearNodes)
+			maxIndex = std::max(maxIndex, node->index);
+		vector<bool> required(maxIndex + 1, false);
+		for (Node* joint : skin->joints)
+		{
+			for (Node* node = joint; node; node = node->parent)
+				required[node->index] = true;
+		}
+
+		skeleton.clear();
+		parents.clear();
+		for (Node* node : model->nodes)
+			CollectSkeleton(node, required);
+
+		const size_t count = skeleton.size();
+		nodeMatrices.resize(count);
+		restPose.Resize(count);
+		for (size_t s = 0; s < count; s++)
+		{
+			nodeMatrices[s] = skeleton[s]->matrix;
+			restPose.Set(s, skeleton[s]->translation, skeleton[s]->rotation, skeleton[s]->scale);
+		}
+
+		clipSlots.resize(model->clips.size());
+		for (size_t c = 0; c < model->clips.size(); c++)
+		{
+			const AnimationClip& clip = model->clips[c];
+			clipSlots[c].assign(count, -1);
+			for (size_t s = 0; s < count; s++)
+			{
+				auto it = find(clip.nodes.begin(), clip.nodes.end(), skeleton[s]);
+				if (it != clip.nodes.end())
+					clipSlots[c][s] = static_cast<int32_t>(it - clip.nodes.begin());
+			}
+		}
+
+		jointSlots.resize(jointCount);
+		for (uint32_t j = 0; j < jointCount; j++)
+			jointSlots[j] = static_cast<uint32_t>(find(skeleton.begin(), skeleton.end(), skin->joints[j]) - skeleton.begin());
+
+		//палитры, как и в Node::Update, задаются относительно узла с гранями
+		meshInverse = mat4(1.0f);
+		for (Node* node : model->linearNodes)
+		{
+			if (node->mesh && (node->skin == skin))
+			{
+				meshInverse = inverse(node->getMatrix());
+				break;
+			}
+		}
+
+		worlds.resize(count * 12 * CHUNK);
+
+		//область кадра начинается с динамического смещения storage буфера
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(model->device->properties.limits.minStorageBufferOffsetAlignment, 16);
+		paletteFrameSize = (std::max(maxInstances * jointCount, 1u) * sizeof(mat4) + alignment - 1) & ~(alignment - 1);
+		frameCount = std::max(model->framesInFlight, 1u);
+		frame = 0;
+		VK_CHECK_RESULT(model->device->createBuffer(
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&paletteBuffer,
+			paletteFrameSize * frameCount));
+		VK_CHECK_RESULT(paletteBuffer.map());
+		paletteBuffer.setupDescriptor(paletteFrameSize);
+
+		clips.reserve(maxInstances);
+		times.reserve(maxInstances);
+		speeds.reserve(maxInstances);
+	}
+
+	/***********************************************
+	 *	функция:			CollectSkeleton()
+	 *	назначение:			обход узлов в прямом порядке с отбором
+	 *						узлов скелета
+	 *	входящие значения:	node - текущий узел
+	 *						required - признак узла скелета по индексу
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Crowd::CollectSkeleton(Node* node, const vector<bool>& required)
+	{
+		if (!required[node->index])
+			return;
+
+		const auto parent = find(skeleton.begin(), skeleton.end(), node->parent);
+		parents.push_back(parent != skeleton.end() ? static_cast<int32_t>(parent - skeleton.begin()) : -1);
+		skeleton.push_back(node);
+
+		for (Node* child : node->children)
+			CollectSkeleton(child, required);
+	}
+
+	/***********************************************
+	 *	функция:			AddInstance()
+	 *	назначение:			добавить экземпляр толпы
+	 *	входящие значения:	clip - индекс клипа модели
+	 *						time - время от начала клипа
+	 *						speed - скорость воспроизведения
+	 *	выходящие значения:	индекс экземпляра
+	 **********************************************/
+	uint32_t Crowd::AddInstance(uint32_t clip, float time, float speed)
+	{
+		if ((InstanceCount() >= maxInstances) || (clip >= model->clips.size()))
+		{
+			std::cout << "Crowd instance rejected (clip " << clip << ")" << std::endl;
+			return UINT32_MAX;
+		}
+
+		clips.push_back(clip);
+		times.push_back(time);
+		speeds.push_back(speed);
+		return InstanceCount() - 1;
+	}
+
+	/***********************************************
+	 *	функция:			Update()
+	 *	назначение:			продвинуть время экземпляров и записать
+	 *						их палитры в область кадра (вызывать после
+	 *						ожидания ограждения кадра)
+	 *	входящие значения:	deltaTime - прошедшее время
+	 *						frameIndex - номер кадра в полете
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Crowd::Update(float deltaTime, uint32_t frameIndex)
+	{
+		frame = frameIndex % frameCount;
+		const uint32_t count = InstanceCount();
+		if (!skin || (count == 0))
+			return;
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const AnimationClip& clip = model->clips[clips[i]];
+			const float duration = clip.end - clip.start;
+			float time = times[i] + deltaTime * speeds[i];
+			if (duration > 0.0f)
+			{
+				time = fmodf(time, duration);
+				if (time < 0.0f)
+					time += duration;
+			}
+			else
+				time = 0.0f;
+			times[i] = time;
+		}
+
+		//группировка по клипу подсчетом
+		clipCounts.assign(model->clips.size() + 1, 0);
+		for (uint32_t i = 0; i < count; i++)
+			clipCounts[clips[i] + 1]++;
+		for (size_t c = 1; c < clipCounts.size(); c++)
+			clipCounts[c] += clipCounts[c - 1];
+		order.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			order[clipCounts[clips[i]]++] = i;
+
+		mat4* palettes = reinterpret_cast<mat4*>(static_cast<uint8_t*>(paletteBuffer.mapped) + PaletteOffset());
+		uint32_t start = 0;
+		for (uint32_t c = 0; c < model->clips.size(); c++)
+		{
+			const uint32_t end = clipCounts[c];
+			for (uint32_t first = start; first < end; first += CHUNK)
+				EvaluateChunk(c, &order[first], std::min(CHUNK, end - first), palettes);
+			start = end;
+		}
+	}
+
+	/***********************************************
+	 *	функция:			EvaluateChunk()
+	 *	назначение:			посчитать палитры блока экземпляров
+	 *						одного клипа
+	 *	входящие значения:	clipIndex - индекс клипа
+	 *						instances - индексы экземпляров блока
+	 *						count - число экземпляров (не больше CHUNK)
+	 *						palettes - буфер палитр
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Crowd::EvaluateChunk(uint32_t clipIndex, const uint32_t* instances, uint32_t count, mat4* palettes)
+	{
+		const AnimationClip& clip = model->clips[clipIndex];
+		const uint32_t clipCount = static_cast<uint32_t>(clip.nodes.size());
+		const float lastFrame = static_cast<float>(std::max(clip.frameCount, 1u) - 1);
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			const float frame = glm::clamp(times[instances[i]] * clip.sampleRate, 0.0f, lastFrame);
+			const uint32_t f0 = static_cast<uint32_t>(frame);
+			frameA[i] = f0 * clipCount;
+			frameB[i] = std::min(f0 + 1, static_cast<uint32_t>(lastFrame)) * clipCount;
+			blend[i] = frame - static_cast<float>(f0);
+		}
+
+		for (size_t s = 0; s < skeleton.size(); s++)
+		{
+			//TRS: trs[0..2] - смещение, trs[3..6] - вращение (x, y, z, w), trs[7..9] - масштаб
+			const int32_t slot = clipSlots[clipIndex][s];
+			if ((slot < 0) || (clip.frameCount == 0))
+			{
+				const float rest[10] = {
+					restPose.translation[0][s], restPose.translation[1][s], restPose.translation[2][s],
+					restPose.rotation[0][s], restPose.rotation[1][s], restPose.rotation[2][s], restPose.rotation[3][s],
+					restPose.scale[0][s], restPose.scale[1][s], restPose.scale[2][s] };
+				for (uint32_t k = 0; k < 10; k++)
+					for (uint32_t i = 0; i < count; i++)
+						trs[k][i] = rest[k];
+			}
+			else
+			{
+				const float* tracks[10] = {
+					clip.frames.translation[0].data(), clip.frames.translation[1].data(), clip.frames.translation[2].data(),
+					clip.frames.rotation[0].data(), clip.frames.rotation[1].data(), clip.frames.rotation[2].data(), clip.frames.rotation[3].data(),
+					clip.frames.scale[0].data(), clip.frames.scale[1].data(), clip.frames.scale[2].data() };
+				for (uint32_t k = 0; k < 10; k++)
+				{
+					const float* track = tracks[k] + slot;
+					for (uint32_t i = 0; i < count; i++)
+					{
+						const float a = track[frameA[i]];
+						trs[k][i] = a + (track[frameB[i]] - a) * blend[i];
+					}
+				}
+
+				// nlerp: кадры клипа приведены к одной полусфере
+				for (uint32_t i = 0; i < count; i++)
+				{
+					const float length = sqrtf(trs[3][i] * trs[3][i] + trs[4][i] * trs[4][i] + trs[5][i] * trs[5][i] + trs[6][i] * trs[6][i]);
+					const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+					trs[3][i] *= invLength;
+					trs[4][i] *= invLength;
+					trs[5][i] *= invLength;
+					trs[6][i] *= invLength;
+				}
+			}
+
+			//локальная матрица T * R * S
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const float x = trs[3][i], y = trs[4][i], z = trs[5][i], w = trs[6][i];
+				const float sx = trs[7][i], sy = trs[8][i], sz = trs[9][i];
+				local[0][i] = (1.0f - 2.0f * (y * y + z * z)) * sx;
+				local[1][i] = 2.0f * (x * y - w * z) * sy;
+				local[2][i] = 2.0f * (x * z + w * y) * sz;
+				local[3][i] = trs[0][i];
+				local[4][i] = 2.0f * (x * y + w * z) * sx;
+				local[5][i] = (1.0f - 2.0f * (x * x + z * z)) * sy;
+				local[6][i] = 2.0f * (y * z - w * x) * sz;
+				local[7][i] = trs[1][i];
+				local[8][i] = 2.0f * (x * z - w * y) * sx;
+				local[9][i] = 2.0f * (y * z + w * x) * sy;
+				local[10][i] = (1.0f - 2.0f * (x * x + y * y)) * sz;
+				local[11][i] = trs[2][i];
+			}
+
+			float* world = &worlds[s * 12 * CHUNK];
+			if (nodeMatrices[s] != mat4(1.0f))
+			{
+				BroadcastAffine(nodeMatrices[s], &constant[0][0], count);
+				MulAffine(&local[0][0], &constant[0][0], world, count);
+				for (uint32_t e = 0; e < 12; e++)
+					copy(world + e * CHUNK, world + e * CHUNK + count, local[e]);
+			}
+
+			//корни скелета сразу переводятся в систему узла с гранями
+			if (parents[s] < 0)
+			{
+				BroadcastAffine(meshInverse, &constant[0][0], count);
+				MulAffine(&constant[0][0], &local[0][0], world, count);
+			}
+			else
+				MulAffine(&worlds[parents[s] * 12 * CHUNK], &local[0][0], world, count);
+		}
+
+		for (uint32_t j = 0; j < jointCount; j++)
+		{
+			BroadcastAffine(skin->inverseBindMatrices[j], &constant[0][0], count);
+			MulAffine(&worlds[jointSlots[j] * 12 * CHUNK], &constant[0][0], &local[0][0], count);
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				mat4 palette(1.0f);
+				for (uint32_t r = 0; r < 3; r++)
+					for (uint32_t c = 0; c < 4; c++)
+						palette[c][r] = local[r * 4 + c][i];
+				palettes[instances[i] * jointCount + j] = palette;
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить ресурсы Vulkan
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Crowd::Destroy()
+	{
+		paletteBuffer.destroy();
+		clips.clear();
+		times.clear();
+		speeds.clear();
+	}
+}
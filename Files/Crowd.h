@@ -0,0 +1,78 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+#include "VulkanBuffer.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * пакетная анимация толпы: один скелет и клипы модели на много экземпляров
+	 *
+	 * Состояние экземпляров (клип, время, скорость) хранится в формате SoA.
+	 * Экземпляры группируются по клипу и считаются блоками по CHUNK штук:
+	 * все промежуточные данные блока (TRS, локальные и мировые матрицы)
+	 * лежат массивами по экземплярам: дорожки клипа и родитель узла
+	 * выбираются один раз на блок, внутренние циклы идут подряд по
+	 * экземплярам.
+	 * Палитры суставов пишутся подряд: экземпляр i, сустав j -
+	 * paletteBuffer[i * jointCount + j]. Буфер палитр содержит область
+	 * на каждый кадр в полете (Model::framesInFlight), Update() пишет
+	 * область своего кадра, дескриптор paletteBuffer описывает одну
+	 * область и связывается как STORAGE_BUFFER_DYNAMIC со смещением
+	 * PaletteOffset().
+	 *
+	***********************************************************************/
+	class Crowd
+	{
+	public:
+		static constexpr uint32_t CHUNK = 64;
+
+		Model* model = nullptr;
+		Skin* skin = nullptr;
+		uint32_t jointCount = 0;
+		uint32_t maxInstances = 0;
+
+		vector<uint32_t> clips;
+		vector<float> times;
+		vector<float> speeds;
+
+		Buffer paletteBuffer;
+		VkDeviceSize paletteFrameSize = 0;
+		uint32_t frameCount = 1;
+		uint32_t frame = 0;
+
+		void Init(Model* model, uint32_t skinIndex, uint32_t maxInstances);
+		uint32_t AddInstance(uint32_t clip, float time = 0.0f, float speed = 1.0f);
+		uint32_t InstanceCount() const { return static_cast<uint32_t>(clips.size()); }
+		void Update(float deltaTime, uint32_t frameIndex);
+		uint32_t PaletteOffset() const { return static_cast<uint32_t>(frame * paletteFrameSize); }
+		void Destroy();
+
+	private:
+		//узлы скелета в порядке родитель раньше потомка
+		vector<Node*> skeleton;
+		vector<int32_t> parents;
+		vector<mat4> rootMatrices;
+		vector<mat4> nodeMatrices;
+		AnimationPose restPose;
+		//для каждого клипа: слот клипа для узла скелета или -1
+		vector<vector<int32_t>> clipSlots;
+		vector<uint32_t> jointSlots;
+		mat4 meshInverse{ 1.0f };
+
+		vector<uint32_t> order;
+		vector<uint32_t> clipCounts;
+
+		//рабочие массивы блока
+		vector<float> worlds;
+		float local[12][CHUNK];
+		float constant[12][CHUNK];
+		float trs[10][CHUNK];
+		uint32_t frameA[CHUNK];
+		uint32_t frameB[CHUNK];
+		float blend[CHUNK];
+
+		void CollectSkeleton(Node* node, const vector<bool>& required);
+		void EvaluateChunk(uint32_t clipIndex, const uint32_t* instances, uint32_t count, mat4* palettes);
+	};
+}
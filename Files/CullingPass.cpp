@@ -0,0 +1,199 @@
+#include "CullingPass.h"
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			создать буфер видимых команд и счетчиков
+	 *	входящие значения:	model - модель с непрямой отрисовкой
+	 *	выходящие значения:	false, если не включена возможность
+	 *						drawIndirectFirstInstance
+	 **********************************************/
+	bool CullingPass::Init(Model* model)
+	{
+		this->model = model;
+		this->device = model->device;
+
+		if (!device->enabledFeatures.drawIndirectFirstInstance)
+			return false;
+
+		pushConstBlock.drawCount = model->indirectCommandCount;
+		for (uint32_t mode = 0; mode < 3; mode++)
+			pushConstBlock.firstCommand[mode] = model->indirectBatches[mode].firstCommand;
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&visibleBuffer,
+			std::max(model->indirectCommandCount, 1u) * sizeof(VkDrawIndexedIndirectCommand)));
+
+		//один счетчик на диапазон конвейера
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&countBuffer,
+			4 * sizeof(uint32_t)));
+		return true;
+	}
+
+	/***********************************************
+	 *	функция:			PreparePipeline()
+	 *	назначение:			создать вычислительный конвейер отсечения
+	 *	входящие значения:	pipelineCache - кэш конвейеров
+	 *						shader - шейдер cull.comp
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void CullingPass::PreparePipeline(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& shader)
+	{
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1),
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = initializers::descriptorPoolCreateInfo(poolSizes, 1);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolInfo, nullptr, &descriptorPool));
+
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 2),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 3),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 4),
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayout = initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayout, nullptr, &descriptorSetLayout));
+
+		VkDescriptorSetAllocateInfo allocInfo = initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
+
+		//кольцо граней на один кадр, смещение кадра задается при связывании
+		VkDescriptorBufferInfo ringDescriptor{ model->uniformRing.buffer.buffer, 0, model->uniformRing.frameSize };
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 0, &ringDescriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &model->drawDataBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &model->indirectBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &visibleBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4, &countBuffer.descriptor),
+		};
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+		VkPushConstantRange pushConstantRange = initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstBlock), 0);
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		VK_CHECK_RESULT(vkCreatePipelineLayout(device->logicalDevice, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
+
+		VkComputePipelineCreateInfo computePipelineCreateInfo = initializers::computePipelineCreateInfo(pipelineLayout);
+		computePipelineCreateInfo.stage = shader;
+		VK_CHECK_RESULT(vkCreateComputePipelines(device->logicalDevice, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &pipeline));
+	}
+
+	/***********************************************
+	 *	функция:			Dispatch()
+	 *	назначение:			записать отсечение в командный буфер (вне
+	 *						прохода рендера, после Model::BeginFrame)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						frustum - пирамида видимости камеры
+	 *						(vks::Frustum::Update от projection * view)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void CullingPass::Dispatch(VkCommandBuffer commandBuffer, const vks::Frustum& frustum)
+	{
+		if (pushConstBlock.drawCount == 0)
+			return;
+
+		for (size_t i = 0; i < frustum.planes.size(); i++)
+			pushConstBlock.planes[i] = frustum.planes[i];
+
+		//прошлый кадр читал команды как непрямые
+		VkBufferMemoryBarrier barriers[2] = { initializers::bufferMemoryBarrier(), initializers::bufferMemoryBarrier() };
+		barriers[0].srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barriers[0].buffer = visibleBuffer.buffer;
+		barriers[0].offset = 0;
+		barriers[0].size = VK_WHOLE_SIZE;
+		barriers[1] = barriers[0];
+		barriers[1].buffer = countBuffer.buffer;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 2, barriers, 0, nullptr);
+
+		//отсеченные команды остаются нулевыми (пустая отрисовка)
+		vkCmdFillBuffer(commandBuffer, visibleBuffer.buffer, 0, VK_WHOLE_SIZE, 0);
+		vkCmdFillBuffer(commandBuffer, countBuffer.buffer, 0, VK_WHOLE_SIZE, 0);
+
+		for (VkBufferMemoryBarrier& barrier : barriers)
+		{
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		}
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 2, barriers, 0, nullptr);
+
+		const uint32_t frameOffset = model->uniformRing.Offset(0);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 1, &frameOffset);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
+		vkCmdDispatch(commandBuffer, (pushConstBlock.drawCount + 63) / 64, 1, 1);
+
+		for (VkBufferMemoryBarrier& barrier : barriers)
+		{
+			barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		}
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 0, nullptr, 2, barriers, 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			Draw()
+	 *	назначение:			отобразить видимые примитивы диапазона
+	 *						конвейера одной непрямой командой
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						drawPipelineLayout - макет графического конвейера
+	 *						alphaMode - режим прозрачности (конвейер)
+	 *						bindSet - номер набора данных отрисовки
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void CullingPass::Draw(VkCommandBuffer commandBuffer, VkPipelineLayout drawPipelineLayout, Material::AlphaMode alphaMode, uint32_t bindSet)
+	{
+		const IndirectBatch& batch = model->indirectBatches[alphaMode];
+		if (batch.commandCount == 0)
+			return;
+
+		model->BindIndirect(commandBuffer, drawPipelineLayout, bindSet);
+
+		const VkDeviceSize offset = batch.firstCommand * sizeof(VkDrawIndexedIndirectCommand);
+		if (drawIndirectCount)
+		{
+			vkCmdDrawIndexedIndirectCount(commandBuffer, visibleBuffer.buffer, offset, countBuffer.buffer, alphaMode * sizeof(uint32_t), batch.commandCount, sizeof(VkDrawIndexedIndirectCommand));
+		}
+		else if (device->enabledFeatures.multiDrawIndirect)
+		{
+			vkCmdDrawIndexedIndirect(commandBuffer, visibleBuffer.buffer, offset, batch.commandCount, sizeof(VkDrawIndexedIndirectCommand));
+		}
+		else
+		{
+			for (uint32_t i = 0; i < batch.commandCount; i++)
+				vkCmdDrawIndexedIndirect(commandBuffer, visibleBuffer.buffer, offset + i * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить ресурсы Vulkan
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void CullingPass::Destroy()
+	{
+		visibleBuffer.destroy();
+		countBuffer.destroy();
+
+		if (pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(device->logicalDevice, pipeline, nullptr);
+			vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
+			vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
+			vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
+		}
+		pipeline = VK_NULL_HANDLE;
+	}
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+#include "VulkanBuffer.h"
+#include "VulkanInitializers.h"
+#include "Frustum.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * отсечение примитивов по пирамиде видимости вычислительным шейдером
+	 *
+	 * Для каждой команды Model::indirectBuffer шейдер cull.comp переводит
+	 * ограничивающую сферу DrawData::bounds матрицей узла из кольцевого
+	 * буфера и проверяет ее плоскостями vks::Frustum. Видимые команды
+	 * пишутся подряд в начало диапазона своего конвейера (IndirectBatch),
+	 * число видимых - атомарным счетчиком на диапазон. Остаток диапазона
+	 * заполнен нулевыми командами, поэтому без drawIndirectCount буфер
+	 * можно рисовать целиком. Шейдер копирует ненулевой firstInstance
+	 * в непрямые команды, поэтому без возможности drawIndirectFirstInstance
+	 * Init() возвращает false и модель рисуется Model::DrawIndirect()
+	 * без отсечения.
+	 *
+	***********************************************************************/
+	class CullingPass
+	{
+	public:
+		//раскладка совпадает с push_constant в cull.comp
+		struct PushConstBlock
+		{
+			vec4 planes[6];
+			uint32_t drawCount;
+			uint32_t firstCommand[3];
+		} pushConstBlock;
+
+		Model* model = nullptr;
+		VulkanDevice* device = nullptr;
+		//включена возможность drawIndirectCount (Vulkan 1.2)
+		bool drawIndirectCount = false;
+
+		Buffer visibleBuffer;
+		Buffer countBuffer;
+
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+
+		bool Init(Model* model);
+		void PreparePipeline(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& shader);
+		void Dispatch(VkCommandBuffer commandBuffer, const vks::Frustum& frustum);
+		void Draw(VkCommandBuffer commandBuffer, VkPipelineLayout drawPipelineLayout, Material::AlphaMode alphaMode, uint32_t bindSet = 1);
+		void Destroy();
+	};
+}
@@ -1,68 +1,293 @@
-#include "Frustum.h"
-
-namespace vks
-{
-	/***********************************************
-	 *	:			Update()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	void Frustum::Update(glm::mat4 matrix)
-	{
-		planes[LEFT].x = matrix[0].w + matrix[0].x;
-		planes[LEFT].y = matrix[1].w + matrix[1].x;
-		planes[LEFT].z = matrix[2].w + matrix[2].x;
-		planes[LEFT].w = matrix[3].w + matrix[3].x;
-
-		planes[RIGHT].x = matrix[0].w - matrix[0].x;
-		planes[RIGHT].y = matrix[1].w - matrix[1].x;
-		planes[RIGHT].z = matrix[2].w - matrix[2].x;
-		planes[RIGHT].w = matrix[3].w - matrix[3].x;
-
-		planes[TOP].x = matrix[0].w - matrix[0].y;
-		planes[TOP].y = matrix[1].w - matrix[1].y;
-		planes[TOP].z = matrix[2].w - matrix[2].y;
-		planes[TOP].w = matrix[3].w - matrix[3].y;
-
-		planes[BOTTOM].x = matrix[0].w + matrix[0].y;
-		planes[BOTTOM].y = matrix[1].w + matrix[1].y;
-		planes[BOTTOM].z = matrix[2].w + matrix[2].y;
-		planes[BOTTOM].w = matrix[3].w + matrix[3].y;
-
-		planes[BACK].x = matrix[0].w + matrix[0].z;
-		planes[BACK].y = matrix[1].w + matrix[1].z;
-		planes[BACK].z = matrix[2].w + matrix[2].z;
-		planes[BACK].w = matrix[3].w + matrix[3].z;
-
-		planes[FRONT].x = matrix[0].w - matrix[0].z;
-		planes[FRONT].y = matrix[1].w - matrix[1].z;
-		planes[FRONT].z = matrix[2].w - matrix[2].z;
-		planes[FRONT].w = matrix[3].w - matrix[3].z;
-
-		for (auto i = 0; i < planes.size(); i++)
-		{
-			float length = sqrtf(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
-			planes[i] /= length;
-		}
-	}
-
-	/***********************************************
-	 *	:			CheckSphere()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	bool Frustum::CheckSphere(glm::vec3 pos, float radius)
-	{
-
-		for (auto i = 0; i < planes.size(); i++)
-		{
-			if ((planes[i].x * pos.x) + (planes[i].y * pos.y) + (planes[i].z * pos.z) + planes[i].w <= -radius)
-			{
-				return false;
-			}
-		}
-		return true;
-	}
-}
+#include "Frustum.h"
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace vks
+{
+	/***********************************************
+	 *	функция:			Update()
+	 *	назначение:			обновление матрицы вида
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Frustum::Update(glm::mat4 matrix)
+	{
+		planes[LEFT].x = matrix[0].w + matrix[0].x;
+		planes[LEFT].y = matrix[1].w + matrix[1].x;
+		planes[LEFT].z = matrix[2].w + matrix[2].x;
+		planes[LEFT].w = matrix[3].w + matrix[3].x;
+
+		planes[RIGHT].x = matrix[0].w - matrix[0].x;
+		planes[RIGHT].y = matrix[1].w - matrix[1].x;
+		planes[RIGHT].z = matrix[2].w - matrix[2].x;
+		planes[RIGHT].w = matrix[3].w - matrix[3].x;
+
+		planes[TOP].x = matrix[0].w - matrix[0].y;
+		planes[TOP].y = matrix[1].w - matrix[1].y;
+		planes[TOP].z = matrix[2].w - matrix[2].y;
+		planes[TOP].w = matrix[3].w - matrix[3].y;
+
+		planes[BOTTOM].x = matrix[0].w + matrix[0].y;
+		planes[BOTTOM].y = matrix[1].w + matrix[1].y;
+		planes[BOTTOM].z = matrix[2].w + matrix[2].y;
+		planes[BOTTOM].w = matrix[3].w + matrix[3].y;
+
+		planes[BACK].x = matrix[0].w + matrix[0].z;
+		planes[BACK].y = matrix[1].w + matrix[1].z;
+		planes[BACK].z = matrix[2].w + matrix[2].z;
+		planes[BACK].w = matrix[3].w + matrix[3].z;
+
+		planes[FRONT].x = matrix[0].w - matrix[0].z;
+		planes[FRONT].y = matrix[1].w - matrix[1].z;
+		planes[FRONT].z = matrix[2].w - matrix[2].z;
+		planes[FRONT].w = matrix[3].w - matrix[3].z;
+
+		for (size_t i = 0; i < planes.size(); i++)
+		{
+			float length = sqrtf(planes[i].x * planes[i].x + planes[i].y * planes[i].y + planes[i].z * planes[i].z);
+			planes[i] /= length;
+		}
+	}
+
+	/***********************************************
+	 *	функция:			CheckSphere()
+	 *	назначение:			обновление матрицы вида
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	bool Frustum::CheckSphere(glm::vec3 pos, float radius)
+	{
+
+		for (size_t i = 0; i < planes.size(); i++)
+		{
+			if ((planes[i].x * pos.x) + (planes[i].y * pos.y) + (planes[i].z * pos.z) + planes[i].w <= -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/***********************************************
+	 *	функция:			CheckBox()
+	 *	назначение:			проверка коробки по дальней вдоль нормали
+	 *						плоскости вершине
+	 *	входящие значения:	min, max - углы коробки
+	 *	выходящие значения:	false, если коробка вне пирамиды
+	 **********************************************/
+	bool Frustum::CheckBox(glm::vec3 min, glm::vec3 max) const
+	{
+		for (size_t i = 0; i < planes.size(); i++)
+		{
+			const glm::vec3 p(planes[i].x > 0.0f ? max.x : min.x, planes[i].y > 0.0f ? max.y : min.y, planes[i].z > 0.0f ? max.z : min.z);
+			if ((planes[i].x * p.x) + (planes[i].y * p.y) + (planes[i].z * p.z) + planes[i].w < 0.0f)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/***********************************************
+	 *	функция:			CheckSpheres()
+	 *	назначение:			пакетная проверка сфер по LANES штук
+	 *						(все шесть плоскостей без раннего выхода;
+	 *						с __AVX2__ пакет - один регистр, с __SSE2__ -
+	 *						два, иначе скалярный выбор без ветвления)
+	 *	входящие значения:	spheres - сферы в формате SoA
+	 *						visible - результат, spheres.count элементов
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Frustum::CheckSpheres(const SphereArray& spheres, uint8_t* visible) const
+	{
+		for (size_t first = 0; first < spheres.count; first += LANES)
+		{
+			const float* x = &spheres.x[first];
+			const float* y = &spheres.y[first];
+			const float* z = &spheres.z[first];
+			const float* radius = &spheres.radius[first];
+
+			//бит j - сфера j пакета видима
+			uint32_t mask;
+#if defined(__AVX2__)
+			static_assert(LANES == 8, "AVX2 path expects 8 lanes");
+			const __m256 px = _mm256_loadu_ps(x);
+			const __m256 py = _mm256_loadu_ps(y);
+			const __m256 pz = _mm256_loadu_ps(z);
+			const __m256 limit = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(radius));
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (const glm::vec4& plane : planes)
+			{
+				const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), px), _mm256_mul_ps(_mm256_set1_ps(plane.y), py)),
+					_mm256_mul_ps(_mm256_set1_ps(plane.z), pz)), _mm256_set1_ps(plane.w));
+				//NLE вместо GT: NaN считается видимым, как в скалярной ветке
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, limit, _CMP_NLE_UQ));
+			}
+			mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+#elif defined(__SSE2__)
+			static_assert(LANES == 8, "SSE2 path expects 8 lanes");
+			mask = 0;
+			for (size_t half = 0; half < LANES; half += 4)
+			{
+				const __m128 px = _mm_loadu_ps(x + half);
+				const __m128 py = _mm_loadu_ps(y + half);
+				const __m128 pz = _mm_loadu_ps(z + half);
+				const __m128 limit = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(radius + half));
+				__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (const glm::vec4& plane : planes)
+				{
+					const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), px), _mm_mul_ps(_mm_set1_ps(plane.y), py)),
+						_mm_mul_ps(_mm_set1_ps(plane.z), pz)), _mm_set1_ps(plane.w));
+					inside = _mm_and_ps(inside, _mm_cmpnle_ps(distance, limit));
+				}
+				mask |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << half;
+			}
+#else
+			float inside[LANES];
+			for (size_t j = 0; j < LANES; j++)
+				inside[j] = 1.0f;
+
+			for (const glm::vec4& plane : planes)
+			{
+				for (size_t j = 0; j < LANES; j++)
+				{
+					const float distance = plane.x * x[j] + plane.y * y[j] + plane.z * z[j] + plane.w;
+					inside[j] = distance <= -radius[j] ? 0.0f : inside[j];
+				}
+			}
+
+			mask = 0;
+			for (size_t j = 0; j < LANES; j++)
+				mask |= static_cast<uint32_t>(inside[j] != 0.0f) << j;
+#endif
+
+			const size_t count = spheres.count - first < LANES ? spheres.count - first : LANES;
+			for (size_t j = 0; j < count; j++)
+				visible[first + j] = (mask >> j) & 1;
+		}
+	}
+
+	/***********************************************
+	 *	функция:			CheckBoxes()
+	 *	назначение:			пакетная проверка коробок по LANES штук
+	 *						(знак нормали общий для пакета, поэтому
+	 *						выбор вершины - выбор массива; регистры
+	 *						как в CheckSpheres())
+	 *	входящие значения:	boxes - коробки в формате SoA
+	 *						visible - результат, boxes.count элементов
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Frustum::CheckBoxes(const BoxArray& boxes, uint8_t* visible) const
+	{
+		for (size_t first = 0; first < boxes.count; first += LANES)
+		{
+			//бит j - коробка j пакета видима
+			uint32_t mask;
+#if defined(__AVX2__)
+			static_assert(LANES == 8, "AVX2 path expects 8 lanes");
+			const __m256 zero = _mm256_setzero_ps();
+			__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+			for (const glm::vec4& plane : planes)
+			{
+				const __m256 px = _mm256_loadu_ps(plane.x > 0.0f ? &boxes.maxX[first] : &boxes.minX[first]);
+				const __m256 py = _mm256_loadu_ps(plane.y > 0.0f ? &boxes.maxY[first] : &boxes.minY[first]);
+				const __m256 pz = _mm256_loadu_ps(plane.z > 0.0f ? &boxes.maxZ[first] : &boxes.minZ[first]);
+				const __m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.x), px), _mm256_mul_ps(_mm256_set1_ps(plane.y), py)),
+					_mm256_mul_ps(_mm256_set1_ps(plane.z), pz)), _mm256_set1_ps(plane.w));
+				inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, zero, _CMP_NLT_UQ));
+			}
+			mask = static_cast<uint32_t>(_mm256_movemask_ps(inside));
+#elif defined(__SSE2__)
+			static_assert(LANES == 8, "SSE2 path expects 8 lanes");
+			mask = 0;
+			for (size_t half = 0; half < LANES; half += 4)
+			{
+				const size_t i = first + half;
+				__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (const glm::vec4& plane : planes)
+				{
+					const __m128 px = _mm_loadu_ps(plane.x > 0.0f ? &boxes.maxX[i] : &boxes.minX[i]);
+					const __m128 py = _mm_loadu_ps(plane.y > 0.0f ? &boxes.maxY[i] : &boxes.minY[i]);
+					const __m128 pz = _mm_loadu_ps(plane.z > 0.0f ? &boxes.maxZ[i] : &boxes.minZ[i]);
+					const __m128 distance = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.x), px), _mm_mul_ps(_mm_set1_ps(plane.y), py)),
+						_mm_mul_ps(_mm_set1_ps(plane.z), pz)), _mm_set1_ps(plane.w));
+					inside = _mm_and_ps(inside, _mm_cmpnlt_ps(distance, _mm_setzero_ps()));
+				}
+				mask |= static_cast<uint32_t>(_mm_movemask_ps(inside)) << half;
+			}
+#else
+			float inside[LANES];
+			for (size_t j = 0; j < LANES; j++)
+				inside[j] = 1.0f;
+
+			for (const glm::vec4& plane : planes)
+			{
+				const float* x = plane.x > 0.0f ? &boxes.maxX[first] : &boxes.minX[first];
+				const float* y = plane.y > 0.0f ? &boxes.maxY[first] : &boxes.minY[first];
+				const float* z = plane.z > 0.0f ? &boxes.maxZ[first] : &boxes.minZ[first];
+				for (size_t j = 0; j < LANES; j++)
+				{
+					const float distance = plane.x * x[j] + plane.y * y[j] + plane.z * z[j] + plane.w;
+					inside[j] = distance < 0.0f ? 0.0f : inside[j];
+				}
+			}
+
+			mask = 0;
+			for (size_t j = 0; j < LANES; j++)
+				mask |= static_cast<uint32_t>(inside[j] != 0.0f) << j;
+#endif
+
+			const size_t count = boxes.count - first < LANES ? boxes.count - first : LANES;
+			for (size_t j = 0; j < count; j++)
+				visible[first + j] = (mask >> j) & 1;
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Resize()
+	 *	назначение:			задать число коробок
+	 *	входящие значения:	count - число коробок
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void BoxArray::Resize(size_t count)
+	{
+		this->count = count;
+		const size_t padded = (count + Frustum::LANES - 1) / Frustum::LANES * Frustum::LANES;
+		for (std::vector<float>* values : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+			values->assign(padded, 0.0f);
+	}
+
+	void BoxArray::Set(size_t index, glm::vec3 min, glm::vec3 max)
+	{
+		minX[index] = min.x;
+		minY[index] = min.y;
+		minZ[index] = min.z;
+		maxX[index] = max.x;
+		maxY[index] = max.y;
+		maxZ[index] = max.z;
+	}
+
+	/***********************************************
+	 *	функция:			Resize()
+	 *	назначение:			задать число сфер
+	 *	входящие значения:	count - число сфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void SphereArray::Resize(size_t count)
+	{
+		this->count = count;
+		const size_t padded = (count + Frustum::LANES - 1) / Frustum::LANES * Frustum::LANES;
+		for (std::vector<float>* values : { &x, &y, &z, &radius })
+			values->assign(padded, 0.0f);
+	}
+
+	void SphereArray::Set(size_t index, glm::vec3 center, float radius)
+	{
+		x[index] = center.x;
+		y[index] = center.y;
+		z[index] = center.z;
+		this->radius[index] = radius;
+	}
+}
@@ -1,17 +1,57 @@
-#pragma once
-#include <array>
-#include <glm/glm.hpp>
-
-namespace vks
-{
-	class Frustum
-	{
-	public:
-
-		enum side { LEFT = 0, RIGHT = 1, TOP = 2, BOTTOM = 3, BACK = 4, FRONT = 5};
-		std::array<glm::vec4, 6> planes;
-
-		void Update(glm::mat4 matrix);
-		bool CheckSphere(glm::vec3 pos, float radius);
-	};
-}
+#pragma once
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+namespace vks
+{
+	struct BoxArray;
+	struct SphereArray;
+
+	class Frustum
+	{
+	public:
+		//число объектов в одном пакете проверок
+		static constexpr size_t LANES = 8;
+
+		enum side { LEFT = 0, RIGHT = 1, TOP = 2, BOTTOM = 3, BACK = 4, FRONT = 5};
+		std::array<glm::vec4, 6> planes;
+
+		void Update(glm::mat4 matrix);
+		bool CheckSphere(glm::vec3 pos, float radius);
+		bool CheckBox(glm::vec3 min, glm::vec3 max) const;
+		void CheckSpheres(const SphereArray& spheres, uint8_t* visible) const;
+		void CheckBoxes(const BoxArray& boxes, uint8_t* visible) const;
+	};
+
+	/*************************************************************************
+	 * ограничивающие коробки в формате SoA для пакетных проверок,
+	 * массивы дополнены до кратного Frustum::LANES
+	 *
+	***********************************************************************/
+	struct BoxArray
+	{
+		std::vector<float> minX, minY, minZ;
+		std::vector<float> maxX, maxY, maxZ;
+		size_t count = 0;
+
+		void Resize(size_t count);
+		void Set(size_t index, glm::vec3 min, glm::vec3 max);
+	};
+
+	/*************************************************************************
+	 * ограничивающие сферы в формате SoA для пакетных проверок,
+	 * массивы дополнены до кратного Frustum::LANES
+	 *
+	***********************************************************************/
+	struct SphereArray
+	{
+		std::vector<float> x, y, z;
+		std::vector<float> radius;
+		size_t count = 0;
+
+		void Resize(size_t count);
+		void Set(size_t index, glm::vec3 center, float radius);
+	};
+}
@@ -1,3 +1,3 @@
-#include "GlobalVulkan.h"
-
+#include "GlobalVulkan.h"
+
 UISettings uiSettings;
\ No newline at end of file
@@ -0,0 +1,348 @@
+#include "MemoryAllocator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace vks
+{
+	namespace
+	{
+		uint32_t Order(VkDeviceSize size)
+		{
+			uint32_t order = 0;
+			while ((MemoryAllocator::MIN_SIZE << order) < size)
+				order++;
+			return order;
+		}
+	}
+
+	MemoryAllocator::~MemoryAllocator()
+	{
+		Destroy();
+	}
+
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			подготовить распределитель для устройства
+	 *	входящие значения:	device - логическое устройство
+	 *						properties - свойства (ограничения) устройства
+	 *						memoryProperties - типы и кучи памяти
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MemoryAllocator::Init(VkDevice device, const VkPhysicalDeviceProperties& properties, const VkPhysicalDeviceMemoryProperties& memoryProperties)
+	{
+		this->device = device;
+		this->memoryProperties = memoryProperties;
+		nonCoherentAtomSize = std::max<VkDeviceSize>(properties.limits.nonCoherentAtomSize, 1);
+	}
+
+	uint32_t MemoryAllocator::FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const
+	{
+		for (uint32_t i = 0; i < memoryProperties.memoryTypeCount; i++)
+		{
+			if ((typeBits & (1u << i)) && (memoryProperties.memoryTypes[i].propertyFlags & properties) == properties)
+				return i;
+		}
+		throw std::runtime_error("Could not find a matching memory type");
+	}
+
+	/***********************************************
+	 *	функция:			BlockSize()
+	 *	назначение:			размер блока типа памяти: BLOCK_SIZE, но не
+	 *						больше восьмой части кучи (степень двойки)
+	 *	входящие значения:	memoryType - тип памяти
+	 *	выходящие значения:	размер блока
+	 **********************************************/
+	VkDeviceSize MemoryAllocator::BlockSize(uint32_t memoryType) const
+	{
+		const VkDeviceSize heapSize = memoryProperties.memoryHeaps[memoryProperties.memoryTypes[memoryType].heapIndex].size;
+		VkDeviceSize size = BLOCK_SIZE;
+		while (size > MIN_SIZE && size > heapSize / 8)
+			size >>= 1;
+		return size;
+	}
+
+	/***********************************************
+	 *	функция:			Allocate()
+	 *	назначение:			выделить участок памяти
+	 *	входящие значения:	requirements - требования ресурса
+	 *						properties - свойства памяти
+	 *						linear - буфер или линейное изображение
+	 *						deviceAddress - память для адреса буфера
+	 *						allocation - результат
+	 *	выходящие значения:	результат vkAllocateMemory
+	 **********************************************/
+	VkResult MemoryAllocator::Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear, Allocation& allocation, bool deviceAddress)
+	{
+		const uint32_t memoryType = FindMemoryType(requirements.memoryTypeBits, properties);
+		const VkMemoryPropertyFlags typeFlags = memoryProperties.memoryTypes[memoryType].propertyFlags;
+		const bool hostVisible = typeFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT;
+
+		//сброс некогерентной памяти идет атомами, участок не должен делить атом с соседом
+		VkDeviceSize alignment = requirements.alignment;
+		if (hostVisible && !(typeFlags & VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+			alignment = std::max(alignment, nonCoherentAtomSize);
+		const uint32_t order = Order(std::max(requirements.size, alignment));
+
+		std::lock_guard<std::mutex> lock(mutex);
+		allocation = {};
+
+		if (deviceAddress || (MIN_SIZE << order) > BlockSize(memoryType) / 2)
+		{
+			VkMemoryAllocateInfo memoryAllocateInfo{};
+			memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+			memoryAllocateInfo.allocationSize = requirements.size;
+			memoryAllocateInfo.memoryTypeIndex = memoryType;
+			VkMemoryAllocateFlagsInfoKHR allocateFlagsInfo{};
+			if (deviceAddress)
+			{
+				allocateFlagsInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_FLAGS_INFO_KHR;
+				allocateFlagsInfo.flags = VK_MEMORY_ALLOCATE_DEVICE_ADDRESS_BIT_KHR;
+				memoryAllocateInfo.pNext = &allocateFlagsInfo;
+			}
+			VkResult result = vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &allocation.memory);
+			if (result != VK_SUCCESS)
+				return result;
+			allocation.size = requirements.size;
+			if (hostVisible)
+			{
+				result = vkMapMemory(device, allocation.memory, 0, VK_WHOLE_SIZE, 0, &allocation.mapped);
+				if (result != VK_SUCCESS)
+				{
+					vkFreeMemory(device, allocation.memory, nullptr);
+					allocation = {};
+					return result;
+				}
+			}
+			dedicatedCount++;
+			allocationCount++;
+			return VK_SUCCESS;
+		}
+
+		for (MemoryBlock* block : blocks)
+		{
+			if (block->memoryType == memoryType && block->linear == linear && AllocateFromBlock(block, order, allocation))
+			{
+				allocationCount++;
+				return VK_SUCCESS;
+			}
+		}
+
+		MemoryBlock* block = CreateBlock(memoryType, linear);
+		if (!block)
+			return VK_ERROR_OUT_OF_DEVICE_MEMORY;
+		AllocateFromBlock(block, order, allocation);
+		allocationCount++;
+		return VK_SUCCESS;
+	}
+
+	/***********************************************
+	 *	функция:			AllocateBuffer()
+	 *	назначение:			выделить и связать память буфера
+	 *	входящие значения:	buffer - буфер
+	 *						properties - свойства памяти
+	 *						allocation - результат
+	 *	выходящие значения:	результат выделения или связывания
+	 **********************************************/
+	VkResult MemoryAllocator::AllocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties, Allocation& allocation, bool deviceAddress)
+	{
+		VkMemoryRequirements requirements;
+		vkGetBufferMemoryRequirements(device, buffer, &requirements);
+		VkResult result = Allocate(requirements, properties, true, allocation, deviceAddress);
+		if (result != VK_SUCCESS)
+			return result;
+		return vkBindBufferMemory(device, buffer, allocation.memory, allocation.offset);
+	}
+
+	/***********************************************
+	 *	функция:			AllocateImage()
+	 *	назначение:			выделить и связать память изображения
+	 *	входящие значения:	image - изображение
+	 *						properties - свойства памяти
+	 *						allocation - результат
+	 *						linear - изображение VK_IMAGE_TILING_LINEAR
+	 *	выходящие значения:	результат выделения или связывания
+	 **********************************************/
+	VkResult MemoryAllocator::AllocateImage(VkImage image, VkMemoryPropertyFlags properties, Allocation& allocation, bool linear)
+	{
+		VkMemoryRequirements requirements;
+		vkGetImageMemoryRequirements(device, image, &requirements);
+		VkResult result = Allocate(requirements, properties, linear, allocation);
+		if (result != VK_SUCCESS)
+			return result;
+		return vkBindImageMemory(device, image, allocation.memory, allocation.offset);
+	}
+
+	/***********************************************
+	 *	функция:			CreateBlock()
+	 *	назначение:			выделить и отобразить новый блок
+	 *	входящие значения:	memoryType - тип памяти
+	 *						linear - вид ресурсов блока
+	 *	выходящие значения:	блок или nullptr, если память кончилась
+	 **********************************************/
+	MemoryBlock* MemoryAllocator::CreateBlock(uint32_t memoryType, bool linear)
+	{
+		MemoryBlock* block = new MemoryBlock();
+		block->memoryType = memoryType;
+		block->linear = linear;
+		block->size = BlockSize(memoryType);
+
+		VkMemoryAllocateInfo memoryAllocateInfo{};
+		memoryAllocateInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		memoryAllocateInfo.allocationSize = block->size;
+		memoryAllocateInfo.memoryTypeIndex = memoryType;
+		if (vkAllocateMemory(device, &memoryAllocateInfo, nullptr, &block->memory) != VK_SUCCESS)
+		{
+			delete block;
+			return nullptr;
+		}
+		if (memoryProperties.memoryTypes[memoryType].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT)
+		{
+			void* mapped = nullptr;
+			if (vkMapMemory(device, block->memory, 0, VK_WHOLE_SIZE, 0, &mapped) != VK_SUCCESS)
+			{
+				vkFreeMemory(device, block->memory, nullptr);
+				delete block;
+				return nullptr;
+			}
+			block->mapped = static_cast<uint8_t*>(mapped);
+		}
+
+		//весь блок - один свободный участок старшего порядка
+		const uint32_t maxOrder = Order(block->size);
+		block->freeOffsets.resize(maxOrder + 1);
+		block->freeOffsets[maxOrder].insert(0);
+		blocks.push_back(block);
+		return block;
+	}
+
+	/***********************************************
+	 *	функция:			AllocateFromBlock()
+	 *	назначение:			взять участок порядка order, деля
+	 *						старшие участки пополам
+	 *	входящие значения:	block - блок
+	 *						order - порядок участка
+	 *						allocation - результат
+	 *	выходящие значения:	false - в блоке нет места
+	 **********************************************/
+	bool MemoryAllocator::AllocateFromBlock(MemoryBlock* block, uint32_t order, Allocation& allocation)
+	{
+		uint32_t current = order;
+		while (current < block->freeOffsets.size() && block->freeOffsets[current].empty())
+			current++;
+		if (current >= block->freeOffsets.size())
+			return false;
+
+		const VkDeviceSize offset = *block->freeOffsets[current].begin();
+		block->freeOffsets[current].erase(block->freeOffsets[current].begin());
+		//вторые половины остаются свободными
+		while (current > order)
+		{
+			current--;
+			block->freeOffsets[current].insert(offset + (MIN_SIZE << current));
+		}
+
+		allocation.memory = block->memory;
+		allocation.offset = offset;
+		allocation.size = MIN_SIZE << order;
+		allocation.mapped = block->mapped ? block->mapped + offset : nullptr;
+		allocation.block = block;
+		block->used += allocation.size;
+		return true;
+	}
+
+	/***********************************************
+	 *	функция:			Free()
+	 *	назначение:			вернуть участок, сливая его со свободным
+	 *						близнецом
+	 *	входящие значения:	allocation - участок (обнуляется)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MemoryAllocator::Free(Allocation& allocation)
+	{
+		if (allocation.memory == VK_NULL_HANDLE)
+			return;
+
+		std::lock_guard<std::mutex> lock(mutex);
+		allocationCount--;
+		MemoryBlock* block = allocation.block;
+		if (!block)
+		{
+			if (allocation.mapped)
+				vkUnmapMemory(device, allocation.memory);
+			vkFreeMemory(device, allocation.memory, nullptr);
+			dedicatedCount--;
+			allocation = {};
+			return;
+		}
+
+		uint32_t order = Order(allocation.size);
+		VkDeviceSize offset = allocation.offset;
+		block->used -= allocation.size;
+		while (order + 1 < block->freeOffsets.size() && block->freeOffsets[order].erase(offset ^ (MIN_SIZE << order)))
+		{
+			offset &= ~(MIN_SIZE << order);
+			order++;
+		}
+		block->freeOffsets[order].insert(offset);
+		allocation = {};
+
+		//один пустой блок вида остается для следующих выделений
+		if (block->used == 0)
+		{
+			for (MemoryBlock* other : blocks)
+			{
+				if (other != block && other->memoryType == block->memoryType && other->linear == block->linear)
+				{
+					DestroyBlock(block);
+					break;
+				}
+			}
+		}
+	}
+
+	void MemoryAllocator::DestroyBlock(MemoryBlock* block)
+	{
+		if (block->mapped)
+			vkUnmapMemory(device, block->memory);
+		vkFreeMemory(device, block->memory, nullptr);
+		blocks.erase(std::find(blocks.begin(), blocks.end(), block));
+		delete block;
+	}
+
+	/***********************************************
+	 *	функция:			GetStatistics()
+	 *	назначение:			счетчики блоков и участков
+	 *	входящие значения:	нет
+	 *	выходящие значения:	статистика
+	 **********************************************/
+	MemoryAllocator::Statistics MemoryAllocator::GetStatistics()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		Statistics statistics;
+		statistics.blockCount = static_cast<uint32_t>(blocks.size());
+		statistics.dedicatedCount = dedicatedCount;
+		statistics.allocationCount = allocationCount;
+		for (const MemoryBlock* block : blocks)
+		{
+			statistics.blockBytes += block->size;
+			statistics.usedBytes += block->used;
+		}
+		return statistics;
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить все блоки (до уничтожения
+	 *						логического устройства)
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MemoryAllocator::Destroy()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		while (!blocks.empty())
+			DestroyBlock(blocks.back());
+		device = VK_NULL_HANDLE;
+	}
+}
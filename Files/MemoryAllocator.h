@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+namespace vks
+{
+	struct MemoryBlock;
+
+	/*************************************************************************
+	 * участок памяти устройства, выданный MemoryAllocator
+	 *
+	***********************************************************************/
+	struct Allocation
+	{
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		//смещение участка в memory, с ним связываются буфер или изображение
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		//постоянное отображение участка (память HOST_VISIBLE) или nullptr
+		void* mapped = nullptr;
+		//блок-владелец, nullptr - отдельное выделение
+		MemoryBlock* block = nullptr;
+	};
+
+	/*************************************************************************
+	 * блок памяти одного типа, делится методом близнецов
+	 *
+	 * Участок порядка k имеет размер MIN_SIZE << k и смещение, кратное
+	 * своему размеру, поэтому любое выравнивание до размера участка
+	 * выполняется само. Свободные смещения хранятся по порядкам.
+	 *
+	***********************************************************************/
+	struct MemoryBlock
+	{
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		uint32_t memoryType = 0;
+		//буферы и линейные изображения отдельно от оптимальных (bufferImageGranularity)
+		bool linear = true;
+		VkDeviceSize size = 0;
+		VkDeviceSize used = 0;
+		uint8_t* mapped = nullptr;
+		std::vector<std::set<VkDeviceSize>> freeOffsets;
+	};
+
+	/*************************************************************************
+	 * распределитель памяти устройства
+	 *
+	 * Вместо vkAllocateMemory на каждый ресурс память берется блоками по
+	 * BLOCK_SIZE (меньше на маленьких кучах) на тип памяти и делится
+	 * методом близнецов. Буферы и линейные изображения не делят блоки с
+	 * оптимальными изображениями, поэтому bufferImageGranularity не
+	 * нарушается. Участки больше половины блока и буферы с адресом
+	 * устройства выделяются отдельно. Память HOST_VISIBLE отображается
+	 * один раз на блок, Allocation::mapped указывает на участок.
+	 * Пустой блок освобождается, если есть другой блок того же вида.
+	 *
+	***********************************************************************/
+	class MemoryAllocator
+	{
+	public:
+		static constexpr VkDeviceSize BLOCK_SIZE = 64ull * 1024 * 1024;
+		static constexpr VkDeviceSize MIN_SIZE = 256;
+
+		struct Statistics
+		{
+			uint32_t blockCount = 0;
+			uint32_t dedicatedCount = 0;
+			uint32_t allocationCount = 0;
+			VkDeviceSize blockBytes = 0;
+			VkDeviceSize usedBytes = 0;
+		};
+
+		~MemoryAllocator();
+
+		void Init(VkDevice device, const VkPhysicalDeviceProperties& properties, const VkPhysicalDeviceMemoryProperties& memoryProperties);
+		VkResult Allocate(const VkMemoryRequirements& requirements, VkMemoryPropertyFlags properties, bool linear, Allocation& allocation, bool deviceAddress = false);
+		VkResult AllocateBuffer(VkBuffer buffer, VkMemoryPropertyFlags properties, Allocation& allocation, bool deviceAddress = false);
+		VkResult AllocateImage(VkImage image, VkMemoryPropertyFlags properties, Allocation& allocation, bool linear = false);
+		void Free(Allocation& allocation);
+		Statistics GetStatistics();
+		void Destroy();
+
+	private:
+		VkDevice device = VK_NULL_HANDLE;
+		VkPhysicalDeviceMemoryProperties memoryProperties{};
+		VkDeviceSize nonCoherentAtomSize = 1;
+		std::vector<MemoryBlock*> blocks;
+		uint32_t dedicatedCount = 0;
+		uint32_t allocationCount = 0;
+		std::mutex mutex;
+
+		uint32_t FindMemoryType(uint32_t typeBits, VkMemoryPropertyFlags properties) const;
+		VkDeviceSize BlockSize(uint32_t memoryType) const;
+		MemoryBlock* CreateBlock(uint32_t memoryType, bool linear);
+		bool AllocateFromBlock(MemoryBlock* block, uint32_t order, Allocation& allocation);
+		void DestroyBlock(MemoryBlock* block);
+	};
+}
@@ -0,0 +1,339 @@
+#include "MorphBlender.h"
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			создать буфер вершин экземпляра
+	 *	входящие значения:	model - модель с целями морфинга
+	 *						copyQueue - очередь для копирования
+	 *						computeBlend - считать вершины шейдером
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::Init(Model* model, VkQueue copyQueue, bool computeBlend)
+	{
+		this->model = model;
+		this->device = model->device;
+		this->computeBlend = computeBlend;
+
+		meshes.clear();
+		weightOffsets.clear();
+		uint32_t weightCount = 0;
+		for (Node* node : model->linearNodes)
+		{
+			Mesh* mesh = node->mesh;
+			if (!mesh || mesh->morphTargets.empty() || (find(meshes.begin(), meshes.end(), mesh) != meshes.end()))
+				continue;
+
+			meshes.push_back(mesh);
+			weightOffsets.push_back(weightCount);
+			weightCount += static_cast<uint32_t>(mesh->morphTargets.size());
+		}
+
+		//процессор пишет свою область на каждый кадр в полете, шейдер - одну область буфера устройства
+		frameCount = std::max(model->framesInFlight, 1u);
+		frame = 0;
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(device->properties.limits.minStorageBufferOffsetAlignment, 16);
+		const uint32_t vertexFrames = computeBlend ? 1 : frameCount;
+
+		//буфер экземпляра в начале совпадает с вершинами модели
+		const VkDeviceSize vertexBufferSize = static_cast<VkDeviceSize>(model->vertices.count) * sizeof(Vertex);
+		vertexFrameSize = (vertexBufferSize + alignment - 1) & ~(alignment - 1);
+		const VkMemoryPropertyFlags memoryFlags = computeBlend ? VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT : VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			memoryFlags,
+			&vertexBuffer,
+			vertexFrameSize * vertexFrames));
+
+		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		std::vector<VkBufferCopy> copyRegions(vertexFrames);
+		for (uint32_t i = 0; i < vertexFrames; i++)
+		{
+			copyRegions[i].dstOffset = i * vertexFrameSize;
+			copyRegions[i].size = vertexBufferSize;
+		}
+		vkCmdCopyBuffer(copyCmd, model->vertices.buffer, vertexBuffer.buffer, vertexFrames, copyRegions.data());
+		device->flushCommandBuffer(copyCmd, copyQueue, true);
+
+		if (computeBlend)
+		{
+			weightFrameSize = (std::max(weightCount, 1u) * sizeof(float) + alignment - 1) & ~(alignment - 1);
+			VK_CHECK_RESULT(device->createBuffer(
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				&weightBuffer,
+				weightFrameSize * frameCount));
+			VK_CHECK_RESULT(weightBuffer.map());
+			//набор описывает одну область, смещение кадра задается при связывании
+			weightBuffer.setupDescriptor(weightFrameSize);
+
+			PrepareRows(copyQueue);
+		}
+		else
+			VK_CHECK_RESULT(vertexBuffer.map());
+	}
+
+	/***********************************************
+	 *	функция:			PrepareRows()
+	 *	назначение:			перестроить смещения из порядка по целям
+	 *						в порядок по вершинам (CSR) и загрузить
+	 *						их в память устройства
+	 *	входящие значения:	copyQueue - очередь для копирования
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::PrepareRows(VkQueue copyQueue)
+	{
+		vector<MorphRow> rows;
+		vector<MorphDelta> deltas;
+
+		for (size_t m = 0; m < meshes.size(); m++)
+		{
+			const Mesh* mesh = meshes[m];
+
+			vector<vector<MorphDelta>> rowDeltas(mesh->morphVertices.size());
+			for (size_t t = 0; t < mesh->morphTargets.size(); t++)
+			{
+				const MorphTarget& target = mesh->morphTargets[t];
+				for (size_t i = 0; i < target.vertices.size(); i++)
+				{
+					MorphDelta delta{};
+					delta.position = target.positions[i];
+					delta.weight = weightOffsets[m] + static_cast<uint32_t>(t);
+					delta.normal = target.normals[i];
+					rowDeltas[target.vertices[i]].push_back(delta);
+				}
+			}
+
+			for (size_t r = 0; r < mesh->morphVertices.size(); r++)
+			{
+				MorphRow row{};
+				row.position = mesh->morphBasePositions[r];
+				row.vertex = mesh->morphVertices[r];
+				row.normal = mesh->morphBaseNormals[r];
+				row.first = static_cast<uint32_t>(deltas.size());
+				row.count = static_cast<uint32_t>(rowDeltas[r].size());
+				rows.push_back(row);
+				deltas.insert(deltas.end(), rowDeltas[r].begin(), rowDeltas[r].end());
+			}
+		}
+
+		pushConstBlock.rowCount = static_cast<uint32_t>(rows.size());
+		pushConstBlock.vertexStride = sizeof(Vertex) / sizeof(float);
+
+		//пустые буферы не создаются, оставляем по одному элементу
+		rows.resize(std::max<size_t>(rows.size(), 1));
+		deltas.resize(std::max<size_t>(deltas.size(), 1));
+
+		struct Upload
+		{
+			Buffer* buffer;
+			VkDeviceSize size;
+			void* data;
+		};
+		Upload uploads[2] = {
+			{ &rowBuffer, rows.size() * sizeof(MorphRow), rows.data() },
+			{ &deltaBuffer, deltas.size() * sizeof(MorphDelta), deltas.data() },
+		};
+		for (auto& upload : uploads)
+		{
+			Buffer staging;
+			VK_CHECK_RESULT(device->createBuffer(
+				VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+				&staging,
+				upload.size,
+				upload.data));
+			VK_CHECK_RESULT(device->createBuffer(
+				VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+				VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+				upload.buffer,
+				upload.size));
+			device->copyBuffer(&staging, upload.buffer, copyQueue);
+			staging.destroy();
+		}
+	}
+
+	/***********************************************
+	 *	функция:			PreparePipeline()
+	 *	назначение:			создать вычислительный конвейер морфинга
+	 *	входящие значения:	pipelineCache - кэш конвейеров
+	 *						shader - шейдер morph.comp
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::PreparePipeline(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& shader)
+	{
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3),
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = initializers::descriptorPoolCreateInfo(poolSizes, 1);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolInfo, nullptr, &descriptorPool));
+
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_COMPUTE_BIT, 2),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 3),
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayout = initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayout, nullptr, &descriptorSetLayout));
+
+		VkDescriptorSetAllocateInfo allocInfo = initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &rowBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &deltaBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 2, &weightBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &vertexBuffer.descriptor),
+		};
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+		VkPushConstantRange pushConstantRange = initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstBlock), 0);
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		VK_CHECK_RESULT(vkCreatePipelineLayout(device->logicalDevice, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
+
+		VkComputePipelineCreateInfo computePipelineCreateInfo = initializers::computePipelineCreateInfo(pipelineLayout);
+		computePipelineCreateInfo.stage = shader;
+		VK_CHECK_RESULT(vkCreateComputePipelines(device->logicalDevice, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &pipeline));
+	}
+
+	/***********************************************
+	 *	функция:			Blend()
+	 *	назначение:			смешать цели морфинга на процессоре
+	 *						и записать вершины в область кадра буфера
+	 *						экземпляра (после BeginFrame)
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::Blend()
+	{
+		if (!vertexBuffer.mapped)
+			return;
+		Vertex* vertices = reinterpret_cast<Vertex*>(static_cast<uint8_t*>(vertexBuffer.mapped) + VertexOffset());
+
+		for (Mesh* mesh : meshes)
+		{
+			positions = mesh->morphBasePositions;
+			normals = mesh->morphBaseNormals;
+
+			//цели с нулевым весом не просматриваются
+			for (size_t t = 0; t < mesh->morphTargets.size(); t++)
+			{
+				const float weight = mesh->weights[t];
+				if (weight == 0.0f)
+					continue;
+
+				const MorphTarget& target = mesh->morphTargets[t];
+				const uint32_t* rows = target.vertices.data();
+				const vec3* positionDeltas = target.positions.data();
+				const vec3* normalDeltas = target.normals.data();
+				for (size_t i = 0; i < target.vertices.size(); i++)
+				{
+					positions[rows[i]] += weight * positionDeltas[i];
+					normals[rows[i]] += weight * normalDeltas[i];
+				}
+			}
+
+			for (size_t r = 0; r < mesh->morphVertices.size(); r++)
+			{
+				Vertex& vertex = vertices[mesh->morphVertices[r]];
+				vertex.pos = positions[r];
+				const float length = glm::length(normals[r]);
+				vertex.normal = length > 0.0f ? normals[r] / length : normals[r];
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			UploadWeights()
+	 *	назначение:			скопировать веса граней в область кадра
+	 *						буфера весов
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::UploadWeights()
+	{
+		float* weights = reinterpret_cast<float*>(static_cast<uint8_t*>(weightBuffer.mapped) + frame * weightFrameSize);
+		for (size_t m = 0; m < meshes.size(); m++)
+			copy(meshes[m]->weights.begin(), meshes[m]->weights.end(), weights + weightOffsets[m]);
+	}
+
+	/***********************************************
+	 *	функция:			Dispatch()
+	 *	назначение:			записать вычисление морфинга в командный
+	 *						буфер (вне прохода рендера, после BeginFrame)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::Dispatch(VkCommandBuffer commandBuffer)
+	{
+		if (!computeBlend || (pushConstBlock.rowCount == 0))
+			return;
+
+		UploadWeights();
+
+		//предыдущий кадр читал буфер экземпляра как вершины
+		VkBufferMemoryBarrier barrier = initializers::bufferMemoryBarrier();
+		barrier.srcAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+		barrier.dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barrier.buffer = vertexBuffer.buffer;
+		barrier.offset = 0;
+		barrier.size = VK_WHOLE_SIZE;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+		const uint32_t weightOffset = static_cast<uint32_t>(frame * weightFrameSize);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 1, &weightOffset);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
+		vkCmdDispatch(commandBuffer, (pushConstBlock.rowCount + 63) / 64, 1, 1);
+
+		barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, &barrier, 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			BindBuffers()
+	 *	назначение:			связать буфер вершин экземпляра (область
+	 *						текущего кадра) и индексы модели
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::BindBuffers(VkCommandBuffer commandBuffer)
+	{
+		model->BindBuffers(commandBuffer, vertexBuffer.buffer, VertexOffset());
+	}
+
+	void MorphBlender::BindBuffers(vks::CommandRecorder& recorder)
+	{
+		model->BindBuffers(recorder, vertexBuffer.buffer, VertexOffset());
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить ресурсы Vulkan
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void MorphBlender::Destroy()
+	{
+		vertexBuffer.destroy();
+		rowBuffer.destroy();
+		deltaBuffer.destroy();
+		weightBuffer.destroy();
+
+		if (pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(device->logicalDevice, pipeline, nullptr);
+			vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
+			vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
+			vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
+		}
+		pipeline = VK_NULL_HANDLE;
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+#include "VulkanBuffer.h"
+#include "VulkanInitializers.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * смешивание целей морфинга модели в буфер вершин экземпляра
+	 *
+	 * Буфер экземпляра повторяет весь буфер вершин модели (индексы модели
+	 * абсолютные), изменяются только вершины из Mesh::morphVertices.
+	 * Blend() считает вершины на процессоре, Dispatch() - вычислительным
+	 * шейдером по строкам CSR (вершина -> список смещений).
+	 * Буферы, которые пишет процессор (веса для шейдера, вершины при
+	 * смешивании на процессоре), содержат область на каждый кадр в полете
+	 * (Model::framesInFlight), BeginFrame() выбирает область кадра.
+	 *
+	***********************************************************************/
+	class MorphBlender
+	{
+	public:
+		//формат строк и смещений совпадает с std430 в morph.comp
+		struct MorphRow
+		{
+			vec3 position;
+			uint32_t vertex;
+			vec3 normal;
+			uint32_t first;
+			uint32_t count;
+			uint32_t pad[3];
+		};
+
+		struct MorphDelta
+		{
+			vec3 position;
+			uint32_t weight;
+			vec3 normal;
+			float pad;
+		};
+
+		struct PushConstBlock
+		{
+			uint32_t rowCount;
+			uint32_t vertexStride;
+		} pushConstBlock;
+
+		Model* model = nullptr;
+		VulkanDevice* device = nullptr;
+		bool computeBlend = false;
+
+		Buffer vertexBuffer;
+		Buffer rowBuffer;
+		Buffer deltaBuffer;
+		Buffer weightBuffer;
+		VkDeviceSize vertexFrameSize = 0;
+		VkDeviceSize weightFrameSize = 0;
+		uint32_t frameCount = 1;
+		uint32_t frame = 0;
+
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+
+		void Init(Model* model, VkQueue copyQueue, bool computeBlend);
+		void PreparePipeline(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& shader);
+		void BeginFrame(uint32_t frameIndex) { frame = frameIndex % frameCount; }
+		VkDeviceSize VertexOffset() const { return computeBlend ? 0 : frame * vertexFrameSize; }
+		void Blend();
+		void Dispatch(VkCommandBuffer commandBuffer);
+		void BindBuffers(VkCommandBuffer commandBuffer);
+		void BindBuffers(vks::CommandRecorder& recorder);
+		void Destroy();
+
+	private:
+		vector<Mesh*> meshes;
+		vector<uint32_t> weightOffsets;
+		vector<vec3> positions;
+		vector<vec3> normals;
+
+		void PrepareRows(VkQueue copyQueue);
+		void UploadWeights();
+	};
+}
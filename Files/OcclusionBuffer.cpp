@@ -0,0 +1,492 @@
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <unordered_map>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace vks
+{
+	OcclusionBuffer::~OcclusionBuffer()
+	{
+		Destroy();
+	}
+
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			создать буфер глубины и запустить
+	 *						рабочие потоки растеризации
+	 *	входящие значения:	width, height - размер буфера (округляется
+	 *						до целого числа плиток)
+	 *						threadCount - число потоков вместе с
+	 *						вызывающим (0 - по числу ядер)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::Init(uint32_t width, uint32_t height, uint32_t threadCount)
+	{
+		Destroy();
+
+		tilesX = (std::max(width, 1u) + TILE_WIDTH - 1) / TILE_WIDTH;
+		tilesY = (std::max(height, 1u) + TILE_HEIGHT - 1) / TILE_HEIGHT;
+		this->width = tilesX * TILE_WIDTH;
+		this->height = tilesY * TILE_HEIGHT;
+
+		depth.assign(static_cast<size_t>(tilesX) * tilesY * TILE_SIZE, 1.0f);
+		tileMaxDepth.assign(static_cast<size_t>(tilesX) * tilesY, 1.0f);
+		bins.assign(static_cast<size_t>(tilesX) * tilesY, {});
+
+		if (threadCount == 0)
+			threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		running = true;
+		for (uint32_t thread = 1; thread < threadCount; thread++)
+			threads.emplace_back(&OcclusionBuffer::Run, this);
+	}
+
+	/***********************************************
+	 *	функция:			AddOccluder()
+	 *	назначение:			добавить перекрывающую сетку (упрощенную
+	 *						геометрию, целиком лежащую внутри объекта)
+	 *	входящие значения:	positions - вершины в системе координат узла
+	 *						indices - индексы треугольников
+	 *						transform - мировая матрица (читается при
+	 *						каждом Render, nullptr - единичная)
+	 *	выходящие значения:	номер перекрывающей сетки
+	 **********************************************/
+	uint32_t OcclusionBuffer::AddOccluder(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, const glm::mat4* transform)
+	{
+		//смежность по ребрам считается один раз, ребро более чем двух треугольников считается краем
+		const size_t triangleCount = indices.size() / 3;
+		std::vector<uint32_t> adjacency(triangleCount * 3, ~0u);
+		std::unordered_map<uint64_t, uint32_t> edges;
+		for (size_t i = 0; i < triangleCount * 3; i++)
+		{
+			const size_t first = i - i % 3;
+			const uint32_t a = indices[first + (i + 1) % 3];
+			const uint32_t b = indices[first + (i + 2) % 3];
+			const uint64_t key = static_cast<uint64_t>(std::min(a, b)) << 32 | std::max(a, b);
+			auto edge = edges.emplace(key, static_cast<uint32_t>(i));
+			uint32_t& other = edge.first->second;
+			if (edge.second || other == ~0u)
+				continue;
+			if (adjacency[other] == ~0u)
+			{
+				adjacency[other] = static_cast<uint32_t>(i);
+				adjacency[i] = other;
+			}
+			else
+			{
+				adjacency[adjacency[other]] = ~0u;
+				adjacency[other] = ~0u;
+				other = ~0u;
+			}
+		}
+
+		occluders.push_back({ positions, indices, std::move(adjacency), transform });
+		return static_cast<uint32_t>(occluders.size() - 1);
+	}
+
+	/***********************************************
+	 *	функция:			MakeEdge()
+	 *	назначение:			уравнение прямой через две точки,
+	 *						положительное со стороны третьей
+	 *	входящие значения:	a, b - точки прямой
+	 *						inside - точка внутренней стороны
+	 *						shrink - сузить на полпикселя (пиксель
+	 *						проходит, только если лежит внутри целиком)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	static void MakeEdge(const glm::vec4& a, const glm::vec4& b, const glm::vec4& inside, bool shrink, float& edgeA, float& edgeB, float& edgeC)
+	{
+		edgeA = a.y - b.y;
+		edgeB = b.x - a.x;
+		edgeC = a.x * b.y - a.y * b.x;
+		if (edgeA * inside.x + edgeB * inside.y + edgeC < 0.0f)
+		{
+			edgeA = -edgeA;
+			edgeB = -edgeB;
+			edgeC = -edgeC;
+		}
+		if (shrink)
+			edgeC -= 0.5f * (std::fabs(edgeA) + std::fabs(edgeB));
+	}
+
+	void OcclusionBuffer::ClearOccluders()
+	{
+		occluders.clear();
+	}
+
+	/***********************************************
+	 *	функция:			Render()
+	 *	назначение:			растеризовать перекрывающие сетки кадра
+	 *	входящие значения:	viewProjection - матрица проекции и вида
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::Render(const glm::mat4& viewProjection)
+	{
+		this->viewProjection = viewProjection;
+		SetupTriangles();
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			nextTile = 0;
+			generation++;
+			remaining = static_cast<uint32_t>(threads.size());
+		}
+		condition.notify_all();
+
+		RasterizeTiles();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this] { return remaining == 0; });
+	}
+
+	/***********************************************
+	 *	функция:			SetupTriangles()
+	 *	назначение:			перевести треугольники в пиксели, посчитать
+	 *						уравнения ребер и разложить по плиткам
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::SetupTriangles()
+	{
+		triangles.clear();
+		for (std::vector<uint32_t>& bin : bins)
+			bin.clear();
+
+		const float halfWidth = 0.5f * width;
+		const float halfHeight = 0.5f * height;
+		for (const Occluder& occluder : occluders)
+		{
+			const glm::mat4 matrix = occluder.transform ? viewProjection * *occluder.transform : viewProjection;
+			screenVertices.resize(occluder.positions.size());
+			for (size_t i = 0; i < occluder.positions.size(); i++)
+			{
+				const glm::vec4 clip = matrix * glm::vec4(occluder.positions[i], 1.0f);
+				//w <= 0 помечается, треугольники с такой вершиной пропускаются
+				if (clip.w <= 1e-5f)
+				{
+					screenVertices[i] = glm::vec4(0.0f, 0.0f, 0.0f, -1.0f);
+					continue;
+				}
+				const float invW = 1.0f / clip.w;
+				screenVertices[i] = glm::vec4((clip.x * invW + 1.0f) * halfWidth, (clip.y * invW + 1.0f) * halfHeight, clip.z * invW, 1.0f);
+			}
+
+			//вершины треугольника и плоскость глубины, false - треугольник не растеризуется
+			auto setupCorners = [&](size_t triangle, glm::vec4* corners, float& depthA, float& depthB, float& depthC)
+			{
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					corners[k] = screenVertices[occluder.indices[triangle * 3 + k]];
+					//обрезка по ближней плоскости не делается: пропуск треугольника только ослабляет отсечение
+					if (corners[k].w < 0.0f)
+						return false;
+				}
+				const glm::vec4 d1(corners[1].x - corners[0].x, corners[1].y - corners[0].y, corners[1].z - corners[0].z, 0.0f);
+				const glm::vec4 d2(corners[2].x - corners[0].x, corners[2].y - corners[0].y, corners[2].z - corners[0].z, 0.0f);
+				const float area = d1.x * d2.y - d1.y * d2.x;
+				//отрицательное условие отбрасывает и NaN
+				if (!(std::fabs(area) >= 1e-6f))
+					return false;
+				//глубина линейна в экранных координатах
+				depthA = (d1.z * d2.y - d2.z * d1.y) / area;
+				depthB = (d2.z * d1.x - d1.z * d2.x) / area;
+				depthC = corners[0].z - depthA * corners[0].x - depthB * corners[0].y;
+				return true;
+			};
+
+			for (size_t i = 0; i + 2 < occluder.indices.size(); i += 3)
+			{
+				glm::vec4 v[3];
+				Triangle triangle{};
+				if (!setupCorners(i / 3, v, triangle.depthA, triangle.depthB, triangle.depthC))
+					continue;
+
+				const float minX = std::min(v[0].x, std::min(v[1].x, v[2].x));
+				const float maxX = std::max(v[0].x, std::max(v[1].x, v[2].x));
+				const float minY = std::min(v[0].y, std::min(v[1].y, v[2].y));
+				const float maxY = std::max(v[0].y, std::max(v[1].y, v[2].y));
+				if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+					continue;
+
+				//уравнения считаются в центре пикселя. Ребро напротив вершины k сужается
+				//на полпикселя, если за ним нет соседа по другую сторону на экране;
+				//иначе центр проверяется без сужения, а весь пиксель - по внешним
+				//ребрам соседа, и пиксель целиком лежит в треугольнике или соседях
+				float depthBias = 0.0f;
+				for (uint32_t k = 0; k < 3; k++)
+				{
+					const glm::vec4& a = v[(k + 1) % 3];
+					const glm::vec4& b = v[(k + 2) % 3];
+					const uint32_t adjacent = occluder.adjacency[i + k];
+					glm::vec4 n[3];
+					float neighbourA = 0.0f, neighbourB = 0.0f, neighbourC = 0.0f;
+					const bool neighbour = adjacent != ~0u && setupCorners(adjacent / 3, n, neighbourA, neighbourB, neighbourC);
+
+					uint32_t& count = triangle.edgeCount;
+					MakeEdge(a, b, v[k], false, triangle.edgeA[count], triangle.edgeB[count], triangle.edgeC[count]);
+					//вершина соседа напротив общего ребра
+					const glm::vec4& opposite = n[neighbour ? adjacent % 3 : 0];
+					if (!neighbour || triangle.edgeA[count] * opposite.x + triangle.edgeB[count] * opposite.y + triangle.edgeC[count] >= 0.0f)
+					{
+						triangle.edgeC[count] -= 0.5f * (std::fabs(triangle.edgeA[count]) + std::fabs(triangle.edgeB[count]));
+						count++;
+						continue;
+					}
+					count++;
+					MakeEdge(a, opposite, b, true, triangle.edgeA[count], triangle.edgeB[count], triangle.edgeC[count]);
+					count++;
+					MakeEdge(opposite, b, a, true, triangle.edgeA[count], triangle.edgeB[count], triangle.edgeC[count]);
+					count++;
+					//часть пикселя у соседа дальше плоскости треугольника не более чем на полпикселя разности наклонов
+					depthBias = std::max(depthBias, 0.5f * (std::fabs(neighbourA - triangle.depthA) + std::fabs(neighbourB - triangle.depthB)));
+				}
+				//наибольшая глубина плоскости в пределах пикселя
+				triangle.depthC += 0.5f * (std::fabs(triangle.depthA) + std::fabs(triangle.depthB)) + depthBias;
+
+				const uint32_t index = static_cast<uint32_t>(triangles.size());
+				triangles.push_back(triangle);
+
+				//границы ограничиваются до приведения, иначе далекая вершина дает переполнение
+				const uint32_t firstX = static_cast<uint32_t>(std::max(minX, 0.0f)) / TILE_WIDTH;
+				const uint32_t firstY = static_cast<uint32_t>(std::max(minY, 0.0f)) / TILE_HEIGHT;
+				const uint32_t lastX = static_cast<uint32_t>(std::min(maxX, static_cast<float>(width - 1))) / TILE_WIDTH;
+				const uint32_t lastY = static_cast<uint32_t>(std::min(maxY, static_cast<float>(height - 1))) / TILE_HEIGHT;
+				for (uint32_t y = firstY; y <= lastY; y++)
+				{
+					for (uint32_t x = firstX; x <= lastX; x++)
+						bins[y * tilesX + x].push_back(index);
+				}
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			RasterizeTiles()
+	 *	назначение:			разбирать плитки, пока они не кончатся
+	 *						(вызывается всеми потоками)
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::RasterizeTiles()
+	{
+		const uint32_t tileCount = tilesX * tilesY;
+		for (uint32_t tile = nextTile++; tile < tileCount; tile = nextTile++)
+			RasterizeTile(tile);
+	}
+
+	/***********************************************
+	 *	функция:			RasterizeTile()
+	 *	назначение:			растеризовать треугольники одной плитки
+	 *						(при __AVX2__ строка считается по 8 пикселей,
+	 *						иначе скалярным циклом без ветвлений)
+	 *	входящие значения:	tile - номер плитки
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::RasterizeTile(uint32_t tile)
+	{
+		float* tileDepth = &depth[static_cast<size_t>(tile) * TILE_SIZE];
+		for (uint32_t i = 0; i < TILE_SIZE; i++)
+			tileDepth[i] = 1.0f;
+
+		const float originX = static_cast<float>(tile % tilesX * TILE_WIDTH) + 0.5f;
+		const float originY = static_cast<float>(tile / tilesX * TILE_HEIGHT) + 0.5f;
+		float columns[TILE_WIDTH];
+		for (uint32_t x = 0; x < TILE_WIDTH; x++)
+			columns[x] = originX + x;
+
+		for (uint32_t index : bins[tile])
+		{
+			const Triangle& triangle = triangles[index];
+			for (uint32_t y = 0; y < TILE_HEIGHT; y++)
+			{
+				const float py = originY + y;
+				float rowC[MAX_EDGES];
+				for (uint32_t k = 0; k < triangle.edgeCount; k++)
+					rowC[k] = triangle.edgeB[k] * py + triangle.edgeC[k];
+				const float cz = triangle.depthB * py + triangle.depthC;
+				float* row = tileDepth + y * TILE_WIDTH;
+#if defined(__AVX2__)
+				const __m256 zero = _mm256_setzero_ps();
+				const __m256 az = _mm256_set1_ps(triangle.depthA);
+				const __m256 bz = _mm256_set1_ps(cz);
+				for (uint32_t x = 0; x < TILE_WIDTH; x += 8)
+				{
+					const __m256 px = _mm256_loadu_ps(columns + x);
+					const __m256 old = _mm256_loadu_ps(row + x);
+					const __m256 z = _mm256_add_ps(_mm256_mul_ps(az, px), bz);
+					__m256 covered = _mm256_cmp_ps(z, old, _CMP_LT_OQ);
+					for (uint32_t k = 0; k < triangle.edgeCount; k++)
+					{
+						const __m256 e = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(triangle.edgeA[k]), px), _mm256_set1_ps(rowC[k]));
+						covered = _mm256_and_ps(covered, _mm256_cmp_ps(e, zero, _CMP_GE_OQ));
+					}
+					_mm256_storeu_ps(row + x, _mm256_blendv_ps(old, z, covered));
+				}
+#else
+				for (uint32_t x = 0; x < TILE_WIDTH; x++)
+				{
+					const float px = columns[x];
+					const float z = triangle.depthA * px + cz;
+					bool covered = z < row[x];
+					for (uint32_t k = 0; k < triangle.edgeCount; k++)
+						covered &= triangle.edgeA[k] * px + rowC[k] >= 0.0f;
+					row[x] = covered ? z : row[x];
+				}
+#endif
+			}
+		}
+
+		float maxDepth = 0.0f;
+		for (uint32_t i = 0; i < TILE_SIZE; i++)
+			maxDepth = tileDepth[i] > maxDepth ? tileDepth[i] : maxDepth;
+		tileMaxDepth[tile] = maxDepth;
+	}
+
+	/***********************************************
+	 *	функция:			Run()
+	 *	назначение:			цикл рабочего потока
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::Run()
+	{
+		uint64_t rendered = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [&] { return !running || generation != rendered; });
+				if (!running)
+					return;
+				rendered = generation;
+			}
+
+			RasterizeTiles();
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--remaining == 0)
+				finished.notify_one();
+		}
+	}
+
+	/***********************************************
+	 *	функция:			TestBox()
+	 *	назначение:			проверить, видна ли коробка за
+	 *						перекрывающими сетками
+	 *	входящие значения:	min, max - мировые границы
+	 *	выходящие значения:	false - коробка полностью перекрыта
+	 **********************************************/
+	bool OcclusionBuffer::TestBox(glm::vec3 min, glm::vec3 max) const
+	{
+		if (depth.empty())
+			return true;
+
+		float minX = static_cast<float>(width), maxX = 0.0f;
+		float minY = static_cast<float>(height), maxY = 0.0f;
+		float minZ = 1.0f;
+		for (uint32_t corner = 0; corner < 8; corner++)
+		{
+			const glm::vec4 position((corner & 1) ? max.x : min.x, (corner & 2) ? max.y : min.y, (corner & 4) ? max.z : min.z, 1.0f);
+			const glm::vec4 clip = viewProjection * position;
+			//коробка пересекает ближнюю плоскость
+			if (clip.w <= 1e-5f)
+				return true;
+			const float invW = 1.0f / clip.w;
+			const float x = (clip.x * invW + 1.0f) * 0.5f * width;
+			const float y = (clip.y * invW + 1.0f) * 0.5f * height;
+			minX = std::min(minX, x);
+			maxX = std::max(maxX, x);
+			minY = std::min(minY, y);
+			maxY = std::max(maxY, y);
+			minZ = std::min(minZ, clip.z * invW);
+		}
+		//вне экрана решает отсечение по пирамиде видимости
+		if (maxX < 0.0f || maxY < 0.0f || minX >= width || minY >= height)
+			return true;
+
+		const uint32_t firstX = static_cast<uint32_t>(std::max(minX, 0.0f));
+		const uint32_t firstY = static_cast<uint32_t>(std::max(minY, 0.0f));
+		const uint32_t lastX = static_cast<uint32_t>(std::min(maxX, static_cast<float>(width - 1)));
+		const uint32_t lastY = static_cast<uint32_t>(std::min(maxY, static_cast<float>(height - 1)));
+		for (uint32_t tileY = firstY / TILE_HEIGHT; tileY <= lastY / TILE_HEIGHT; tileY++)
+		{
+			for (uint32_t tileX = firstX / TILE_WIDTH; tileX <= lastX / TILE_WIDTH; tileX++)
+			{
+				//вся плитка ближе коробки
+				const uint32_t tile = tileY * tilesX + tileX;
+				if (minZ >= tileMaxDepth[tile])
+					continue;
+
+				const uint32_t x0 = std::max(firstX, tileX * TILE_WIDTH) - tileX * TILE_WIDTH;
+				const uint32_t x1 = std::min(lastX, tileX * TILE_WIDTH + TILE_WIDTH - 1) - tileX * TILE_WIDTH;
+				const uint32_t y0 = std::max(firstY, tileY * TILE_HEIGHT) - tileY * TILE_HEIGHT;
+				const uint32_t y1 = std::min(lastY, tileY * TILE_HEIGHT + TILE_HEIGHT - 1) - tileY * TILE_HEIGHT;
+				const float* tileDepth = &depth[static_cast<size_t>(tile) * TILE_SIZE];
+				for (uint32_t y = y0; y <= y1; y++)
+				{
+					for (uint32_t x = x0; x <= x1; x++)
+					{
+						if (minZ < tileDepth[y * TILE_WIDTH + x])
+							return true;
+					}
+				}
+			}
+		}
+		return false;
+	}
+
+	/***********************************************
+	 *	функция:			TestBoxes()
+	 *	назначение:			снять видимость с перекрытых коробок
+	 *						(обычно после Frustum::CheckBoxes)
+	 *	входящие значения:	boxes - коробки в формате SoA
+	 *						visible - видимость, boxes.count элементов
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::TestBoxes(const BoxArray& boxes, uint8_t* visible) const
+	{
+		for (size_t i = 0; i < boxes.count; i++)
+		{
+			if (visible[i] && !TestBox(glm::vec3(boxes.minX[i], boxes.minY[i], boxes.minZ[i]), glm::vec3(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i])))
+				visible[i] = 0;
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Depth()
+	 *	назначение:			глубина пикселя (для отладки)
+	 *	входящие значения:	x, y - пиксель
+	 *	выходящие значения:	глубина
+	 **********************************************/
+	float OcclusionBuffer::Depth(uint32_t x, uint32_t y) const
+	{
+		const uint32_t tile = (y / TILE_HEIGHT) * tilesX + x / TILE_WIDTH;
+		return depth[static_cast<size_t>(tile) * TILE_SIZE + (y % TILE_HEIGHT) * TILE_WIDTH + x % TILE_WIDTH];
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			остановить потоки и освободить буферы
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionBuffer::Destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+		condition.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+		threads.clear();
+
+		depth.clear();
+		tileMaxDepth.clear();
+		bins.clear();
+		triangles.clear();
+	}
+}
@@ -0,0 +1,100 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <glm/glm.hpp>
+
+#include "Frustum.h"
+
+namespace vks
+{
+	/*************************************************************************
+	 * программное отсечение перекрытых объектов на процессоре
+	 *
+	 * Несколько выбранных перекрывающих сеток (упрощенные стены, здания)
+	 * растеризуются в буфер глубины низкого разрешения. Буфер разбит на
+	 * плитки TILE_WIDTH x TILE_HEIGHT, пиксели плитки лежат подряд, плитки
+	 * растеризуются параллельно, строка плитки считается без ветвлений
+	 * (с __AVX2__ - по 8 пикселей).
+	 * Растеризация консервативна внутрь: пиксель пишется, только если
+	 * сетка покрывает его целиком, с глубиной не ближе сетки в пределах
+	 * пикселя, поэтому TestBox может читать каждый задетый пиксель.
+	 * Ребро, общее с соседним треугольником по другую сторону на экране,
+	 * не сужается (иначе по диагонали четырехугольника будет щель), вместо
+	 * этого пиксель ограничивается внешними ребрами соседа.
+	 * Для каждой плитки хранится максимальная глубина, поэтому проверка
+	 * коробки обычно решается по плиткам без чтения пикселей. Глубина
+	 * обычная (0 - ближняя плоскость), класс не зависит от Vulkan.
+	 *
+	***********************************************************************/
+	class OcclusionBuffer
+	{
+	public:
+		static constexpr uint32_t TILE_WIDTH = 32;
+		static constexpr uint32_t TILE_HEIGHT = 8;
+		static constexpr uint32_t TILE_SIZE = TILE_WIDTH * TILE_HEIGHT;
+
+		uint32_t width = 0;
+		uint32_t height = 0;
+		uint32_t tilesX = 0;
+		uint32_t tilesY = 0;
+
+		~OcclusionBuffer();
+
+		void Init(uint32_t width = 256, uint32_t height = 128, uint32_t threadCount = 0);
+		uint32_t AddOccluder(const std::vector<glm::vec3>& positions, const std::vector<uint32_t>& indices, const glm::mat4* transform = nullptr);
+		void ClearOccluders();
+		void Render(const glm::mat4& viewProjection);
+		bool TestBox(glm::vec3 min, glm::vec3 max) const;
+		void TestBoxes(const BoxArray& boxes, uint8_t* visible) const;
+		float Depth(uint32_t x, uint32_t y) const;
+		void Destroy();
+
+	private:
+		//свои ребра треугольника и по два внешних ребра у каждого из трех соседей
+		static constexpr uint32_t MAX_EDGES = 9;
+
+		//перекрывающая сетка в системе координат узла, transform - мировая матрица узла (может меняться)
+		struct Occluder
+		{
+			std::vector<glm::vec3> positions;
+			std::vector<uint32_t> indices;
+			//соседний треугольник за ребром напротив вершины k (треугольник * 3 + k), ~0u - нет
+			std::vector<uint32_t> adjacency;
+			const glm::mat4* transform;
+		};
+
+		//уравнения ребер и плоскость глубины треугольника в пикселях: a * x + b * y + c
+		struct Triangle
+		{
+			float edgeA[MAX_EDGES], edgeB[MAX_EDGES], edgeC[MAX_EDGES];
+			uint32_t edgeCount;
+			float depthA, depthB, depthC;
+		};
+
+		std::vector<Occluder> occluders;
+		std::vector<Triangle> triangles;
+		std::vector<std::vector<uint32_t>> bins;
+		std::vector<glm::vec4> screenVertices;
+		std::vector<float> depth;
+		std::vector<float> tileMaxDepth;
+		glm::mat4 viewProjection{ 1.0f };
+
+		std::vector<std::thread> threads;
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable finished;
+		std::atomic<uint32_t> nextTile{ 0 };
+		uint64_t generation = 0;
+		uint32_t remaining = 0;
+		bool running = false;
+
+		void SetupTriangles();
+		void RasterizeTiles();
+		void RasterizeTile(uint32_t tile);
+		void Run();
+	};
+}
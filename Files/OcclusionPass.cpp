@@ -0,0 +1,453 @@
+#include "OcclusionPass.h"
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			создать буферы команд, счетчиков и
+	 *						видимости прошлого кадра
+	 *	входящие значения:	model - модель с непрямой отрисовкой
+	 *	выходящие значения:	false, если не включена возможность
+	 *						drawIndirectFirstInstance
+	 **********************************************/
+	bool OcclusionPass::Init(Model* model)
+	{
+		this->model = model;
+		this->device = model->device;
+
+		if (!device->enabledFeatures.drawIndirectFirstInstance)
+			return false;
+
+		pushConstBlock.drawCount = model->indirectCommandCount;
+		for (uint32_t mode = 0; mode < 3; mode++)
+			pushConstBlock.firstCommand[mode] = model->indirectBatches[mode].firstCommand;
+
+		const uint32_t drawCount = std::max(model->indirectCommandCount, 1u);
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&visibleBuffer,
+			2 * drawCount * sizeof(VkDrawIndexedIndirectCommand)));
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&countBuffer,
+			8 * sizeof(uint32_t)));
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&visibilityBuffer,
+			drawCount * sizeof(uint32_t)));
+
+		//в первом кадре ничего не было видно: все рисуется во второй фазе
+		resetVisibility = true;
+		return true;
+	}
+
+	/***********************************************
+	 *	функция:			PreparePipelines()
+	 *	назначение:			создать конвейеры отсечения и построения
+	 *						пирамиды глубины
+	 *	входящие значения:	pipelineCache - кэш конвейеров
+	 *						cullShader - шейдер occlusion.comp
+	 *						pyramidShader - шейдер hiz.comp
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionPass::PreparePipelines(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& cullShader, const VkPipelineShaderStageCreateInfo& pyramidShader)
+	{
+		//пирамида читается только texelFetch, фильтрация не нужна
+		VkSamplerCreateInfo samplerInfo = initializers::samplerCreateInfo();
+		samplerInfo.magFilter = VK_FILTER_NEAREST;
+		samplerInfo.minFilter = VK_FILTER_NEAREST;
+		samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+		samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+		samplerInfo.maxLod = VK_LOD_CLAMP_NONE;
+		VK_CHECK_RESULT(vkCreateSampler(device->logicalDevice, &samplerInfo, nullptr, &pyramid.sampler));
+
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1),
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5),
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = initializers::descriptorPoolCreateInfo(poolSizes, 1);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolInfo, nullptr, &descriptorPool));
+
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 2),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 3),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 4),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 5),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT, 6),
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayout = initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayout, nullptr, &descriptorSetLayout));
+
+		VkDescriptorSetAllocateInfo allocInfo = initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
+
+		//кольцо граней на один кадр, смещение кадра задается при связывании; пирамида пишется в SetDepth()
+		VkDescriptorBufferInfo ringDescriptor{ model->uniformRing.buffer.buffer, 0, model->uniformRing.frameSize };
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 0, &ringDescriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1, &model->drawDataBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &model->indirectBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 3, &visibleBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 4, &countBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 5, &visibilityBuffer.descriptor),
+		};
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+		VkPushConstantRange pushConstantRange = initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstBlock), 0);
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		VK_CHECK_RESULT(vkCreatePipelineLayout(device->logicalDevice, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
+
+		VkComputePipelineCreateInfo computePipelineCreateInfo = initializers::computePipelineCreateInfo(pipelineLayout);
+		computePipelineCreateInfo.stage = cullShader;
+		VK_CHECK_RESULT(vkCreateComputePipelines(device->logicalDevice, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &pipeline));
+
+		//уровень пирамиды: источник - предыдущий уровень (или глубина), приемник - текущий
+		setLayoutBindings = {
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+		};
+		descriptorLayout = initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayout, nullptr, &pyramidDescriptorSetLayout));
+
+		pushConstantRange = initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PyramidPushConstBlock), 0);
+		pipelineLayoutCreateInfo = initializers::pipelineLayoutCreateInfo(&pyramidDescriptorSetLayout, 1);
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		VK_CHECK_RESULT(vkCreatePipelineLayout(device->logicalDevice, &pipelineLayoutCreateInfo, nullptr, &pyramidPipelineLayout));
+
+		computePipelineCreateInfo = initializers::computePipelineCreateInfo(pyramidPipelineLayout);
+		computePipelineCreateInfo.stage = pyramidShader;
+		VK_CHECK_RESULT(vkCreateComputePipelines(device->logicalDevice, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &pyramidPipeline));
+	}
+
+	/***********************************************
+	 *	функция:			SetDepth()
+	 *	назначение:			создать пирамиду глубины под буфер глубины
+	 *						(после PreparePipelines() и при каждом
+	 *						изменении размера окна)
+	 *	входящие значения:	depthImage - буфер глубины (с
+	 *						VK_IMAGE_USAGE_SAMPLED_BIT)
+	 *						depthView - вид только аспекта глубины
+	 *						(VulkanBase: settings.sampledDepth,
+	 *						VK_NULL_HANDLE - формат нельзя читать в шейдере)
+	 *						depthFormat - формат буфера глубины
+	 *						width, height - размер буфера глубины
+	 *	выходящие значения:	false - глубину нельзя читать, пирамида не
+	 *						создана и проход использовать нельзя
+	 **********************************************/
+	bool OcclusionPass::SetDepth(VkImage depthImage, VkImageView depthView, VkFormat depthFormat, uint32_t width, uint32_t height)
+	{
+		DestroyPyramid();
+		if (depthView == VK_NULL_HANDLE)
+			return false;
+
+		this->depthImage = depthImage;
+		depthAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+		if (depthFormat >= VK_FORMAT_D16_UNORM_S8_UINT)
+			depthAspect |= VK_IMAGE_ASPECT_STENCIL_BIT;
+
+		pyramid.width = width;
+		pyramid.height = height;
+		pyramid.levelCount = 1;
+		for (uint32_t size = std::max(width, height); size > 1; size >>= 1)
+			pyramid.levelCount++;
+
+		VkImageCreateInfo imageInfo = initializers::imageCreateInfo();
+		imageInfo.imageType = VK_IMAGE_TYPE_2D;
+		imageInfo.format = VK_FORMAT_R32_SFLOAT;
+		imageInfo.extent = { width, height, 1 };
+		imageInfo.mipLevels = pyramid.levelCount;
+		imageInfo.arrayLayers = 1;
+		imageInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+		imageInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+		imageInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_STORAGE_BIT;
+		imageInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageInfo, nullptr, &pyramid.image));
+
+		VK_CHECK_RESULT(device->allocator.AllocateImage(pyramid.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, pyramid.memory));
+
+		VkImageViewCreateInfo viewInfo = initializers::imageViewCreateInfo();
+		viewInfo.image = pyramid.image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = VK_FORMAT_R32_SFLOAT;
+		viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, pyramid.levelCount, 0, 1 };
+		VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewInfo, nullptr, &pyramid.view));
+
+		pyramid.levelViews.resize(pyramid.levelCount);
+		for (uint32_t level = 0; level < pyramid.levelCount; level++)
+		{
+			viewInfo.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, level, 1, 0, 1 };
+			VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewInfo, nullptr, &pyramid.levelViews[level]));
+		}
+
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, pyramid.levelCount),
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, pyramid.levelCount)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = initializers::descriptorPoolCreateInfo(poolSizes, pyramid.levelCount);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolInfo, nullptr, &pyramidDescriptorPool));
+
+		pyramid.levelSets.resize(pyramid.levelCount);
+		for (uint32_t level = 0; level < pyramid.levelCount; level++)
+		{
+			VkDescriptorSetAllocateInfo allocInfo = initializers::descriptorSetAllocateInfo(pyramidDescriptorPool, &pyramidDescriptorSetLayout, 1);
+			VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, &pyramid.levelSets[level]));
+
+			VkDescriptorImageInfo source = level == 0
+				? initializers::descriptorImageInfo(pyramid.sampler, depthView, VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL)
+				: initializers::descriptorImageInfo(pyramid.sampler, pyramid.levelViews[level - 1], VK_IMAGE_LAYOUT_GENERAL);
+			VkDescriptorImageInfo destination = initializers::descriptorImageInfo(VK_NULL_HANDLE, pyramid.levelViews[level], VK_IMAGE_LAYOUT_GENERAL);
+			std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+				initializers::writeDescriptorSet(pyramid.levelSets[level], VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0, &source),
+				initializers::writeDescriptorSet(pyramid.levelSets[level], VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1, &destination),
+			};
+			vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+		}
+
+		VkDescriptorImageInfo pyramidDescriptor = initializers::descriptorImageInfo(pyramid.sampler, pyramid.view, VK_IMAGE_LAYOUT_GENERAL);
+		VkWriteDescriptorSet writeDescriptorSet = initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 6, &pyramidDescriptor);
+		vkUpdateDescriptorSets(device->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+
+		pushConstBlock.pyramidSize = vec2(static_cast<float>(width), static_cast<float>(height));
+		pushConstBlock.levelCount = pyramid.levelCount;
+		pyramidInitialized = false;
+		//видимость прошлого кадра относится к старому размеру
+		resetVisibility = true;
+		return true;
+	}
+
+	/***********************************************
+	 *	функция:			DispatchEarly()
+	 *	назначение:			фаза 0: выбрать видимые в прошлом кадре
+	 *						(вне прохода рендера, после Model::BeginFrame)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						viewProjection - projection * view камеры
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionPass::DispatchEarly(VkCommandBuffer commandBuffer, const mat4& viewProjection)
+	{
+		if (pushConstBlock.drawCount == 0)
+			return;
+
+		pushConstBlock.viewProjection = viewProjection;
+
+		//прошлый кадр читал команды как непрямые и писал видимость
+		VkBufferMemoryBarrier barriers[3] = { initializers::bufferMemoryBarrier(), initializers::bufferMemoryBarrier(), initializers::bufferMemoryBarrier() };
+		barriers[0].srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barriers[0].buffer = visibleBuffer.buffer;
+		barriers[0].offset = 0;
+		barriers[0].size = VK_WHOLE_SIZE;
+		barriers[1] = barriers[0];
+		barriers[1].buffer = countBuffer.buffer;
+		barriers[2] = barriers[0];
+		barriers[2].srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barriers[2].buffer = visibilityBuffer.buffer;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 3, barriers, 0, nullptr);
+
+		//отсеченные команды остаются нулевыми (пустая отрисовка)
+		vkCmdFillBuffer(commandBuffer, visibleBuffer.buffer, 0, VK_WHOLE_SIZE, 0);
+		vkCmdFillBuffer(commandBuffer, countBuffer.buffer, 0, VK_WHOLE_SIZE, 0);
+		if (resetVisibility)
+			vkCmdFillBuffer(commandBuffer, visibilityBuffer.buffer, 0, VK_WHOLE_SIZE, 0);
+		resetVisibility = false;
+
+		for (VkBufferMemoryBarrier& barrier : barriers)
+		{
+			barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+			barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+		}
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 3, barriers, 0, nullptr);
+
+		Dispatch(commandBuffer, 0);
+	}
+
+	/***********************************************
+	 *	функция:			BuildPyramid()
+	 *	назначение:			построить пирамиду глубины по результату
+	 *						первой фазы (вне прохода рендера)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionPass::BuildPyramid(VkCommandBuffer commandBuffer)
+	{
+		VkImageMemoryBarrier barriers[2] = { initializers::imageMemoryBarrier(), initializers::imageMemoryBarrier() };
+		barriers[0].srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barriers[0].oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		barriers[0].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		barriers[0].image = depthImage;
+		barriers[0].subresourceRange = { depthAspect, 0, 1, 0, 1 };
+		//вторая фаза прошлого кадра читала пирамиду
+		barriers[1].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barriers[1].dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barriers[1].oldLayout = pyramidInitialized ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED;
+		barriers[1].newLayout = VK_IMAGE_LAYOUT_GENERAL;
+		barriers[1].image = pyramid.image;
+		barriers[1].subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, pyramid.levelCount, 0, 1 };
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0, nullptr, 2, barriers);
+		pyramidInitialized = true;
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pyramidPipeline);
+
+		//каждый уровень читает предыдущий
+		VkMemoryBarrier levelBarrier = initializers::memoryBarrier();
+		levelBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		levelBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+
+		PyramidPushConstBlock pushConst;
+		pushConst.sourceSize = ivec2(pyramid.width, pyramid.height);
+		for (uint32_t level = 0; level < pyramid.levelCount; level++)
+		{
+			pushConst.size = ivec2(std::max(pyramid.width >> level, 1u), std::max(pyramid.height >> level, 1u));
+			vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pyramidPipelineLayout, 0, 1, &pyramid.levelSets[level], 0, nullptr);
+			vkCmdPushConstants(commandBuffer, pyramidPipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PyramidPushConstBlock), &pushConst);
+			vkCmdDispatch(commandBuffer, (pushConst.size.x + 7) / 8, (pushConst.size.y + 7) / 8, 1);
+			vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 1, &levelBarrier, 0, nullptr, 0, nullptr);
+			pushConst.sourceSize = pushConst.size;
+		}
+
+		//второй проход рендера продолжает запись в тот же буфер глубины
+		barriers[0].srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+		barriers[0].oldLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+		barriers[0].newLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT, 0, 0, nullptr, 0, nullptr, 1, barriers);
+	}
+
+	/***********************************************
+	 *	функция:			DispatchLate()
+	 *	назначение:			фаза 1: проверить команды по пирамиде
+	 *						глубины (после BuildPyramid())
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionPass::DispatchLate(VkCommandBuffer commandBuffer)
+	{
+		if (pushConstBlock.drawCount == 0)
+			return;
+
+		Dispatch(commandBuffer, 1);
+	}
+
+	void OcclusionPass::Dispatch(VkCommandBuffer commandBuffer, uint32_t phase)
+	{
+		pushConstBlock.phase = phase;
+
+		const uint32_t frameOffset = model->uniformRing.Offset(0);
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 1, &frameOffset);
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
+		vkCmdDispatch(commandBuffer, (pushConstBlock.drawCount + 63) / 64, 1, 1);
+
+		VkBufferMemoryBarrier barriers[2] = { initializers::bufferMemoryBarrier(), initializers::bufferMemoryBarrier() };
+		barriers[0].srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
+		barriers[0].buffer = visibleBuffer.buffer;
+		barriers[0].offset = 0;
+		barriers[0].size = VK_WHOLE_SIZE;
+		barriers[1] = barriers[0];
+		barriers[1].buffer = countBuffer.buffer;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT, 0, 0, nullptr, 2, barriers, 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			Draw()
+	 *	назначение:			отобразить команды фазы для диапазона
+	 *						конвейера
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						drawPipelineLayout - макет графического конвейера
+	 *						alphaMode - режим прозрачности (конвейер)
+	 *						phase - 0 после DispatchEarly(), 1 после
+	 *						DispatchLate()
+	 *						bindSet - номер набора данных отрисовки
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionPass::Draw(VkCommandBuffer commandBuffer, VkPipelineLayout drawPipelineLayout, Material::AlphaMode alphaMode, uint32_t phase, uint32_t bindSet)
+	{
+		const IndirectBatch& batch = model->indirectBatches[alphaMode];
+		if (batch.commandCount == 0)
+			return;
+
+		model->BindIndirect(commandBuffer, drawPipelineLayout, bindSet);
+
+		const VkDeviceSize offset = (phase * pushConstBlock.drawCount + batch.firstCommand) * sizeof(VkDrawIndexedIndirectCommand);
+		if (drawIndirectCount)
+		{
+			vkCmdDrawIndexedIndirectCount(commandBuffer, visibleBuffer.buffer, offset, countBuffer.buffer, (phase * 3 + alphaMode) * sizeof(uint32_t), batch.commandCount, sizeof(VkDrawIndexedIndirectCommand));
+		}
+		else if (device->enabledFeatures.multiDrawIndirect)
+		{
+			vkCmdDrawIndexedIndirect(commandBuffer, visibleBuffer.buffer, offset, batch.commandCount, sizeof(VkDrawIndexedIndirectCommand));
+		}
+		else
+		{
+			for (uint32_t i = 0; i < batch.commandCount; i++)
+				vkCmdDrawIndexedIndirect(commandBuffer, visibleBuffer.buffer, offset + i * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+		}
+	}
+
+	void OcclusionPass::DestroyPyramid()
+	{
+		for (VkImageView view : pyramid.levelViews)
+			vkDestroyImageView(device->logicalDevice, view, nullptr);
+		pyramid.levelViews.clear();
+		pyramid.levelSets.clear();
+
+		if (pyramid.image != VK_NULL_HANDLE)
+		{
+			vkDestroyImageView(device->logicalDevice, pyramid.view, nullptr);
+			vkDestroyImage(device->logicalDevice, pyramid.image, nullptr);
+			device->allocator.Free(pyramid.memory);
+		}
+		pyramid.image = VK_NULL_HANDLE;
+		pyramid.view = VK_NULL_HANDLE;
+
+		if (pyramidDescriptorPool != VK_NULL_HANDLE)
+			vkDestroyDescriptorPool(device->logicalDevice, pyramidDescriptorPool, nullptr);
+		pyramidDescriptorPool = VK_NULL_HANDLE;
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить ресурсы Vulkan
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void OcclusionPass::Destroy()
+	{
+		if (!device)
+			return;
+
+		visibleBuffer.destroy();
+		countBuffer.destroy();
+		visibilityBuffer.destroy();
+		DestroyPyramid();
+
+		if (pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(device->logicalDevice, pipeline, nullptr);
+			vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
+			vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
+			vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
+			vkDestroyPipeline(device->logicalDevice, pyramidPipeline, nullptr);
+			vkDestroyPipelineLayout(device->logicalDevice, pyramidPipelineLayout, nullptr);
+			vkDestroyDescriptorSetLayout(device->logicalDevice, pyramidDescriptorSetLayout, nullptr);
+			vkDestroySampler(device->logicalDevice, pyramid.sampler, nullptr);
+		}
+		pipeline = VK_NULL_HANDLE;
+		pyramidPipeline = VK_NULL_HANDLE;
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+#include "VulkanBuffer.h"
+#include "VulkanInitializers.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * двухфазное отсечение перекрытых примитивов по пирамиде глубины (HiZ)
+	 *
+	 * Фаза 0 (DispatchEarly): команды Model::indirectBuffer, видимые в
+	 * прошлом кадре и попавшие в пирамиду видимости, пишутся в первый
+	 * список и рисуются. BuildPyramid() строит из получившейся глубины
+	 * пирамиду максимальной глубины (уровень 0 - копия буфера глубины,
+	 * каждый следующий вдвое меньше). Фаза 1 (DispatchLate) проверяет
+	 * экранный прямоугольник границ каждой команды по пирамиде, обновляет
+	 * видимость для следующего кадра и пишет во второй список только
+	 * ставшие видимыми. Второй проход рендера загружает глубину и цвет
+	 * первого (VK_ATTACHMENT_LOAD_OP_LOAD).
+	 *
+	 * Пирамида строится без minmax-фильтра (R32F storage image, выборка
+	 * texelFetch), счетчик drawIndirectCount необязателен. Шейдер копирует
+	 * ненулевой firstInstance в непрямые команды, поэтому нужна
+	 * возможность drawIndirectFirstInstance: без нее Init() возвращает
+	 * false. Буфер глубины должен допускать выборку (VulkanBase:
+	 * settings.sampledDepth), иначе SetDepth() возвращает false. В обоих
+	 * случаях проход использовать нельзя.
+	 *
+	***********************************************************************/
+	class OcclusionPass
+	{
+	public:
+		//раскладка совпадает с push_constant в occlusion.comp
+		struct PushConstBlock
+		{
+			mat4 viewProjection;
+			vec2 pyramidSize;
+			uint32_t drawCount;
+			uint32_t phase;
+			uint32_t firstCommand[3];
+			uint32_t levelCount;
+		} pushConstBlock;
+
+		//раскладка совпадает с push_constant в hiz.comp
+		struct PyramidPushConstBlock
+		{
+			ivec2 sourceSize;
+			ivec2 size;
+		};
+
+		Model* model = nullptr;
+		VulkanDevice* device = nullptr;
+		//включена возможность drawIndirectCount (Vulkan 1.2)
+		bool drawIndirectCount = false;
+
+		//команды обеих фаз: фаза p начинается с p * drawCount
+		Buffer visibleBuffer;
+		//счетчики: фаза * 3 + режим прозрачности
+		Buffer countBuffer;
+		//видимость команды в прошлом кадре
+		Buffer visibilityBuffer;
+
+		struct
+		{
+			VkImage image = VK_NULL_HANDLE;
+			vks::Allocation memory;
+			VkImageView view = VK_NULL_HANDLE;
+			vector<VkImageView> levelViews;
+			vector<VkDescriptorSet> levelSets;
+			VkSampler sampler = VK_NULL_HANDLE;
+			uint32_t width = 0;
+			uint32_t height = 0;
+			uint32_t levelCount = 0;
+		} pyramid;
+
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+
+		VkDescriptorPool pyramidDescriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSetLayout pyramidDescriptorSetLayout = VK_NULL_HANDLE;
+		VkPipelineLayout pyramidPipelineLayout = VK_NULL_HANDLE;
+		VkPipeline pyramidPipeline = VK_NULL_HANDLE;
+
+		bool Init(Model* model);
+		void PreparePipelines(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& cullShader, const VkPipelineShaderStageCreateInfo& pyramidShader);
+		bool SetDepth(VkImage depthImage, VkImageView depthView, VkFormat depthFormat, uint32_t width, uint32_t height);
+		void DispatchEarly(VkCommandBuffer commandBuffer, const mat4& viewProjection);
+		void BuildPyramid(VkCommandBuffer commandBuffer);
+		void DispatchLate(VkCommandBuffer commandBuffer);
+		void Draw(VkCommandBuffer commandBuffer, VkPipelineLayout drawPipelineLayout, Material::AlphaMode alphaMode, uint32_t phase, uint32_t bindSet = 1);
+		void Destroy();
+
+	private:
+		VkImage depthImage = VK_NULL_HANDLE;
+		VkImageAspectFlags depthAspect = VK_IMAGE_ASPECT_DEPTH_BIT;
+		bool resetVisibility = true;
+		bool pyramidInitialized = false;
+
+		void Dispatch(VkCommandBuffer commandBuffer, uint32_t phase);
+		void DestroyPyramid();
+	};
+}
@@ -0,0 +1,183 @@
+#include "ParallelRecorder.h"
+#include "VulkanInitializers.h"
+
+namespace vks
+{
+	ParallelRecorder::~ParallelRecorder()
+	{
+		Destroy();
+	}
+
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			создать пулы и вторичные буферы потоков
+	 *						и запустить рабочие потоки
+	 *	входящие значения:	device - устройство
+	 *						framesInFlight - число кадров в полете
+	 *						threadCount - число потоков вместе с
+	 *						вызывающим (0 - по числу ядер)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void ParallelRecorder::Init(VulkanDevice* device, uint32_t framesInFlight, uint32_t threadCount)
+	{
+		this->device = device;
+		if (threadCount == 0)
+			threadCount = std::max(std::thread::hardware_concurrency(), 1u);
+		framesInFlight = std::max(framesInFlight, 1u);
+
+		threadData.resize(threadCount);
+		for (ThreadData& data : threadData)
+		{
+			data.pools.resize(framesInFlight);
+			data.commandBuffers.resize(framesInFlight);
+			for (uint32_t i = 0; i < framesInFlight; i++)
+			{
+				//буферы перезаписываются каждый кадр, пул сбрасывается целиком
+				data.pools[i] = device->createCommandPool(device->queueFamilyIndices.graphics, VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+				VkCommandBufferAllocateInfo allocateInfo = initializers::commandBufferAllocateInfo(data.pools[i], VK_COMMAND_BUFFER_LEVEL_SECONDARY, 1);
+				VK_CHECK_RESULT(vkAllocateCommandBuffers(device->logicalDevice, &allocateInfo, &data.commandBuffers[i]));
+			}
+		}
+
+		//диапазон 0 пишет вызывающий поток
+		running = true;
+		for (uint32_t thread = 1; thread < threadCount; thread++)
+			threads.emplace_back(&ParallelRecorder::Run, this, thread);
+	}
+
+	/***********************************************
+	 *	функция:			Record()
+	 *	назначение:			записать список отрисовки всеми потоками
+	 *						и исполнить вторичные буферы в первичном
+	 *	входящие значения:	primary - первичный буфер внутри прохода
+	 *						frame - индекс кадра в полете (его
+	 *						ограждение уже пройдено)
+	 *						renderPass, framebuffer - текущий проход
+	 *						itemCount - длина списка отрисовки
+	 *						record - функция записи диапазона,
+	 *						вызывается одновременно из нескольких потоков
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void ParallelRecorder::Record(VkCommandBuffer primary, uint32_t frame, VkRenderPass renderPass, VkFramebuffer framebuffer, uint32_t itemCount, const RecordFunction& record)
+	{
+		this->record = &record;
+		this->frame = frame;
+		this->itemCount = itemCount;
+		inheritanceInfo = initializers::commandBufferInheritanceInfo();
+		inheritanceInfo.renderPass = renderPass;
+		inheritanceInfo.subpass = 0;
+		inheritanceInfo.framebuffer = framebuffer;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			generation++;
+			remaining = static_cast<uint32_t>(threads.size());
+		}
+		condition.notify_all();
+
+		RecordRange(0);
+
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			finished.wait(lock, [this] { return remaining == 0; });
+		}
+
+		//пустые диапазоны не исполняются
+		executed.clear();
+		for (uint32_t thread = 0; thread < threadData.size(); thread++)
+		{
+			uint32_t first, count;
+			Range(thread, first, count);
+			if (count > 0)
+				executed.push_back(threadData[thread].commandBuffers[frame]);
+		}
+		if (!executed.empty())
+			vkCmdExecuteCommands(primary, static_cast<uint32_t>(executed.size()), executed.data());
+	}
+
+	/***********************************************
+	 *	функция:			Run()
+	 *	назначение:			цикл рабочего потока
+	 *	входящие значения:	thread - номер потока (диапазона)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void ParallelRecorder::Run(uint32_t thread)
+	{
+		uint64_t recorded = 0;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [&] { return !running || generation != recorded; });
+				if (!running)
+					return;
+				recorded = generation;
+			}
+
+			RecordRange(thread);
+
+			std::lock_guard<std::mutex> lock(mutex);
+			if (--remaining == 0)
+				finished.notify_one();
+		}
+	}
+
+	/***********************************************
+	 *	функция:			RecordRange()
+	 *	назначение:			записать диапазон потока в его вторичный
+	 *						буфер текущего кадра
+	 *	входящие значения:	thread - номер потока
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void ParallelRecorder::RecordRange(uint32_t thread)
+	{
+		ThreadData& data = threadData[thread];
+		VK_CHECK_RESULT(vkResetCommandPool(device->logicalDevice, data.pools[frame], 0));
+
+		VkCommandBufferBeginInfo beginInfo = initializers::commandBufferBeginInfo();
+		beginInfo.flags = VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT | VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+		beginInfo.pInheritanceInfo = &inheritanceInfo;
+
+		VkCommandBuffer commandBuffer = data.commandBuffers[frame];
+		VK_CHECK_RESULT(vkBeginCommandBuffer(commandBuffer, &beginInfo));
+		uint32_t first, count;
+		Range(thread, first, count);
+		if (count > 0)
+			(*record)(commandBuffer, first, count);
+		VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
+	}
+
+	void ParallelRecorder::Range(uint32_t thread, uint32_t& first, uint32_t& count) const
+	{
+		const uint32_t threadCount = static_cast<uint32_t>(threadData.size());
+		const uint32_t size = (itemCount + threadCount - 1) / threadCount;
+		first = thread * size;
+		count = first < itemCount ? std::min(size, itemCount - first) : 0;
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			остановить потоки и освободить пулы
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void ParallelRecorder::Destroy()
+	{
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			running = false;
+		}
+		condition.notify_all();
+		for (std::thread& thread : threads)
+			thread.join();
+		threads.clear();
+
+		//буферы освобождаются вместе с пулами
+		for (ThreadData& data : threadData)
+		{
+			for (VkCommandPool pool : data.pools)
+				vkDestroyCommandPool(device->logicalDevice, pool, nullptr);
+		}
+		threadData.clear();
+	}
+}
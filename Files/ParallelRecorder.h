@@ -0,0 +1,67 @@
+#pragma once
+
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+#include "VulkanDevice.h"
+
+namespace vks
+{
+	/*************************************************************************
+	 * параллельная запись команд во вторичные командные буферы
+	 *
+	 * Список отрисовки из itemCount элементов делится на равные диапазоны
+	 * по числу потоков, каждый поток пишет свой диапазон во вторичный
+	 * буфер из собственного пула текущего кадра в полете. Первичный буфер
+	 * исполняет вторичные по порядку диапазонов, поэтому порядок отрисовки
+	 * сохраняется. Проход рендера первичного буфера должен быть начат с
+	 * VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS; область вывода и
+	 * конвейер не наследуются и задаются в функции записи.
+	 *
+	***********************************************************************/
+	class ParallelRecorder
+	{
+	public:
+		//записать элементы [first, first + count) списка отрисовки
+		using RecordFunction = std::function<void(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count)>;
+
+		~ParallelRecorder();
+
+		void Init(VulkanDevice* device, uint32_t framesInFlight, uint32_t threadCount = 0);
+		void Record(VkCommandBuffer primary, uint32_t frame, VkRenderPass renderPass, VkFramebuffer framebuffer, uint32_t itemCount, const RecordFunction& record);
+		uint32_t ThreadCount() const { return static_cast<uint32_t>(threadData.size()); }
+		void Destroy();
+
+	private:
+		//пул и вторичный буфер потока на каждый кадр в полете
+		struct ThreadData
+		{
+			vector<VkCommandPool> pools;
+			vector<VkCommandBuffer> commandBuffers;
+		};
+
+		VulkanDevice* device = nullptr;
+		vector<ThreadData> threadData;
+		vector<std::thread> threads;
+		vector<VkCommandBuffer> executed;
+
+		std::mutex mutex;
+		std::condition_variable condition;
+		std::condition_variable finished;
+		uint64_t generation = 0;
+		uint32_t remaining = 0;
+		bool running = false;
+
+		//текущее задание, неизменно между запуском и завершением потоков
+		const RecordFunction* record = nullptr;
+		uint32_t frame = 0;
+		uint32_t itemCount = 0;
+		VkCommandBufferInheritanceInfo inheritanceInfo{};
+
+		void Run(uint32_t thread);
+		void RecordRange(uint32_t thread);
+		void Range(uint32_t thread, uint32_t& first, uint32_t& count) const;
+	};
+}
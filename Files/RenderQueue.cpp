@@ -0,0 +1,193 @@
+#include "RenderQueue.h"
+
+#include <cstring>
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Build()
+	 *	назначение:			собрать видимые примитивы модели и
+	 *						отсортировать их по ключу состояния
+	 *	входящие значения:	model - модель
+	 *						cameraPosition - положение камеры в мировой
+	 *						системе координат модели
+	 *						visible - видимость по Primitive::cullIndex
+	 *						(nullptr - все примитивы)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void RenderQueue::Build(Model* model, vec3 cameraPosition, const uint8_t* visible)
+	{
+		this->model = model;
+		model->UpdateBounds();
+
+		items.clear();
+		keys.clear();
+		const BoxArray& bounds = model->worldBounds;
+		for (Node* node : model->linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+
+			for (Primitive* primitive : node->mesh->primitives)
+			{
+				const uint32_t index = primitive->cullIndex;
+				if (visible && !visible[index])
+					continue;
+
+				//квадрат расстояния до центра коробки; биты неотрицательного float упорядочены как числа
+				const vec3 center = vec3(bounds.minX[index] + bounds.maxX[index], bounds.minY[index] + bounds.maxY[index], bounds.minZ[index] + bounds.maxZ[index]) * 0.5f;
+				const vec3 delta = center - cameraPosition;
+				const float distance = dot(delta, delta);
+				uint32_t depth;
+				memcpy(&depth, &distance, sizeof(depth));
+
+				const uint64_t alphaMode = primitive->material.alphaMode;
+				const uint64_t material = static_cast<uint64_t>(primitive->material.index) & 0x3FFFFFFF;
+				uint64_t key = alphaMode << 62;
+				if (primitive->material.alphaMode == Material::ALPHAMODE_BLEND)
+					key |= static_cast<uint64_t>(~depth) << 30 | material;
+				else
+					key |= material << 32 | depth;
+
+				items.push_back({ primitive, node->mesh });
+				keys.push_back(key);
+			}
+		}
+
+		Sort();
+	}
+
+	/***********************************************
+	 *	функция:			Sort()
+	 *	назначение:			поразрядная сортировка ключей по байтам,
+	 *						начиная с младшего; байты, одинаковые у всех
+	 *						ключей, пропускаются
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void RenderQueue::Sort()
+	{
+		const size_t count = keys.size();
+		order.resize(count);
+		for (uint32_t i = 0; i < count; i++)
+			order[i] = i;
+		scratchKeys.resize(count);
+		scratchOrder.resize(count);
+
+		//гистограммы всех восьми байтов за один проход
+		uint32_t histograms[8][256] = {};
+		for (uint64_t key : keys)
+		{
+			for (uint32_t byte = 0; byte < 8; byte++)
+				histograms[byte][(key >> (byte * 8)) & 0xFF]++;
+		}
+
+		for (uint32_t byte = 0; byte < 8; byte++)
+		{
+			uint32_t* histogram = histograms[byte];
+			const uint32_t shift = byte * 8;
+			if (count == 0 || histogram[(keys[0] >> shift) & 0xFF] == count)
+				continue;
+
+			uint32_t offset = 0;
+			for (uint32_t bucket = 0; bucket < 256; bucket++)
+			{
+				const uint32_t size = histogram[bucket];
+				histogram[bucket] = offset;
+				offset += size;
+			}
+
+			for (size_t i = 0; i < count; i++)
+			{
+				const uint32_t destination = histogram[(keys[i] >> shift) & 0xFF]++;
+				scratchKeys[destination] = keys[i];
+				scratchOrder[destination] = order[i];
+			}
+			keys.swap(scratchKeys);
+			order.swap(scratchOrder);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Draw()
+	 *	назначение:			отображение очереди без повторных привязок
+	 *						конвейера и наборов дескрипторов
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						renderFlags, pipelineLayout, bindImageSet,
+	 *						bindNodeSet - как в Model::draw()
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 **********************************************/
+	vks::CommandRecorder::Statistics RenderQueue::Draw(VkCommandBuffer commandBuffer, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		Draw(recorder, renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+		return recorder.statistics;
+	}
+
+	void RenderQueue::Draw(vks::CommandRecorder& recorder, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet)
+	{
+		if (items.empty())
+			return;
+
+		model->BindBuffers(recorder);
+		DrawItems(recorder, 0, static_cast<uint32_t>(order.size()), renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+	}
+
+	/***********************************************
+	 *	функция:			DrawRange()
+	 *	назначение:			отображение части очереди, например
+	 *						диапазона потока vks::ParallelRecorder
+	 *						(буферы модели связываются всегда)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						first, count - диапазон очереди
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 **********************************************/
+	vks::CommandRecorder::Statistics RenderQueue::DrawRange(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet) const
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawRange(recorder, first, count, renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+		return recorder.statistics;
+	}
+
+	void RenderQueue::DrawRange(vks::CommandRecorder& recorder, uint32_t first, uint32_t count, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet) const
+	{
+		if (count == 0)
+			return;
+
+		recorder.BindVertexBuffer(0, model->vertices.buffer);
+		recorder.BindIndexBuffer(model->indices.buffer, 0, VK_INDEX_TYPE_UINT32);
+		DrawItems(recorder, first, count, renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+	}
+
+	void RenderQueue::DrawItems(vks::CommandRecorder& recorder, uint32_t first, uint32_t count, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet) const
+	{
+		//push-константы обертка не отбрасывает: грань и материал сравниваются здесь
+		const Mesh* boundMesh = nullptr;
+		const Material* pushedMaterial = nullptr;
+		for (size_t i = first; i < first + count; i++)
+		{
+			const Item& item = items[order[i]];
+
+			const VkPipeline pipeline = pipelines[keys[i] >> 62];
+			if (pipeline != VK_NULL_HANDLE)
+				recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+
+			if (item.mesh != boundMesh)
+			{
+				Model::BindNodeTransform(recorder, item.mesh, renderFlags, pipelineLayout, bindNodeSet);
+				boundMesh = item.mesh;
+			}
+
+			if (renderFlags & RenderFlag::BindImages)
+				recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindImageSet, item.primitive->material.descriptorSet);
+
+			if ((renderFlags & RenderFlag::PushMaterialIndex) && &item.primitive->material != pushedMaterial)
+			{
+				pushedMaterial = &item.primitive->material;
+				recorder.PushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(uint32_t), &pushedMaterial->index);
+			}
+
+			recorder.DrawIndexed(item.primitive->indexCount, 1, item.primitive->firstIndex, 0, 0);
+		}
+	}
+}
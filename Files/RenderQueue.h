@@ -0,0 +1,50 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * очередь отрисовки примитивов, отсортированная по состоянию
+	 *
+	 * Build() собирает видимые примитивы модели и строит для каждого
+	 * 64-битный ключ: старшие 2 бита - конвейер (Material::AlphaMode),
+	 * дальше для непрозрачных материал и глубина (спереди назад), для
+	 * ALPHAMODE_BLEND инвертированная глубина и материал (сзади вперед).
+	 * Ключи сортируются поразрядно. Draw() пишет команды через
+	 * vks::CommandRecorder, поэтому конвейер, набор материала и блок грани
+	 * связываются только когда они меняются.
+	 *
+	***********************************************************************/
+	class RenderQueue
+	{
+	public:
+		struct Item
+		{
+			Primitive* primitive;
+			Mesh* mesh;
+		};
+
+		//конвейер для каждого Material::AlphaMode, VK_NULL_HANDLE - связывает вызывающий
+		VkPipeline pipelines[3] = { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
+
+		Model* model = nullptr;
+		vector<Item> items;
+		vector<uint64_t> keys;
+		//индексы items в порядке отрисовки
+		vector<uint32_t> order;
+
+		void Build(Model* model, vec3 cameraPosition, const uint8_t* visible = nullptr);
+		vks::CommandRecorder::Statistics Draw(VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0);
+		void Draw(vks::CommandRecorder& recorder, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0);
+		vks::CommandRecorder::Statistics DrawRange(VkCommandBuffer commandBuffer, uint32_t first, uint32_t count, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0) const;
+		void DrawRange(vks::CommandRecorder& recorder, uint32_t first, uint32_t count, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0) const;
+
+	private:
+		vector<uint64_t> scratchKeys;
+		vector<uint32_t> scratchOrder;
+
+		void Sort();
+		void DrawItems(vks::CommandRecorder& recorder, uint32_t first, uint32_t count, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet) const;
+	};
+}
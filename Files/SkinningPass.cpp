@@ -0,0 +1,195 @@
+#include "SkinningPass.h"
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Init()
+	 *	назначение:			создать буфер вершин экземпляра и список
+	 *						примитивов со скином
+	 *	входящие значения:	model - модель со скинами
+	 *						copyQueue - очередь для копирования
+	 *						sourceBuffer - исходные вершины (по умолчанию
+	 *						буфер модели, например результат морфинга;
+	 *						область кадра задается в Dispatch())
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void SkinningPass::Init(Model* model, VkQueue copyQueue, VkBuffer sourceBuffer)
+	{
+		this->model = model;
+		this->device = model->device;
+
+		const VkDeviceSize vertexBufferSize = static_cast<VkDeviceSize>(model->vertices.count) * sizeof(Vertex);
+		if (sourceBuffer == VK_NULL_HANDLE)
+			sourceBuffer = model->vertices.buffer;
+		sourceDescriptor = { sourceBuffer, 0, vertexBufferSize };
+
+		jobs.clear();
+		for (Node* node : model->linearNodes)
+		{
+			if (!node->mesh || !node->skin)
+				continue;
+
+			//вершинный шейдер больше не применяет матрицы суставов этого скина
+			node->skin->computeSkinned = true;
+			for (Primitive* primitive : node->mesh->primitives)
+			{
+				Job job{};
+				job.pushConstBlock.firstVertex = primitive->firstVertex;
+				job.pushConstBlock.vertexCount = primitive->vertexCount;
+				job.pushConstBlock.jointOffset = node->skin->jointOffset;
+				job.pushConstBlock.vertexStride = sizeof(Vertex) / sizeof(float);
+				job.skin = node->skin;
+				jobs.push_back(job);
+			}
+			node->Update();
+		}
+
+		//вершины без скина копируются один раз и дальше не меняются
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			&vertexBuffer,
+			vertexBufferSize));
+
+		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		VkBufferCopy copyRegion{};
+		copyRegion.size = vertexBufferSize;
+		vkCmdCopyBuffer(copyCmd, model->vertices.buffer, vertexBuffer.buffer, 1, &copyRegion);
+		device->flushCommandBuffer(copyCmd, copyQueue, true);
+	}
+
+	/***********************************************
+	 *	функция:			PreparePipeline()
+	 *	назначение:			создать вычислительный конвейер скиннинга
+	 *	входящие значения:	pipelineCache - кэш конвейеров
+	 *						shader - шейдер skinning.comp
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void SkinningPass::PreparePipeline(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& shader)
+	{
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1),
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 2)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = initializers::descriptorPoolCreateInfo(poolSizes, 1);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolInfo, nullptr, &descriptorPool));
+
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_COMPUTE_BIT, 0),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_COMPUTE_BIT, 1),
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_COMPUTE_BIT, 2),
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayout = initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayout, nullptr, &descriptorSetLayout));
+
+		VkDescriptorSetAllocateInfo allocInfo = initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &allocInfo, &descriptorSet));
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+			//области кадра исходных вершин и палитры выбираются смещением при связывании
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 0, &sourceDescriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1, &model->jointBuffer.descriptor),
+			initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &vertexBuffer.descriptor),
+		};
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+
+		VkPushConstantRange pushConstantRange = initializers::pushConstantRange(VK_SHADER_STAGE_COMPUTE_BIT, sizeof(PushConstBlock), 0);
+		VkPipelineLayoutCreateInfo pipelineLayoutCreateInfo = initializers::pipelineLayoutCreateInfo(&descriptorSetLayout, 1);
+		pipelineLayoutCreateInfo.pushConstantRangeCount = 1;
+		pipelineLayoutCreateInfo.pPushConstantRanges = &pushConstantRange;
+		VK_CHECK_RESULT(vkCreatePipelineLayout(device->logicalDevice, &pipelineLayoutCreateInfo, nullptr, &pipelineLayout));
+
+		VkComputePipelineCreateInfo computePipelineCreateInfo = initializers::computePipelineCreateInfo(pipelineLayout);
+		computePipelineCreateInfo.stage = shader;
+		VK_CHECK_RESULT(vkCreateComputePipelines(device->logicalDevice, pipelineCache, 1, &computePipelineCreateInfo, nullptr, &pipeline));
+	}
+
+	/***********************************************
+	 *	функция:			Dispatch()
+	 *	назначение:			записать скиннинг всех примитивов в командный
+	 *						буфер (вне прохода рендера, до всех проходов,
+	 *						использующих буфер вершин экземпляра,
+	 *						после Model::BeginFrame)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						sourceOffset - смещение области кадра в
+	 *						исходном буфере (MorphBlender::VertexOffset())
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void SkinningPass::Dispatch(VkCommandBuffer commandBuffer, VkDeviceSize sourceOffset)
+	{
+		if (jobs.empty())
+			return;
+
+		//предыдущий кадр читал буфер экземпляра как вершины, исходные вершины могли быть записаны морфингом
+		VkBufferMemoryBarrier barriers[2] = { initializers::bufferMemoryBarrier(), initializers::bufferMemoryBarrier() };
+		barriers[0].srcAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barriers[0].srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barriers[0].dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+		barriers[0].buffer = vertexBuffer.buffer;
+		barriers[0].offset = 0;
+		barriers[0].size = VK_WHOLE_SIZE;
+		barriers[1] = barriers[0];
+		barriers[1].srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barriers[1].dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+		barriers[1].buffer = sourceDescriptor.buffer;
+		barriers[1].offset = sourceOffset;
+		barriers[1].size = sourceDescriptor.range;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 2, barriers, 0, nullptr);
+
+		vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipeline);
+		//смещения по порядку привязок: исходные вершины, палитра
+		const uint32_t frameOffsets[2] = { static_cast<uint32_t>(sourceOffset), model->uniformRing.JointOffset() };
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, pipelineLayout, 0, 1, &descriptorSet, 2, frameOffsets);
+		for (const Job& job : jobs)
+		{
+			vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(PushConstBlock), &job.pushConstBlock);
+			vkCmdDispatch(commandBuffer, (job.pushConstBlock.vertexCount + 63) / 64, 1, 1);
+		}
+
+		barriers[0].srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		barriers[0].dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT;
+		vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, 0, 0, nullptr, 1, barriers, 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			BindBuffers()
+	 *	назначение:			связать буфер вершин экземпляра
+	 *						и индексы модели
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void SkinningPass::BindBuffers(VkCommandBuffer commandBuffer)
+	{
+		model->BindBuffers(commandBuffer, vertexBuffer.buffer);
+	}
+
+	void SkinningPass::BindBuffers(vks::CommandRecorder& recorder)
+	{
+		model->BindBuffers(recorder, vertexBuffer.buffer);
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить ресурсы Vulkan и вернуть
+	 *						скиннинг вершинному шейдеру
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void SkinningPass::Destroy()
+	{
+		for (const Job& job : jobs)
+			job.skin->computeSkinned = false;
+		jobs.clear();
+
+		vertexBuffer.destroy();
+
+		if (pipeline != VK_NULL_HANDLE)
+		{
+			vkDestroyPipeline(device->logicalDevice, pipeline, nullptr);
+			vkDestroyPipelineLayout(device->logicalDevice, pipelineLayout, nullptr);
+			vkDestroyDescriptorSetLayout(device->logicalDevice, descriptorSetLayout, nullptr);
+			vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
+		}
+		pipeline = VK_NULL_HANDLE;
+	}
+}
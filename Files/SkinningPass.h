@@ -0,0 +1,62 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+#include "VulkanBuffer.h"
+#include "VulkanInitializers.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * скиннинг вычислительным шейдером один раз за кадр
+	 *
+	 * Результат пишется в буфер вершин экземпляра (копия всего буфера
+	 * модели), который все последующие проходы связывают как статическую
+	 * геометрию. Для скинов, обработанных здесь, UniformBlock::jointCount
+	 * равен нулю, поэтому вершинный шейдер скиннинг не повторяет.
+	 * Исходные вершины читаются по динамическому смещению: после
+	 * MorphBlender, смешивающего на процессоре, Dispatch() передается
+	 * MorphBlender::VertexOffset() текущего кадра. Вершины без скина
+	 * копируются один раз, их морфинг в буфер экземпляра не попадает.
+	 *
+	***********************************************************************/
+	class SkinningPass
+	{
+	public:
+		struct PushConstBlock
+		{
+			uint32_t firstVertex;
+			uint32_t vertexCount;
+			uint32_t jointOffset;
+			uint32_t vertexStride;
+		};
+
+		//один примитив со скином
+		struct Job
+		{
+			PushConstBlock pushConstBlock;
+			Skin* skin;
+		};
+
+		Model* model = nullptr;
+		VulkanDevice* device = nullptr;
+		vector<Job> jobs;
+
+		Buffer vertexBuffer;
+
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+		VkPipeline pipeline = VK_NULL_HANDLE;
+
+		void Init(Model* model, VkQueue copyQueue, VkBuffer sourceBuffer = VK_NULL_HANDLE);
+		void PreparePipeline(const VkPipelineCache pipelineCache, const VkPipelineShaderStageCreateInfo& shader);
+		void Dispatch(VkCommandBuffer commandBuffer, VkDeviceSize sourceOffset = 0);
+		void BindBuffers(VkCommandBuffer commandBuffer);
+		void BindBuffers(vks::CommandRecorder& recorder);
+		void Destroy();
+
+	private:
+		VkDescriptorBufferInfo sourceDescriptor{};
+	};
+}
@@ -0,0 +1,300 @@
+#include "VertexAnimationTexture.h"
+
+#include "glm/gtc/packing.hpp"
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			Bake()
+	 *	назначение:			запечь все анимации модели в текстуру
+	 *	входящие значения:	model - модель со скинами и анимациями
+	 *						copyQueue - очередь для копирования
+	 *						sampleRate - число кадров в секунду
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void VertexAnimationTexture::Bake(Model* model, VkQueue copyQueue, float sampleRate)
+	{
+		this->model = model;
+		this->sampleRate = sampleRate;
+
+		vector<Vertex> vertices;
+		ReadVertices(copyQueue, vertices);
+		vertexCount = static_cast<uint32_t>(vertices.size());
+
+		clips.clear();
+		frameCount = 0;
+		for (const Animation& animation : model->animations)
+		{
+			Clip clip{};
+			clip.name = animation.name;
+			clip.firstFrame = frameCount;
+			clip.duration = std::max(animation.end - animation.start, 0.0f);
+			clip.frameCount = static_cast<uint32_t>(ceil(clip.duration * sampleRate)) + 1;
+			clip.frameRate = clip.duration > 0.0f ? static_cast<float>(clip.frameCount - 1) / clip.duration : sampleRate;
+			frameCount += clip.frameCount;
+			clips.push_back(clip);
+		}
+		//модель без анимаций запекается в исходной позе
+		const uint32_t bakedFrames = std::max(frameCount, 1u);
+
+		const uint64_t texelCount = static_cast<uint64_t>(vertexCount) * bakedFrames;
+		const uint32_t maxDimension = model->device->properties.limits.maxImageDimension2D;
+		const uint32_t width = std::min(vertexCount, maxDimension);
+		const uint32_t height = static_cast<uint32_t>((texelCount + width - 1) / width);
+		if (height > maxDimension)
+		{
+			std::cout << "Vertex animation texture too large: " << vertexCount << " vertices, " << bakedFrames << " frames" << std::endl;
+			return;
+		}
+
+		//исходное состояние узлов и весов морфинга восстанавливается после запекания
+		vector<vec3> translations, scales;
+		vector<quat> rotations;
+		vector<vector<float>> weights;
+		for (Node* node : model->linearNodes)
+		{
+			translations.push_back(node->translation);
+			rotations.push_back(node->rotation);
+			scales.push_back(node->scale);
+			weights.push_back(node->mesh ? node->mesh->weights : vector<float>());
+		}
+
+		const size_t layerSize = static_cast<size_t>(width) * height;
+		vector<uint64_t> texels(layerSize * 2, 0);
+		if (clips.empty())
+			BakeFrame(vertices, texels.data(), texels.data() + layerSize, 0);
+
+		for (uint32_t c = 0; c < clips.size(); c++)
+		{
+			const Animation& animation = model->animations[c];
+			//frameCount - 1 равных интервалов от начала до конца клипа
+			const uint32_t intervals = std::max(clips[c].frameCount - 1, 1u);
+			for (uint32_t f = 0; f < clips[c].frameCount; f++)
+			{
+				const float time = animation.start + clips[c].duration * static_cast<float>(f) / static_cast<float>(intervals);
+				model->UpdateAnimation(c, time);
+				BakeFrame(vertices, texels.data(), texels.data() + layerSize, clips[c].firstFrame + f);
+			}
+		}
+
+		for (size_t i = 0; i < model->linearNodes.size(); i++)
+		{
+			model->linearNodes[i]->translation = translations[i];
+			model->linearNodes[i]->rotation = rotations[i];
+			model->linearNodes[i]->scale = scales[i];
+			if (model->linearNodes[i]->mesh)
+				model->linearNodes[i]->mesh->weights = weights[i];
+		}
+		for (Node* node : model->nodes)
+			node->Update();
+
+		texture.FromBuffer(texels.data(), texels.size() * sizeof(uint64_t), VK_FORMAT_R16G16B16A16_SFLOAT, width, height, 2, model->device, copyQueue);
+
+		pushConstBlock.sampleRate = sampleRate;
+		pushConstBlock.vertexCount = vertexCount;
+		pushConstBlock.width = width;
+
+		PrepareDescriptor();
+	}
+
+	/***********************************************
+	 *	функция:			ReadVertices()
+	 *	назначение:			прочитать буфер вершин модели с устройства
+	 *	входящие значения:	copyQueue - очередь для копирования
+	 *						vertices - массив для записи
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void VertexAnimationTexture::ReadVertices(VkQueue copyQueue, vector<Vertex>& vertices)
+	{
+		VulkanDevice* device = model->device;
+		const VkDeviceSize size = static_cast<VkDeviceSize>(model->vertices.count) * sizeof(Vertex);
+
+		Buffer readback;
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_TRANSFER_DST_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&readback,
+			size));
+
+		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+		VkBufferCopy copyRegion{};
+		copyRegion.size = size;
+		vkCmdCopyBuffer(copyCmd, model->vertices.buffer, readback.buffer, 1, &copyRegion);
+		device->flushCommandBuffer(copyCmd, copyQueue, true);
+
+		VK_CHECK_RESULT(readback.map());
+		vertices.resize(model->vertices.count);
+		memcpy(vertices.data(), readback.mapped, size);
+		readback.unmap();
+		readback.destroy();
+	}
+
+	/***********************************************
+	 *	функция:			BakeFrame()
+	 *	назначение:			записать позиции и нормали всех вершин
+	 *						в текущей позе модели
+	 *	входящие значения:	vertices - исходные вершины модели
+	 *						positions, normals - слои текстуры
+	 *						frame - номер кадра в текстуре
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void VertexAnimationTexture::BakeFrame(const vector<Vertex>& vertices, uint64_t* positions, uint64_t* normals, uint32_t frame)
+	{
+		vector<mat4> joints;
+		for (Node* node : model->linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+
+			const mat4 world = node->getMatrix();
+			//в системе модели матрица узла с гранями сокращается: сустав = мир сустава * обратная матрица привязки
+			joints.clear();
+			if (node->skin)
+			{
+				joints.resize(node->skin->joints.size());
+				for (size_t j = 0; j < joints.size(); j++)
+					joints[j] = node->skin->joints[j]->getMatrix() * node->skin->inverseBindMatrices[j];
+			}
+
+			for (Primitive* primitive : node->mesh->primitives)
+			{
+				for (uint32_t v = primitive->firstVertex; v < primitive->firstVertex + primitive->vertexCount; v++)
+				{
+					const Vertex& vertex = vertices[v];
+					mat4 transform = world;
+					if (!joints.empty() && node->skin && (dot(vertex.weight0, vec4(1.0f)) > 0.0f))
+					{
+						transform = mat4(0.0f);
+						for (uint32_t k = 0; k < 4; k++)
+						{
+							const uint32_t joint = std::min(static_cast<uint32_t>(vertex.joint0[k]), static_cast<uint32_t>(joints.size() - 1));
+							transform += vertex.weight0[k] * joints[joint];
+						}
+					}
+
+					const vec3 position = vec3(transform * vec4(vertex.pos, 1.0f));
+					vec3 normal = mat3(transform) * vertex.normal;
+					const float length = glm::length(normal);
+					if (length > 0.0f)
+						normal /= length;
+
+					const size_t index = static_cast<size_t>(frame) * vertexCount + v;
+					positions[index] = packHalf4x16(vec4(position, 1.0f));
+					normals[index] = packHalf4x16(vec4(normal, 0.0f));
+				}
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			PrepareDescriptor()
+	 *	назначение:			набор дескрипторов текстуры для
+	 *						вершинного шейдера
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void VertexAnimationTexture::PrepareDescriptor()
+	{
+		VkDevice device = model->device->logicalDevice;
+
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			initializers::descriptorPoolSize(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1)
+		};
+		VkDescriptorPoolCreateInfo descriptorPoolInfo = initializers::descriptorPoolCreateInfo(poolSizes, 1);
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device, &descriptorPoolInfo, nullptr, &descriptorPool));
+
+		std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+			initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_VERTEX_BIT, 0),
+		};
+		VkDescriptorSetLayoutCreateInfo descriptorLayout = initializers::descriptorSetLayoutCreateInfo(setLayoutBindings);
+		VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device, &descriptorLayout, nullptr, &descriptorSetLayout));
+
+		VkDescriptorSetAllocateInfo allocInfo = initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device, &allocInfo, &descriptorSet));
+		VkWriteDescriptorSet writeDescriptorSet = initializers::writeDescriptorSet(descriptorSet, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 0, &texture.descriptor);
+		vkUpdateDescriptorSets(device, 1, &writeDescriptorSet, 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			Instance()
+	 *	назначение:			данные экземпляра для клипа
+	 *	входящие значения:	clip - индекс клипа
+	 *						position - положение экземпляра
+	 *						scale - масштаб
+	 *						timeOffset - сдвиг по времени
+	 *						speed - скорость воспроизведения в секундах клипа
+	 *	выходящие значения:	данные экземпляра
+	 **********************************************/
+	VertexAnimationTexture::InstanceData VertexAnimationTexture::Instance(uint32_t clip, vec3 position, float scale, float timeOffset, float speed) const
+	{
+		InstanceData instance{};
+		instance.position = vec4(position, scale);
+		if (clip < clips.size())
+			instance.clip = vec4(static_cast<float>(clips[clip].firstFrame), static_cast<float>(clips[clip].frameCount), timeOffset, speed * clips[clip].frameRate / sampleRate);
+		else
+			instance.clip = vec4(0.0f, 1.0f, 0.0f, 0.0f);
+		return instance;
+	}
+
+	VkVertexInputBindingDescription VertexAnimationTexture::InstanceBindingDescription(uint32_t binding)
+	{
+		return VkVertexInputBindingDescription({ binding, sizeof(InstanceData), VK_VERTEX_INPUT_RATE_INSTANCE });
+	}
+
+	vector<VkVertexInputAttributeDescription> VertexAnimationTexture::InstanceAttributeDescriptions(uint32_t binding, uint32_t firstLocation)
+	{
+		return {
+			VkVertexInputAttributeDescription({ firstLocation, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(InstanceData, position) }),
+			VkVertexInputAttributeDescription({ firstLocation + 1, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(InstanceData, clip) }),
+		};
+	}
+
+	/***********************************************
+	 *	функция:			Draw()
+	 *	назначение:			отображение всех экземпляров
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						pipelineLayout - раскладка конвейера с набором
+	 *						текстуры и push-константами вершинного шейдера
+	 *						time - общее время
+	 *						instanceBuffer - буфер InstanceData
+	 *						instanceCount - число экземпляров
+	 *						bindSet - номер набора текстуры
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void VertexAnimationTexture::Draw(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, float time, VkBuffer instanceBuffer, uint32_t instanceCount, uint32_t bindSet)
+	{
+		pushConstBlock.time = time;
+		vkCmdPushConstants(commandBuffer, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(PushConstBlock), &pushConstBlock);
+		vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindSet, 1, &descriptorSet, 0, nullptr);
+
+		const VkBuffer buffers[2] = { model->vertices.buffer, instanceBuffer };
+		const VkDeviceSize offsets[2] = { 0, 0 };
+		vkCmdBindVertexBuffers(commandBuffer, 0, 2, buffers, offsets);
+		vkCmdBindIndexBuffer(commandBuffer, model->indices.buffer, 0, VK_INDEX_TYPE_UINT32);
+
+		for (Node* node : model->linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+			for (Primitive* primitive : node->mesh->primitives)
+				vkCmdDrawIndexed(commandBuffer, primitive->indexCount, instanceCount, primitive->firstIndex, 0, 0);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Destroy()
+	 *	назначение:			освободить ресурсы Vulkan
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void VertexAnimationTexture::Destroy()
+	{
+		if (descriptorPool == VK_NULL_HANDLE)
+			return;
+
+		texture.Destroy();
+		vkDestroyDescriptorSetLayout(model->device->logicalDevice, descriptorSetLayout, nullptr);
+		vkDestroyDescriptorPool(model->device->logicalDevice, descriptorPool, nullptr);
+		descriptorPool = VK_NULL_HANDLE;
+	}
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "VulkanglTfModel.h"
+#include "VulkanTexture.h"
+#include "VulkanInitializers.h"
+
+namespace vkglTF
+{
+	/*************************************************************************
+	 * запеченная анимация вершин (VAT) для дальних толп
+	 *
+	 * Все анимации модели сэмплируются с постоянным шагом, позиции и нормали
+	 * вершин в системе координат модели пишутся в текстуру-массив
+	 * (слой 0 - позиции, слой 1 - нормали, RGBA16F). Тексель вершины v
+	 * кадра f имеет линейный индекс f * vertexCount + v и переносится по
+	 * строкам шириной width. Кадры клипа делят его длительность на
+	 * frameCount - 1 равных интервалов, последний кадр совпадает с концом
+	 * клипа, и шейдер зацикливает именно эти интервалы. Шейдер vat.vert
+	 * воспроизводит анимацию только по данным экземпляра, без матриц
+	 * суставов и работы на процессоре.
+	 *
+	***********************************************************************/
+	class VertexAnimationTexture
+	{
+	public:
+		struct Clip
+		{
+			string name;
+			uint32_t firstFrame = 0;
+			uint32_t frameCount = 0;
+			float duration = 0.0f;
+			//кадров в секунду клипа: (frameCount - 1) / duration, не меньше sampleRate
+			float frameRate = 0.0f;
+		};
+
+		//данные экземпляра (буфер вершин с шагом на экземпляр)
+		struct InstanceData
+		{
+			//xyz - положение, w - масштаб
+			vec4 position;
+			//x - первый кадр клипа, y - число кадров, z - сдвиг по времени,
+			//w - скорость с поправкой Clip::frameRate / sampleRate
+			vec4 clip;
+		};
+
+		struct PushConstBlock
+		{
+			float time;
+			float sampleRate;
+			uint32_t vertexCount;
+			uint32_t width;
+		} pushConstBlock;
+
+		Model* model = nullptr;
+		float sampleRate = 30.0f;
+		uint32_t vertexCount = 0;
+		uint32_t frameCount = 0;
+		vector<Clip> clips;
+
+		vks::Texture2DArray texture;
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		VkDescriptorSetLayout descriptorSetLayout = VK_NULL_HANDLE;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+
+		void Bake(Model* model, VkQueue copyQueue, float sampleRate = 30.0f);
+		InstanceData Instance(uint32_t clip, vec3 position, float scale = 1.0f, float timeOffset = 0.0f, float speed = 1.0f) const;
+		static VkVertexInputBindingDescription InstanceBindingDescription(uint32_t binding);
+		static vector<VkVertexInputAttributeDescription> InstanceAttributeDescriptions(uint32_t binding, uint32_t firstLocation);
+		void Draw(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, float time, VkBuffer instanceBuffer, uint32_t instanceCount, uint32_t bindSet = 1);
+		void Destroy();
+
+	private:
+		void ReadVertices(VkQueue copyQueue, vector<Vertex>& vertices);
+		void BakeFrame(const vector<Vertex>& vertices, uint64_t* positions, uint64_t* normals, uint32_t frame);
+		void PrepareDescriptor();
+	};
+}
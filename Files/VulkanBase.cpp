@@ -1,1058 +1,1134 @@
-#include "VulkanBase.h"
-
-
-#include <iostream>
-#include <vector>
-
-#include "VulkanTools.h"
-
-/***********************************************
- *	:			GetWindowTitle()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-string VulkanBase::GetWindowTitle()
-{
-	string device(deviceProperties.deviceName);
-	string windowTitle;
-
-	windowTitle = title + " - " + device;
-	if (!settings.overlay)
-		windowTitle += " - " + to_string(frameCounter) + " fps";
-	
-	return windowTitle;
-}
-
-void VulkanBase::WindowResize()
-{
-	if (!prepared)
-	{
-		return;
-	}
-	prepared = false;
-
-	// Ensure all operations on the device have been finished before destroying resources
-	vkDeviceWaitIdle(device);
-
-	// Recreate swap chain
-	width = destWidth;
-	height = destHeight;
-	SetupSwapChain();
-
-	// Recreate the frame buffers
-	vkDestroyImageView(device, depthStencil.view, nullptr);
-	vkDestroyImage(device, depthStencil.image, nullptr);
-	vkFreeMemory(device, depthStencil.mem, nullptr);
-	SetupDepthStencil();
-	for (uint32_t i = 0; i < frameBuffers.size(); i++) {
-		vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
-	}
-	SetupFrameBuffer();
-
-	if ((width > 0.0f) && (height > 0.0f)) {
-		if (settings.overlay) {
-			//UIOverlay.resize(width, height);
-		}
-	}
-
-	// Command buffers need to be recreated as they may store
-	// references to the recreated frame buffer
-	DestroyCommandBuffers();
-	CreateCommandBuffers();
-	BuildCommandBuffers();
-
-	vkDeviceWaitIdle(device);
-
-	if ((width > 0.0f) && (height > 0.0f)) 
-		camera.UpdateAspectRatio(static_cast<float>(width) / static_cast<float>(height));
-
-	// Notify derived class
-	WindowResized();
-	ViewChanged();
-
-	prepared = true;
-}
-
-/***********************************************
- *	:			HandleMouseMove()
- *	:			  
- *	 :	x, y -  
- *	 :	
- **********************************************/
-void VulkanBase::HandleMouseMove(int32_t x, int32_t y)
-{
-	int32_t dx = static_cast<int32_t>(mousePos.x) - x;
-	int32_t dy = static_cast<int32_t>(mousePos.y) - y;
-
-	bool handled = false;
-
-	if (settings.overlay) {
-		//ImGuiIO& io = ImGui::GetIO();
-		//handled = io.WantCaptureMouse;
-	}
-	MouseMoved(static_cast<float>(x), static_cast<float>(y), handled);
-
-	if (handled) 
-	{
-		mousePos = vec2(static_cast<float>(x), static_cast<float>(y));
-		return;
-	}
-
-	if (mouseButtons.left) 
-	{
-		camera.Rotate(vec3(dy * camera.rotationSpeed, -dx * camera.rotationSpeed, 0.0f));
-		viewUpdated = true;
-	}
-	if (mouseButtons.right) {
-		camera.Translate(vec3(-0.0f, 0.0f, dy * .005f));
-		viewUpdated = true;
-	}
-	if (mouseButtons.middle) 
-	{
-		camera.Translate(vec3(-dx * 0.01f, -dy * 0.01f, 0.0f));
-		viewUpdated = true;
-	}
-	mousePos = vec2(static_cast<float>(x), static_cast<float>(y));
-}
-
-/***********************************************
- *	:			NextFrame()
- *	:			  
- *	 :	enableValidation   
- *	 :	
- **********************************************/
-void VulkanBase::NextFrame()
-{
-	auto tStart = std::chrono::high_resolution_clock::now();
-	if (viewUpdated)
-	{
-		viewUpdated = false;
-		ViewChanged();
-	}
-
-	Render();
-	frameCounter++;
-	auto tEnd = std::chrono::high_resolution_clock::now();
-	auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
-	frameTimer = (float)tDiff / 1000.0f;
-	camera.Update(frameTimer);
-	if (camera.moving())
-	{
-		viewUpdated = true;
-	}
-	// Convert to clamped timer value
-	if (!paused)
-	{
-		timer += timerSpeed * frameTimer;
-		if (timer > 1.0)
-		{
-			timer -= 1.0f;
-		}
-	}
-	float fpsTimer = (float)(std::chrono::duration<double, std::milli>(tEnd - lastTimestamp).count());
-	if (fpsTimer > 1000.0f)
-	{
-		lastFPS = static_cast<uint32_t>((float)frameCounter * (1000.0f / fpsTimer));
-#if defined(_WIN32)
-		if (!settings.overlay) {
-			string windowTitle = GetWindowTitle();
-			wstring newbuf = wstring(windowTitle.begin(), windowTitle.end());
-			SetWindowText(window, newbuf.c_str());
-		}
-#endif
-		frameCounter = 0;
-		lastTimestamp = tEnd;
-	}
-	UpdateOverlay();
-}
-
-/***********************************************
- *	:			InitSwapchain()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::UpdateOverlay()
-{
-	if (!settings.overlay)
-		return;
-
-	ImGuiIO& io = ImGui::GetIO();
-
-	io.DisplaySize = ImVec2((float)width, (float)height);
-	io.DeltaTime = frameTimer;
-
-	io.MousePos = ImVec2(mousePos.x, mousePos.y);
-	io.MouseDown[0] = mouseButtons.left;
-	io.MouseDown[1] = mouseButtons.right;
-
-	ImGui::NewFrame();
-
-	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0);
-	ImGui::SetNextWindowPos(ImVec2(10, 10));
-	//ImGuiSetCond_FirstUseEver to ImGuiCond_FirstUseEver
-	ImGui::SetNextWindowSize(ImVec2(0, 0), ImGuiCond_FirstUseEver);
-	ImGui::Begin("Vulkan Example", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
-	ImGui::TextUnformatted(title.c_str());
-	ImGui::TextUnformatted(deviceProperties.deviceName);
-	ImGui::Text("%.2f ms/frame (%.1d fps)", (1000.0f / lastFPS), lastFPS);
-
-	ImGui::PushItemWidth(110.0f * UIOverlay.scale);
-	OnUpdateUIOverlay(&UIOverlay);
-	ImGui::PopItemWidth();
-
-	ImGui::End();
-	ImGui::PopStyleVar();
-	ImGui::Render();
-
-	if (UIOverlay.Update() || UIOverlay.updated) {
-		BuildCommandBuffers();
-		UIOverlay.updated = false;
-	}
-}
-
-/***********************************************
- *	:			InitSwapchain()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::InitSwapchain()
-{
-#if defined(_WIN32)
-	swapChain.initSurface(windowInstance, window);
-#endif
-}
-
-/***********************************************
- *	:			CreateCommandPool()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::CreateCommandPool()
-{
-	VkCommandPoolCreateInfo cmdPoolInfo = {};
-	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
-	cmdPoolInfo.queueFamilyIndex = swapChain.queueNodeIndex;
-	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
-	VK_CHECK_RESULT(vkCreateCommandPool(device, &cmdPoolInfo, nullptr, &cmdPool));
-}
-
-/***********************************************
- *	:			SetupSwapChain()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::SetupSwapChain()
-{
-	swapChain.create(&width, &height, settings.vsync);
-}
-
-/***********************************************
- *	:			CreateCommandBuffers()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::CreateCommandBuffers()
-{
-	// Create one command buffer for each swap chain image and reuse for rendering
-	drawCmdBuffers.resize(swapChain.imageCount);
-
-	VkCommandBufferAllocateInfo cmdBufAllocateInfo =
-		vks::initializers::commandBufferAllocateInfo(
-			cmdPool,
-			VK_COMMAND_BUFFER_LEVEL_PRIMARY,
-			static_cast<uint32_t>(drawCmdBuffers.size()));
-
-	VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, drawCmdBuffers.data()));
-}
-
-/***********************************************
- *	:			reateCommandBuffers()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::reateSynchronizationPrimitives()
-{
-	// Wait fences to sync command buffer access
-	VkFenceCreateInfo fenceCreateInfo = vks::initializers::fenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
-	waitFences.resize(drawCmdBuffers.size());
-	for (auto& fence : waitFences) {
-		VK_CHECK_RESULT(vkCreateFence(device, &fenceCreateInfo, nullptr, &fence));
-	}
-}
-
-void VulkanBase::CreatePipelineCache()
-{
-	VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
-	pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-	VK_CHECK_RESULT(vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &pipelineCache));
-}
-
-/***********************************************
- *	:			DestroyCommandBuffers()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::DestroyCommandBuffers()
-{
-	vkFreeCommandBuffers(device, cmdPool, static_cast<uint32_t>(drawCmdBuffers.size()), drawCmdBuffers.data());
-}
-
-/***********************************************
- *	:			VulkanBase()
- *	:			  
- *	 :	enableValidation   
- *	 :	
- **********************************************/
-VulkanBase::VulkanBase(bool enableValidation)
-{
-	struct stat info;
-
-	if(stat(getAssetPath().c_str(), &info) != 0)
-	{
-		
-	}
-	SetupConsole("Vulkan validation output");
-}
-
-/***********************************************
- *	:			~VulkanBase()
- *	:			 
- *	 :	
- *	 :	
- **********************************************/
-VulkanBase::~VulkanBase()
-{
-	// Clean up Vulkan resources
-	swapChain.cleanup();
-	if (descriptorPool != VK_NULL_HANDLE)
-	{
-		vkDestroyDescriptorPool(device, descriptorPool, nullptr);
-	}
-	DestroyCommandBuffers();
-	vkDestroyRenderPass(device, renderPass, nullptr);
-	for (uint32_t i = 0; i < frameBuffers.size(); i++)
-	{
-		vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
-	}
-
-	for (auto& shaderModule : shaderModules)
-	{
-		vkDestroyShaderModule(device, shaderModule, nullptr);
-	}
-	vkDestroyImageView(device, depthStencil.view, nullptr);
-	vkDestroyImage(device, depthStencil.image, nullptr);
-	vkFreeMemory(device, depthStencil.mem, nullptr);
-
-	vkDestroyPipelineCache(device, pipelineCache, nullptr);
-
-	vkDestroyCommandPool(device, cmdPool, nullptr);
-
-	vkDestroySemaphore(device, semaphores.presentComplete, nullptr);
-	vkDestroySemaphore(device, semaphores.renderComplete, nullptr);
-	for (auto& fence : waitFences) {
-		vkDestroyFence(device, fence, nullptr);
-	}
-
-	if (settings.overlay) {
-		UIOverlay.FreeResources();
-	}
-
-	delete vulkanDevice;
-
-	if (settings.validation)
-	{
-		//vks::Debug::freeDebugCallback(instance);
-	}
-
-	vkDestroyInstance(instance, nullptr);
-}
-
-/***********************************************
- *	:			LoadShader()
- *	:			  
- *	 :	fileName -  
- *						stage -  
- *	 :	
- **********************************************/
-VkPipelineShaderStageCreateInfo VulkanBase::LoadShader(string fileName, VkShaderStageFlagBits stage)
-{
-	VkPipelineShaderStageCreateInfo shaderStage = {};
-	shaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-	shaderStage.stage = stage;
-	shaderStage.module = vks::tools::LoadShader(fileName.c_str(), device);
-	shaderStage.pName = "main";
-	assert(shaderStage.module != VK_NULL_HANDLE);
-	shaderModules.push_back(shaderStage.module);
-	return shaderStage;
-}
-
-/***********************************************
- *	:			HandleMessage()
- *	:			   
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::HandleMessage(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
-{
-	switch (uMsg)
-	{
-	case WM_CLOSE:
-		prepared = false;
-		DestroyWindow(hWnd);
-		PostQuitMessage(0);
-		break;
-
-	case WM_SIZE:
-		if ((prepared) && (wParam != SIZE_MINIMIZED))
-		{
-			if ((resizing) || ((wParam == SIZE_MAXIMIZED) || (wParam == SIZE_RESTORED)))
-			{
-				destWidth = LOWORD(lParam);
-				destHeight = HIWORD(lParam);
-				WindowResize();
-			}
-		}
-		break;
-
-	case WM_LBUTTONDOWN:
-		mousePos = vec2((float)LOWORD(lParam), (float)HIWORD(lParam));
-		mouseButtons.left = true;
-		break;
-	case WM_RBUTTONDOWN:
-		mousePos = vec2((float)LOWORD(lParam), (float)HIWORD(lParam));
-		mouseButtons.right = true;
-		break;
-	case WM_MBUTTONDOWN:
-		mousePos = vec2((float)LOWORD(lParam), (float)HIWORD(lParam));
-		mouseButtons.middle = true;
-		break;
-	case WM_LBUTTONUP:
-		mouseButtons.left = false;
-		break;
-	case WM_RBUTTONUP:
-		mouseButtons.right = false;
-		break;
-	case WM_MBUTTONUP:
-		mouseButtons.middle = false;
-		break;
-	case WM_MOUSEWHEEL:
-	{
-		short wheelDelta = GET_WHEEL_DELTA_WPARAM(wParam);
-		camera.Translate(glm::vec3(0.0f, 0.0f, (float)wheelDelta * 0.005f));
-		viewUpdated = true;
-		break;
-	}
-		
-		case WM_MOUSEMOVE:
-			HandleMouseMove(LOWORD(lParam), HIWORD(lParam));
-		break;
-
-		case WM_ENTERSIZEMOVE:
-			resizing = true;
-			break;
-		case WM_EXITSIZEMOVE:
-			resizing = false;
-			break;
-	}
-
-}
-
-/***********************************************
- *	:			SetupWindow()
- *	:			  
- *	 :	hInstance -  
- *						wndProc -   
- *	 :	window -   
- **********************************************/
-HWND VulkanBase::SetupWindow(HINSTANCE hInstance, WNDPROC wndProc)
-{
-	windowInstance = hInstance;
-
-	WNDCLASSEX wndClass;
-
-	wndClass.cbSize = sizeof(WNDCLASSEX);
-	wndClass.style = CS_HREDRAW | CS_VREDRAW;
-	wndClass.lpfnWndProc = wndProc;
-	wndClass.cbClsExtra = 0;
-	wndClass.cbWndExtra = 0;
-	wndClass.hInstance = hInstance;
-	wndClass.hIcon = LoadIcon(nullptr, IDI_APPLICATION);
-	wndClass.hCursor = LoadCursor(nullptr, IDC_ARROW);
-	wndClass.hbrBackground = (HBRUSH)GetStockObject(BLACK_BRUSH);
-	wndClass.lpszMenuName = nullptr;
-	wstring newbuf = wstring(name.begin(), name.end());
-	wndClass.lpszClassName = newbuf.c_str();
-	wndClass.hIconSm = LoadIcon(nullptr, IDI_WINLOGO);
-
-	if(!RegisterClassEx(&wndClass))
-	{
-		cout << "   !\n";
-		fflush(stdout);
-		exit(1);
-	}
-
-	int screenWidth = GetSystemMetrics(SM_CXSCREEN);
-	int screenHeight = GetSystemMetrics(SM_CYSCREEN);
-
-	if(settings.fullscreen)
-	{
-		DEVMODE dmScreenSettings;
-		memset(&dmScreenSettings, 0, sizeof(dmScreenSettings));
-		dmScreenSettings.dmSize = sizeof(dmScreenSettings);
-		dmScreenSettings.dmPelsWidth = screenWidth;
-		dmScreenSettings.dmPelsHeight = screenHeight;
-		dmScreenSettings.dmBitsPerPel = 32;
-		dmScreenSettings.dmFields = DM_BITSPERPEL | DM_PELSWIDTH | DM_PELSHEIGHT;
-
-		if((width != static_cast<uint32_t>(screenWidth)) && (height != static_cast<uint32_t>(screenHeight)))
-		{
-			if (ChangeDisplaySettings(&dmScreenSettings, CDS_FULLSCREEN) != DISP_CHANGE_SUCCESSFUL)
-			{
-				if (MessageBox(nullptr, L"   !\n    ?", L"Error", MB_YESNO | MB_ICONEXCLAMATION) == IDYES)
-				{
-					settings.fullscreen = false;
-				}
-				else
-					return nullptr;
-			}
-		}
-	}
-
-	DWORD dwExStyle;
-	DWORD dwStyle;
-
-	if (settings.fullscreen)
-	{
-		dwExStyle = WS_EX_APPWINDOW;
-		dwStyle = WS_POPUP | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
-	}
-	else
-	{
-		dwExStyle = WS_EX_APPWINDOW | WS_EX_WINDOWEDGE;
-		dwStyle = WS_OVERLAPPEDWINDOW | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
-	}
-
-	RECT windowRect;
-	windowRect.left = 0L;
-	windowRect.top = 0L;
-	windowRect.right = settings.fullscreen ? (long)screenWidth : (long)width;
-	windowRect.bottom = settings.fullscreen ? (long)screenHeight : (long)height;
-
-	AdjustWindowRectEx(&windowRect, dwStyle, FALSE, dwExStyle);
-
-	string windowTitle = GetWindowTitle();
-	wstring newbufTitle = wstring(windowTitle.begin(), windowTitle.end());
-	
-	window = CreateWindowEx(0,
-		newbuf.c_str(),
-		newbufTitle.c_str(),
-		dwStyle | WS_CLIPSIBLINGS | WS_CLIPCHILDREN,
-		0,
-		0,
-		windowRect.right - windowRect.left,
-		windowRect.bottom - windowRect.top,
-		nullptr,
-		nullptr,
-		hInstance,
-		nullptr);
-
-	if (!settings.fullscreen)
-	{
-		// Center on screen
-		uint32_t x = (GetSystemMetrics(SM_CXSCREEN) - windowRect.right) / 2;
-		uint32_t y = (GetSystemMetrics(SM_CYSCREEN) - windowRect.bottom) / 2;
-		SetWindowPos(window, 0, x, y, 0, 0, SWP_NOZORDER | SWP_NOSIZE);
-	}
-
-	if (!window)
-	{
-		printf("   !\n");
-		fflush(stdout);
-		return nullptr;
-	}
-
-	ShowWindow(window, SW_SHOW);
-	SetForegroundWindow(window);
-	SetFocus(window);
-	
-	return window;
-}
-
-/***********************************************
- *	:			RenderLoop()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::RenderLoop()
-{
-	destWidth = width;
-	destHeight = height;
-	lastTimestamp = chrono::high_resolution_clock::now();
-
-#if defined(_WIN32)
-	MSG msg;
-	bool quitMessageReceived = false;
-	while (!quitMessageReceived) {
-		while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
-			TranslateMessage(&msg);
-			DispatchMessage(&msg);
-			if (msg.message == WM_QUIT) {
-				quitMessageReceived = true;
-				break;
-			}
-		}
-		if (prepared && !IsIconic(window)) {
-			NextFrame();
-		}
-	}
-#endif
-
-}
-
-/***********************************************
- *	:			SetupConsole()
- *	:			 
- *	 :	title -  
- *	 :	
- **********************************************/
-void VulkanBase::SetupConsole(string title)
-{
-	AllocConsole();
-	AttachConsole(GetCurrentProcessId());
-	FILE* stream;
-	freopen_s(&stream, "CONOUT$", "w+", stdout);
-	freopen_s(&stream, "CONOUT$", "w+", stderr);
-
-	wstring newbuf = wstring(title.begin(), title.end());
-	SetConsoleTitle(newbuf.c_str());
-
-	setlocale(LC_ALL, "Russian");
-}
-
-/***********************************************
- *	:			InitVulkan()
- *	:			 Vulkan
- *	 :	
- *	 :	
- **********************************************/
-bool VulkanBase::InitVulkan()
-{
-	VkResult err = CreateInstance(settings.validation);
-	if(err)
-	{
-		vks::tools::exitFatal("   Vulkan : \n" + vks::tools::errorString(err), err);
-		return false;
-	}
-
-	// Physical device
-	uint32_t gpuCount = 0;
-	// Get number of available physical devices
-	VK_CHECK_RESULT(vkEnumeratePhysicalDevices(instance, &gpuCount, nullptr));
-	assert(gpuCount > 0);
-	// Enumerate devices
-	vector<VkPhysicalDevice> physicalDevices(gpuCount);
-	err = vkEnumeratePhysicalDevices(instance, &gpuCount, physicalDevices.data());
-	if (err) {
-		vks::tools::exitFatal("Could not enumerate physical devices : \n" + vks::tools::errorString(err), err);
-		return false;
-	}
-
-	// Select physical device to be used for the Vulkan example
-	// Defaults to the first device unless specified by command line
-	uint32_t selectedDevice = 0;
-	physicalDevice = physicalDevices[selectedDevice];
-
-	// Store properties (including limits), features and memory properties of the physical device (so that examples can check against them)
-	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
-	vkGetPhysicalDeviceFeatures(physicalDevice, &deviceFeatures);
-	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &deviceMemoryProperties);
-
-	// Derived examples can override this to set actual features (based on above readings) to enable for logical device creation
-	GetEnabledFeatures();
-
-	// Vulkan device creation
-	// This is handled by a separate class that gets a logical device representation
-	// and encapsulates functions related to a device
-	vulkanDevice = new vks::VulkanDevice(physicalDevice);
-	VkResult res = vulkanDevice->createLogicalDevice(enabledFeatures, enabledDeviceExtensions, deviceCreatepNextChain);
-	if (res != VK_SUCCESS) {
-		vks::tools::exitFatal("Could not create Vulkan device: \n" + vks::tools::errorString(res), res);
-		return false;
-	}
-	device = vulkanDevice->logicalDevice;
-		
-	// Get a graphics queue from the device
-	vkGetDeviceQueue(device, vulkanDevice->queueFamilyIndices.graphics, 0, &queue);
-
-	// Find a suitable depth format
-	VkBool32 validDepthFormat = vks::tools::getSupportedDepthFormat(physicalDevice, &depthFormat);
-	assert(validDepthFormat);
-
-	swapChain.connect(instance, physicalDevice, device);
-
-	// Create synchronization objects
-	VkSemaphoreCreateInfo semaphoreCreateInfo = vks::initializers::semaphoreCreateInfo();
-	// Create a semaphore used to synchronize image presentation
-	// Ensures that the image is displayed before we start submitting new commands to the queue
-	VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphores.presentComplete));
-	// Create a semaphore used to synchronize command submission
-	// Ensures that the image is not presented until all commands have been submitted and executed
-	VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &semaphores.renderComplete));
-
-	// Set up submit info structure
-	// Semaphores will stay the same during application lifetime
-	// Command buffer submission info is set by each example
-	submitInfo = vks::initializers::submitInfo();
-	submitInfo.pWaitDstStageMask = &submitPipelineStages;
-	submitInfo.waitSemaphoreCount = 1;
-	submitInfo.pWaitSemaphores = &semaphores.presentComplete;
-	submitInfo.signalSemaphoreCount = 1;
-	submitInfo.pSignalSemaphores = &semaphores.renderComplete;
-	return true;
-}
-
-/***********************************************
- *	:			CreateInstance()
- *	:			  Vulkan
- *	 :	
- *	 :	
- **********************************************/
-VkResult VulkanBase::CreateInstance(bool validation)
-{
-	this->settings.validation = validation;
-	
-	VkApplicationInfo appInfo = {};
-	appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
-	appInfo.pApplicationName = name.c_str();
-	appInfo.pEngineName = name.c_str();
-	appInfo.apiVersion = apiVersion;
-	
-	vector<const char*>instanceExtensions = { VK_KHR_SURFACE_EXTENSION_NAME };
-
-	// ,   
-#if defined(_WIN32)
-	instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
-#endif
-
-	VkInstanceCreateInfo instanceCreateInfo = {};
-	instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
-	instanceCreateInfo.pNext = nullptr;
-	instanceCreateInfo.pApplicationInfo = &appInfo;
-
-	if(!instanceExtensions.empty())
-	{
-		if (settings.validation)
-			instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
-
-		instanceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(instanceExtensions.size());
-		instanceCreateInfo.ppEnabledExtensionNames = instanceExtensions.data();
-	}
-
-	if (settings.validation)
-	{
-		// The VK_LAYER_KHRONOS_validation contains all current validation functionality.
-		// Note that on Android this layer requires at least NDK r20
-		const char* validationLayerName = "VK_LAYER_KHRONOS_validation";
-		// Check if this layer is available at instance level
-		uint32_t instanceLayerCount;
-		vkEnumerateInstanceLayerProperties(&instanceLayerCount, nullptr);
-		std::vector<VkLayerProperties> instanceLayerProperties(instanceLayerCount);
-		vkEnumerateInstanceLayerProperties(&instanceLayerCount, instanceLayerProperties.data());
-		bool validationLayerPresent = false;
-		for (VkLayerProperties layer : instanceLayerProperties) {
-			if (strcmp(layer.layerName, validationLayerName) == 0) {
-				validationLayerPresent = true;
-				break;
-			}
-		}
-		if (validationLayerPresent) {
-			instanceCreateInfo.ppEnabledLayerNames = &validationLayerName;
-			instanceCreateInfo.enabledLayerCount = 1;
-		}
-		else {
-			std::cerr << "Validation layer VK_LAYER_KHRONOS_validation not present, validation is disabled";
-		}
-	}
-	return vkCreateInstance(&instanceCreateInfo, nullptr, &instance);
-}
-
-/***********************************************
- *	:			PrepareFrame()
- *	:			      
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::PrepareFrame()
-{
-	// Acquire the next image from the swap chain
-	VkResult result = swapChain.acquireNextImage(semaphores.presentComplete, &currentBuffer);
-	// Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE) or no longer optimal for presentation (SUBOPTIMAL)
-	if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) 
-		WindowResize();
-	else 
-		VK_CHECK_RESULT(result);
-}
-
-/***********************************************
- *	:			SubmitFrame()
- *	:			      
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::SubmitFrame()
-{
-	VkResult result = swapChain.queuePresent(queue, currentBuffer, semaphores.renderComplete);
-	if (!((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))) {
-		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-			// Swap chain is no longer compatible with the surface and needs to be recreated
-			WindowResize();
-			return;
-		}
-		else 
-			VK_CHECK_RESULT(result);
-	}
-	VK_CHECK_RESULT(vkQueueWaitIdle(queue));
-}
-
-/***********************************************
-*	:			RenderFrame()
-*	:			  
-*	 :	
-*	 :	
-**********************************************/
-void VulkanBase::RenderFrame()
-{
-	PrepareFrame();
-	submitInfo.commandBufferCount = 1;
-	submitInfo.pCommandBuffers = &drawCmdBuffers[currentBuffer];
-	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
-	SubmitFrame();
-}
-
-void VulkanBase::GetEnabledFeatures()
-{
-}
-
-void VulkanBase::BuildCommandBuffers()
-{
-}
-
-void VulkanBase::DrawUI(const VkCommandBuffer commandBuffer)
-{
-	if (settings.overlay) {
-		const VkViewport viewport = vks::initializers::viewport((float)width, (float)height, 0.0f, 1.0f);
-		const VkRect2D scissor = vks::initializers::rect2D(width, height, 0, 0);
-		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
-		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
-
-		UIOverlay.Draw(commandBuffer);
-	}
-}
-
-void VulkanBase::OnUpdateUIOverlay(vks::UIOverlay* overlay)
-{
-}
-
-/***********************************************
- *	:			prepare()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-string VulkanBase::GetShadersPath() const
-{
-	string tmp = getAssetPath() + "//shaders//" + shaderDir + "//";
-	return getAssetPath() + "//shaders//" + shaderDir + "//";
-}
-
-void VulkanBase::ViewChanged()
-{
-
-}
-
-void VulkanBase::MouseMoved(double x, double y, bool& handled)
-{
-}
-
-/***********************************************
- *	:			prepare()
- *	:			  
- *	 :	
- *	 :	
- **********************************************/
-void VulkanBase::prepare()
-{
-	InitSwapchain();
-	CreateCommandPool();
-	SetupSwapChain();
-	CreateCommandBuffers();
-	reateSynchronizationPrimitives();
-	SetupDepthStencil();
-	SetupRenderPass();
-	CreatePipelineCache();
-	SetupFrameBuffer();
-
-			string tmp = GetShadersPath() + "base//uioverlay.vert.spv";
-	if (settings.overlay) {
-		UIOverlay.device = vulkanDevice;
-		UIOverlay.queue = queue;
-		UIOverlay.shaders = {
-			LoadShader(GetShadersPath() + "base//uioverlay.vert.spv", VK_SHADER_STAGE_VERTEX_BIT),
-			LoadShader(GetShadersPath() + "base//uioverlay.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT),
-		};
-		UIOverlay.PrepareResources();
-		UIOverlay.PreparePipeline(pipelineCache, renderPass);
-	}
-}
-
-void VulkanBase::SetupDepthStencil()
-{
-	VkImageCreateInfo imageCI{};
-	imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-	imageCI.imageType = VK_IMAGE_TYPE_2D;
-	imageCI.format = depthFormat;
-	imageCI.extent = { width, height, 1 };
-	imageCI.mipLevels = 1;
-	imageCI.arrayLayers = 1;
-	imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
-	imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
-	imageCI.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-
-	VK_CHECK_RESULT(vkCreateImage(device, &imageCI, nullptr, &depthStencil.image));
-	VkMemoryRequirements memReqs{};
-	vkGetImageMemoryRequirements(device, depthStencil.image, &memReqs);
-
-	VkMemoryAllocateInfo memAllloc{};
-	memAllloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-	memAllloc.allocationSize = memReqs.size;
-	memAllloc.memoryTypeIndex = vulkanDevice->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-	VK_CHECK_RESULT(vkAllocateMemory(device, &memAllloc, nullptr, &depthStencil.mem));
-	VK_CHECK_RESULT(vkBindImageMemory(device, depthStencil.image, depthStencil.mem, 0));
-
-	VkImageViewCreateInfo imageViewCI{};
-	imageViewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-	imageViewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
-	imageViewCI.image = depthStencil.image;
-	imageViewCI.format = depthFormat;
-	imageViewCI.subresourceRange.baseMipLevel = 0;
-	imageViewCI.subresourceRange.levelCount = 1;
-	imageViewCI.subresourceRange.baseArrayLayer = 0;
-	imageViewCI.subresourceRange.layerCount = 1;
-	imageViewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-	// Stencil aspect should only be set on depth + stencil formats (VK_FORMAT_D16_UNORM_S8_UINT..VK_FORMAT_D32_SFLOAT_S8_UINT
-	if (depthFormat >= VK_FORMAT_D16_UNORM_S8_UINT) {
-		imageViewCI.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
-	}
-	VK_CHECK_RESULT(vkCreateImageView(device, &imageViewCI, nullptr, &depthStencil.view));
-}
-
-void VulkanBase::SetupFrameBuffer()
-{
-	VkImageView attachments[2];
-
-	// Depth/Stencil attachment is the same for all frame buffers
-	attachments[1] = depthStencil.view;
-
-	VkFramebufferCreateInfo frameBufferCreateInfo = {};
-	frameBufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
-	frameBufferCreateInfo.pNext = NULL;
-	frameBufferCreateInfo.renderPass = renderPass;
-	frameBufferCreateInfo.attachmentCount = 2;
-	frameBufferCreateInfo.pAttachments = attachments;
-	frameBufferCreateInfo.width = width;
-	frameBufferCreateInfo.height = height;
-	frameBufferCreateInfo.layers = 1;
-
-	// Create frame buffers for every swap chain image
-	frameBuffers.resize(swapChain.imageCount);
-	for (uint32_t i = 0; i < frameBuffers.size(); i++)
-	{
-		attachments[0] = swapChain.buffers[i].view;
-		VK_CHECK_RESULT(vkCreateFramebuffer(device, &frameBufferCreateInfo, nullptr, &frameBuffers[i]));
-	}
-}
-
-void VulkanBase::SetupRenderPass()
-{
-	std::array<VkAttachmentDescription, 2> attachments = {};
-	// Color attachment
-	attachments[0].format = swapChain.colorFormat;
-	attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
-	attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-	attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-	// Depth attachment
-	attachments[1].format = depthFormat;
-	attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
-	attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-	attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-	attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-	attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-	attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-	VkAttachmentReference colorReference = {};
-	colorReference.attachment = 0;
-	colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-	VkAttachmentReference depthReference = {};
-	depthReference.attachment = 1;
-	depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-	VkSubpassDescription subpassDescription = {};
-	subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-	subpassDescription.colorAttachmentCount = 1;
-	subpassDescription.pColorAttachments = &colorReference;
-	subpassDescription.pDepthStencilAttachment = &depthReference;
-	subpassDescription.inputAttachmentCount = 0;
-	subpassDescription.pInputAttachments = nullptr;
-	subpassDescription.preserveAttachmentCount = 0;
-	subpassDescription.pPreserveAttachments = nullptr;
-	subpassDescription.pResolveAttachments = nullptr;
-
-	// Subpass dependencies for layout transitions
-	std::array<VkSubpassDependency, 2> dependencies;
-
-	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-	dependencies[0].dstSubpass = 0;
-	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-	dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-	dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-	dependencies[1].srcSubpass = 0;
-	dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
-	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-	dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-	dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-	dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-	VkRenderPassCreateInfo renderPassInfo = {};
-	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
-	renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
-	renderPassInfo.pAttachments = attachments.data();
-	renderPassInfo.subpassCount = 1;
-	renderPassInfo.pSubpasses = &subpassDescription;
-	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
-	renderPassInfo.pDependencies = dependencies.data();
-
-	VK_CHECK_RESULT(vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass));
-}
-
-void VulkanBase::WindowResized()
-{
-}
+#include "VulkanBase.h"
+
+
+#include <iostream>
+#include <vector>
+
+#include "VulkanTools.h"
+
+/***********************************************
+ *	функция:			GetWindowTitle()
+ *	назначение:			формирование имени окна
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+string VulkanBase::GetWindowTitle()
+{
+	string device(deviceProperties.deviceName);
+	string windowTitle;
+
+	windowTitle = title + " - " + device;
+	if (!settings.overlay)
+		windowTitle += " - " + to_string(frameCounter) + " fps";
+	
+	return windowTitle;
+}
+
+void VulkanBase::WindowResize()
+{
+	if (!prepared)
+	{
+		return;
+	}
+	prepared = false;
+
+	// Ensure all operations on the device have been finished before destroying resources
+	vkDeviceWaitIdle(device);
+
+	// Recreate swap chain
+	width = destWidth;
+	height = destHeight;
+	SetupSwapChain();
+
+	// Recreate the frame buffers
+	vkDestroyImageView(device, depthStencil.view, nullptr);
+	vkDestroyImageView(device, depthStencil.depthView, nullptr);
+	vkDestroyImage(device, depthStencil.image, nullptr);
+	vulkanDevice->allocator.Free(depthStencil.mem);
+	SetupDepthStencil();
+	for (uint32_t i = 0; i < frameBuffers.size(); i++) {
+		vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
+	}
+	SetupFrameBuffer();
+
+	if ((width > 0.0f) && (height > 0.0f)) {
+		if (settings.overlay) {
+			//UIOverlay.resize(width, height);
+		}
+	}
+
+	// Command buffers need to be recreated as they may store
+	// references to the recreated frame buffer
+	// (the device is idle, so image fences from before the resize no longer matter)
+	DestroyCommandBuffers();
+	CreateCommandBuffers();
+	BuildCommandBuffers();
+
+	vkDeviceWaitIdle(device);
+
+	if ((width > 0.0f) && (height > 0.0f)) 
+		camera.UpdateAspectRatio(static_cast<float>(width) / static_cast<float>(height));
+
+	// Notify derived class
+	WindowResized();
+	ViewChanged();
+
+	prepared = true;
+}
+
+/***********************************************
+ *	функция:			HandleMouseMove()
+ *	назначение:			Отслеживание перемещения мыши
+ *	входящие значения:	x, y - координаты мыши
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::HandleMouseMove(int32_t x, int32_t y)
+{
+	int32_t dx = static_cast<int32_t>(mousePos.x) - x;
+	int32_t dy = static_cast<int32_t>(mousePos.y) - y;
+
+	bool handled = false;
+
+	if (settings.overlay) {
+		//ImGuiIO& io = ImGui::GetIO();
+		//handled = io.WantCaptureMouse;
+	}
+	MouseMoved(static_cast<float>(x), static_cast<float>(y), handled);
+
+	if (handled) 
+	{
+		mousePos = vec2(static_cast<float>(x), static_cast<float>(y));
+		return;
+	}
+
+	if (mouseButtons.left) 
+	{
+		camera.Rotate(vec3(dy * camera.rotationSpeed, -dx * camera.rotationSpeed, 0.0f));
+		viewUpdated = true;
+	}
+	if (mouseButtons.right) {
+		camera.Translate(vec3(-0.0f, 0.0f, dy * .005f));
+		viewUpdated = true;
+	}
+	if (mouseButtons.middle) 
+	{
+		camera.Translate(vec3(-dx * 0.01f, -dy * 0.01f, 0.0f));
+		viewUpdated = true;
+	}
+	mousePos = vec2(static_cast<float>(x), static_cast<float>(y));
+}
+
+/***********************************************
+ *	функция:			NextFrame()
+ *	назначение:			конструктор по умолчанию
+ *	входящие значения:	enableValidation разрешение проверки валидности
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::NextFrame()
+{
+	auto tStart = std::chrono::high_resolution_clock::now();
+	if (viewUpdated)
+	{
+		viewUpdated = false;
+		ViewChanged();
+	}
+
+	Render();
+	frameCounter++;
+	auto tEnd = std::chrono::high_resolution_clock::now();
+	auto tDiff = std::chrono::duration<double, std::milli>(tEnd - tStart).count();
+	frameTimer = (float)tDiff / 1000.0f;
+	camera.Update(frameTimer);
+	if (camera.moving())
+	{
+		viewUpdated = true;
+	}
+	// Convert to clamped timer value
+	if (!paused)
+	{
+		timer += timerSpeed * frameTimer;
+		if (timer > 1.0)
+		{
+			timer -= 1.0f;
+		}
+	}
+	float fpsTimer = (float)(std::chrono::duration<double, std::milli>(tEnd - lastTimestamp).count());
+	if (fpsTimer > 1000.0f)
+	{
+		lastFPS = static_cast<uint32_t>((float)frameCounter * (1000.0f / fpsTimer));
+#if defined(_WIN32)
+		if (!settings.overlay) {
+			string windowTitle = GetWindowTitle();
+			wstring newbuf = wstring(windowTitle.begin(), windowTitle.end());
+			SetWindowText(window, newbuf.c_str());
+		}
+#endif
+		frameCounter = 0;
+		lastTimestamp = tEnd;
+	}
+	UpdateOverlay();
+}
+
+/***********************************************
+ *	функция:			InitSwapchain()
+ *	назначение:			инициализация поверхности переключения
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::UpdateOverlay()
+{
+	if (!settings.overlay)
+		return;
+
+	ImGuiIO& io = ImGui::GetIO();
+
+	io.DisplaySize = ImVec2((float)width, (float)height);
+	io.DeltaTime = frameTimer;
+
+	io.MousePos = ImVec2(mousePos.x, mousePos.y);
+	io.MouseDown[0] = mouseButtons.left;
+	io.MouseDown[1] = mouseButtons.right;
+
+	ImGui::NewFrame();
+
+	ImGui::PushStyleVar(ImGuiStyleVar_WindowRounding, 0);
+	ImGui::SetNextWindowPos(ImVec2(10, 10));
+	//ImGuiSetCond_FirstUseEver to ImGuiCond_FirstUseEver
+	ImGui::SetNextWindowSize(ImVec2(0, 0), ImGuiCond_FirstUseEver);
+	ImGui::Begin("Vulkan Example", nullptr, ImGuiWindowFlags_AlwaysAutoResize | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+	ImGui::TextUnformatted(title.c_str());
+	ImGui::TextUnformatted(deviceProperties.deviceName);
+	ImGui::Text("%.2f ms/frame (%.1d fps)", (1000.0f / lastFPS), lastFPS);
+
+	ImGui::PushItemWidth(110.0f * UIOverlay.scale);
+	OnUpdateUIOverlay(&UIOverlay);
+	ImGui::PopItemWidth();
+
+	ImGui::End();
+	ImGui::PopStyleVar();
+	ImGui::Render();
+
+	// The overlay buffers and the pre-recorded draw command buffers are shared by all frames in flight,
+	// so they are only rewritten once the GPU has finished with every submitted frame
+	if (UIOverlay.Changed() || UIOverlay.updated) {
+		WaitFramesInFlight();
+		if (UIOverlay.Update() || UIOverlay.updated) {
+			BuildCommandBuffers();
+			UIOverlay.updated = false;
+		}
+	}
+}
+
+/***********************************************
+ *	функция:			WaitFramesInFlight()
+ *	назначение:			дождаться завершения всех отправленных кадров
+ *						(перед перезаписью ресурсов, общих для кадров)
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::WaitFramesInFlight()
+{
+	std::vector<VkFence> fences;
+	for (const auto& sync : frameSync)
+		fences.push_back(sync.fence);
+	if (!fences.empty())
+		VK_CHECK_RESULT(vkWaitForFences(device, static_cast<uint32_t>(fences.size()), fences.data(), VK_TRUE, UINT64_MAX));
+}
+
+/***********************************************
+ *	функция:			InitSwapchain()
+ *	назначение:			инициализация поверхности переключения
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::InitSwapchain()
+{
+#if defined(_WIN32)
+	swapChain.initSurface(windowInstance, window);
+#endif
+}
+
+/***********************************************
+ *	функция:			CreateCommandPool()
+ *	назначение:			Создание командного пула
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::CreateCommandPool()
+{
+	VkCommandPoolCreateInfo cmdPoolInfo = {};
+	cmdPoolInfo.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+	cmdPoolInfo.queueFamilyIndex = swapChain.queueNodeIndex;
+	cmdPoolInfo.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+	VK_CHECK_RESULT(vkCreateCommandPool(device, &cmdPoolInfo, nullptr, &cmdPool));
+}
+
+/***********************************************
+ *	функция:			SetupSwapChain()
+ *	назначение:			Создание поверхности переключения
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::SetupSwapChain()
+{
+	swapChain.create(&width, &height, settings.vsync);
+}
+
+/***********************************************
+ *	функция:			CreateCommandBuffers()
+ *	назначение:			Создание буффера команд
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::CreateCommandBuffers()
+{
+	// Create one command buffer for each swap chain image and reuse for rendering
+	drawCmdBuffers.resize(swapChain.imageCount);
+
+	VkCommandBufferAllocateInfo cmdBufAllocateInfo =
+		vks::initializers::commandBufferAllocateInfo(
+			cmdPool,
+			VK_COMMAND_BUFFER_LEVEL_PRIMARY,
+			static_cast<uint32_t>(drawCmdBuffers.size()));
+
+	VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, drawCmdBuffers.data()));
+
+	// Command buffers for samples that record every frame, one per frame in flight
+	frameCmdBuffers.resize(framesInFlight > 0 ? framesInFlight : 1);
+	cmdBufAllocateInfo.commandBufferCount = static_cast<uint32_t>(frameCmdBuffers.size());
+	VK_CHECK_RESULT(vkAllocateCommandBuffers(device, &cmdBufAllocateInfo, frameCmdBuffers.data()));
+
+	imageFences.assign(drawCmdBuffers.size(), VK_NULL_HANDLE);
+}
+
+/***********************************************
+ *	функция:			СreateSynchronizationPrimitives()
+ *	назначение:			Создание семафоров и ограждений
+ *						для каждого кадра в полете
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::СreateSynchronizationPrimitives()
+{
+	VkSemaphoreCreateInfo semaphoreCreateInfo = vks::initializers::semaphoreCreateInfo();
+	// Fences start signaled so the first wait on each frame returns immediately
+	VkFenceCreateInfo fenceCreateInfo = vks::initializers::fenceCreateInfo(VK_FENCE_CREATE_SIGNALED_BIT);
+	frameSync.resize(framesInFlight > 0 ? framesInFlight : 1);
+	for (auto& sync : frameSync) {
+		// Ensures that the image is displayed before we start submitting new commands to the queue
+		VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &sync.presentComplete));
+		// Ensures that the image is not presented until all commands have been submitted and executed
+		VK_CHECK_RESULT(vkCreateSemaphore(device, &semaphoreCreateInfo, nullptr, &sync.renderComplete));
+		VK_CHECK_RESULT(vkCreateFence(device, &fenceCreateInfo, nullptr, &sync.fence));
+	}
+	currentFrame = 0;
+}
+
+void VulkanBase::CreatePipelineCache()
+{
+	VkPipelineCacheCreateInfo pipelineCacheCreateInfo = {};
+	pipelineCacheCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+	VK_CHECK_RESULT(vkCreatePipelineCache(device, &pipelineCacheCreateInfo, nullptr, &pipelineCache));
+}
+
+/***********************************************
+ *	функция:			DestroyCommandBuffers()
+ *	назначение:			освобождение командного буфера
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::DestroyCommandBuffers()
+{
+	vkFreeCommandBuffers(device, cmdPool, static_cast<uint32_t>(drawCmdBuffers.size()), drawCmdBuffers.data());
+	vkFreeCommandBuffers(device, cmdPool, static_cast<uint32_t>(frameCmdBuffers.size()), frameCmdBuffers.data());
+}
+
+/***********************************************
+ *	функция:			VulkanBase()
+ *	назначение:			конструктор по умолчанию
+ *	входящие значения:	enableValidation разрешение проверки валидности
+ *	выходящие значения:	нет
+ **********************************************/
+VulkanBase::VulkanBase(bool enableValidation)
+{
+	struct stat info;
+
+	if(stat(getAssetPath().c_str(), &info) != 0)
+	{
+		
+	}
+	SetupConsole("Vulkan validation output");
+}
+
+/***********************************************
+ *	функция:			~VulkanBase()
+ *	назначение:			деструктор 
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+VulkanBase::~VulkanBase()
+{
+	// Frames in flight may still be executing
+	vkDeviceWaitIdle(device);
+
+	// Clean up Vulkan resources
+	swapChain.cleanup();
+	if (descriptorPool != VK_NULL_HANDLE)
+	{
+		vkDestroyDescriptorPool(device, descriptorPool, nullptr);
+	}
+	DestroyCommandBuffers();
+	vkDestroyRenderPass(device, renderPass, nullptr);
+	for (uint32_t i = 0; i < frameBuffers.size(); i++)
+	{
+		vkDestroyFramebuffer(device, frameBuffers[i], nullptr);
+	}
+
+	for (auto& shaderModule : shaderModules)
+	{
+		vkDestroyShaderModule(device, shaderModule, nullptr);
+	}
+	vkDestroyImageView(device, depthStencil.view, nullptr);
+	vkDestroyImageView(device, depthStencil.depthView, nullptr);
+	vkDestroyImage(device, depthStencil.image, nullptr);
+	vulkanDevice->allocator.Free(depthStencil.mem);
+
+	vkDestroyPipelineCache(device, pipelineCache, nullptr);
+
+	vkDestroyCommandPool(device, cmdPool, nullptr);
+
+	for (auto& sync : frameSync) {
+		vkDestroySemaphore(device, sync.presentComplete, nullptr);
+		vkDestroySemaphore(device, sync.renderComplete, nullptr);
+		vkDestroyFence(device, sync.fence, nullptr);
+	}
+
+	if (settings.overlay) {
+		UIOverlay.FreeResources();
+	}
+
+	delete vulkanDevice;
+
+	if (settings.validation)
+	{
+		//vks::Debug::freeDebugCallback(instance);
+	}
+
+	vkDestroyInstance(instance, nullptr);
+}
+
+/***********************************************
+ *	функция:			LoadShader()
+ *	назначение:			формирование шейдеров 
+ *	входящие значения:	fileName - имя файла
+ *						stage - флаги формирования
+ *	выходящие значения:	нет
+ **********************************************/
+VkPipelineShaderStageCreateInfo VulkanBase::LoadShader(string fileName, VkShaderStageFlagBits stage)
+{
+	VkPipelineShaderStageCreateInfo shaderStage = {};
+	shaderStage.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+	shaderStage.stage = stage;
+	shaderStage.module = vks::tools::LoadShader(fileName.c_str(), device);
+	shaderStage.pName = "main";
+	assert(shaderStage.module != VK_NULL_HANDLE);
+	shaderModules.push_back(shaderStage.module);
+	return shaderStage;
+}
+
+/***********************************************
+ *	функция:			HandleMessage()
+ *	назначение:			обработчик сообщений программы 
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::HandleMessage(HWND hWnd, UINT uMsg, WPARAM wParam, LPARAM lParam)
+{
+	switch (uMsg)
+	{
+	case WM_CLOSE:
+		prepared = false;
+		DestroyWindow(hWnd);
+		PostQuitMessage(0);
+		break;
+
+	case WM_SIZE:
+		if ((prepared) && (wParam != SIZE_MINIMIZED))
+		{
+			if ((resizing) || ((wParam == SIZE_MAXIMIZED) || (wParam == SIZE_RESTORED)))
+			{
+				destWidth = LOWORD(lParam);
+				destHeight = HIWORD(lParam);
+				WindowResize();
+			}
+		}
+		break;
+
+	case WM_LBUTTONDOWN:
+		mousePos = vec2((float)LOWORD(lParam), (float)HIWORD(lParam));
+		mouseButtons.left = true;
+		break;
+	case WM_RBUTTONDOWN:
+		mousePos = vec2((float)LOWORD(lParam), (float)HIWORD(lParam));
+		mouseButtons.right = true;
+		break;
+	case WM_MBUTTONDOWN:
+		mousePos = vec2((float)LOWORD(lParam), (float)HIWORD(lParam));
+		mouseButtons.middle = true;
+		break;
+	case WM_LBUTTONUP:
+		mouseButtons.left = false;
+		break;
+	case WM_RBUTTONUP:
+		mouseButtons.right = false;
+		break;
+	case WM_MBUTTONUP:
+		mouseButtons.middle = false;
+		break;
+	case WM_MOUSEWHEEL:
+	{
+		short wheelDelta = GET_WHEEL_DELTA_WPARAM(wParam);
+		camera.Translate(glm::vec3(0.0f, 0.0f, (float)wheelDelta * 0.005f));
+		viewUpdated = true;
+		break;
+	}
+		
+		case WM_MOUSEMOVE:
+			HandleMouseMove(LOWORD(lParam), HIWORD(lParam));
+		break;
+
+		case WM_ENTERSIZEMOVE:
+			resizing = true;
+			break;
+		case WM_EXITSIZEMOVE:
+			resizing = false;
+			break;
+	}
+
+}
+
+/***********************************************
+ *	функция:			SetupWindow()
+ *	назначение:			создание окна 
+ *	входящие значения:	hInstance - экземпляр приложения
+ *						wndProc - функция обратного вызова
+ *	выходящие значения:	window - хэндл созданного окна
+ **********************************************/
+HWND VulkanBase::SetupWindow(HINSTANCE hInstance, WNDPROC wndProc)
+{
+	windowInstance = hInstance;
+
+	WNDCLASSEX wndClass;
+
+	wndClass.cbSize = sizeof(WNDCLASSEX);
+	wndClass.style = CS_HREDRAW | CS_VREDRAW;
+	wndClass.lpfnWndProc = wndProc;
+	wndClass.cbClsExtra = 0;
+	wndClass.cbWndExtra = 0;
+	wndClass.hInstance = hInstance;
+	wndClass.hIcon = LoadIcon(nullptr, IDI_APPLICATION);
+	wndClass.hCursor = LoadCursor(nullptr, IDC_ARROW);
+	wndClass.hbrBackground = (HBRUSH)GetStockObject(BLACK_BRUSH);
+	wndClass.lpszMenuName = nullptr;
+	wstring newbuf = wstring(name.begin(), name.end());
+	wndClass.lpszClassName = newbuf.c_str();
+	wndClass.hIconSm = LoadIcon(nullptr, IDI_WINLOGO);
+
+	if(!RegisterClassEx(&wndClass))
+	{
+		cout << "Невозможно зарегистрировать класс окна!\n";
+		fflush(stdout);
+		exit(1);
+	}
+
+	int screenWidth = GetSystemMetrics(SM_CXSCREEN);
+	int screenHeight = GetSystemMetrics(SM_CYSCREEN);
+
+	if(settings.fullscreen)
+	{
+		DEVMODE dmScreenSettings;
+		memset(&dmScreenSettings, 0, sizeof(dmScreenSettings));
+		dmScreenSettings.dmSize = sizeof(dmScreenSettings);
+		dmScreenSettings.dmPelsWidth = screenWidth;
+		dmScreenSettings.dmPelsHeight = screenHeight;
+		dmScreenSettings.dmBitsPerPel = 32;
+		dmScreenSettings.dmFields = DM_BITSPERPEL | DM_PELSWIDTH | DM_PELSHEIGHT;
+
+		if((width != static_cast<uint32_t>(screenWidth)) && (height != static_cast<uint32_t>(screenHeight)))
+		{
+			if (ChangeDisplaySettings(&dmScreenSettings, CDS_FULLSCREEN) != DISP_CHANGE_SUCCESSFUL)
+			{
+				if (MessageBox(nullptr, L"Полноэкранный режим не поддерживается!\n Переключиться в оконный режим?", L"Error", MB_YESNO | MB_ICONEXCLAMATION) == IDYES)
+				{
+					settings.fullscreen = false;
+				}
+				else
+					return nullptr;
+			}
+		}
+	}
+
+	DWORD dwExStyle;
+	DWORD dwStyle;
+
+	if (settings.fullscreen)
+	{
+		dwExStyle = WS_EX_APPWINDOW;
+		dwStyle = WS_POPUP | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+	}
+	else
+	{
+		dwExStyle = WS_EX_APPWINDOW | WS_EX_WINDOWEDGE;
+		dwStyle = WS_OVERLAPPEDWINDOW | WS_CLIPSIBLINGS | WS_CLIPCHILDREN;
+	}
+
+	RECT windowRect;
+	windowRect.left = 0L;
+	windowRect.top = 0L;
+	windowRect.right = settings.fullscreen ? (long)screenWidth : (long)width;
+	windowRect.bottom = settings.fullscreen ? (long)screenHeight : (long)height;
+
+	AdjustWindowRectEx(&windowRect, dwStyle, FALSE, dwExStyle);
+
+	string windowTitle = GetWindowTitle();
+	wstring newbufTitle = wstring(windowTitle.begin(), windowTitle.end());
+	
+	window = CreateWindowEx(0,
+		newbuf.c_str(),
+		newbufTitle.c_str(),
+		dwStyle | WS_CLIPSIBLINGS | WS_CLIPCHILDREN,
+		0,
+		0,
+		windowRect.right - windowRect.left,
+		windowRect.bottom - windowRect.top,
+		nullptr,
+		nullptr,
+		hInstance,
+		nullptr);
+
+	if (!settings.fullscreen)
+	{
+		// Center on screen
+		uint32_t x = (GetSystemMetrics(SM_CXSCREEN) - windowRect.right) / 2;
+		uint32_t y = (GetSystemMetrics(SM_CYSCREEN) - windowRect.bottom) / 2;
+		SetWindowPos(window, 0, x, y, 0, 0, SWP_NOZORDER | SWP_NOSIZE);
+	}
+
+	if (!window)
+	{
+		printf("Не удалось создать окно!\n");
+		fflush(stdout);
+		return nullptr;
+	}
+
+	ShowWindow(window, SW_SHOW);
+	SetForegroundWindow(window);
+	SetFocus(window);
+	
+	return window;
+}
+
+/***********************************************
+ *	функция:			RenderLoop()
+ *	назначение:			основной цикл программы
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::RenderLoop()
+{
+	destWidth = width;
+	destHeight = height;
+	lastTimestamp = chrono::high_resolution_clock::now();
+
+#if defined(_WIN32)
+	MSG msg;
+	bool quitMessageReceived = false;
+	while (!quitMessageReceived) {
+		while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE)) {
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+			if (msg.message == WM_QUIT) {
+				quitMessageReceived = true;
+				break;
+			}
+		}
+		if (prepared && !IsIconic(window)) {
+			NextFrame();
+		}
+	}
+#endif
+
+}
+
+/***********************************************
+ *	функция:			SetupConsole()
+ *	назначение:			инициализация консоли
+ *	входящие значения:	title - заголовок консоли
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::SetupConsole(string title)
+{
+	AllocConsole();
+	AttachConsole(GetCurrentProcessId());
+	FILE* stream;
+	freopen_s(&stream, "CONOUT$", "w+", stdout);
+	freopen_s(&stream, "CONOUT$", "w+", stderr);
+
+	wstring newbuf = wstring(title.begin(), title.end());
+	SetConsoleTitle(newbuf.c_str());
+
+	setlocale(LC_ALL, "Russian");
+}
+
+/***********************************************
+ *	функция:			InitVulkan()
+ *	назначение:			инициализация Vulkan
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+bool VulkanBase::InitVulkan()
+{
+	VkResult err = CreateInstance(settings.validation);
+	if(err)
+	{
+		vks::tools::exitFatal("Нельзя создать экземпляр Vulkan : \n" + vks::tools::errorString(err), err);
+		return false;
+	}
+
+	// Physical device
+	uint32_t gpuCount = 0;
+	// Get number of available physical devices
+	VK_CHECK_RESULT(vkEnumeratePhysicalDevices(instance, &gpuCount, nullptr));
+	assert(gpuCount > 0);
+	// Enumerate devices
+	vector<VkPhysicalDevice> physicalDevices(gpuCount);
+	err = vkEnumeratePhysicalDevices(instance, &gpuCount, physicalDevices.data());
+	if (err) {
+		vks::tools::exitFatal("Could not enumerate physical devices : \n" + vks::tools::errorString(err), err);
+		return false;
+	}
+
+	// Select physical device to be used for the Vulkan example
+	// Defaults to the first device unless specified by command line
+	uint32_t selectedDevice = 0;
+	physicalDevice = physicalDevices[selectedDevice];
+
+	// Store properties (including limits), features and memory properties of the physical device (so that examples can check against them)
+	vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+	vkGetPhysicalDeviceFeatures(physicalDevice, &deviceFeatures);
+	vkGetPhysicalDeviceMemoryProperties(physicalDevice, &deviceMemoryProperties);
+
+	// Derived examples can override this to set actual features (based on above readings) to enable for logical device creation
+	GetEnabledFeatures();
+
+	// Vulkan device creation
+	// This is handled by a separate class that gets a logical device representation
+	// and encapsulates functions related to a device
+	vulkanDevice = new vks::VulkanDevice(physicalDevice);
+	VkResult res = vulkanDevice->createLogicalDevice(enabledFeatures, enabledDeviceExtensions, deviceCreatepNextChain);
+	if (res != VK_SUCCESS) {
+		vks::tools::exitFatal("Could not create Vulkan device: \n" + vks::tools::errorString(res), res);
+		return false;
+	}
+	device = vulkanDevice->logicalDevice;
+	// Models, morph blenders and crowds size their per-frame regions from this value
+	vulkanDevice->framesInFlight = framesInFlight > 0 ? framesInFlight : 1;
+		
+	// Get a graphics queue from the device
+	vkGetDeviceQueue(device, vulkanDevice->queueFamilyIndices.graphics, 0, &queue);
+
+	// Find a suitable depth format
+	VkBool32 validDepthFormat = vks::tools::getSupportedDepthFormat(physicalDevice, &depthFormat);
+	assert(validDepthFormat);
+
+	swapChain.connect(instance, physicalDevice, device);
+
+	// Set up submit info structure
+	// Semaphores of the current frame in flight are set in PrepareFrame
+	// Command buffer submission info is set by each example
+	submitInfo = vks::initializers::submitInfo();
+	submitInfo.pWaitDstStageMask = &submitPipelineStages;
+	submitInfo.waitSemaphoreCount = 1;
+	submitInfo.signalSemaphoreCount = 1;
+	return true;
+}
+
+/***********************************************
+ *	функция:			CreateInstance()
+ *	назначение:			создание экземпляра Vulkan
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+VkResult VulkanBase::CreateInstance(bool validation)
+{
+	this->settings.validation = validation;
+	
+	VkApplicationInfo appInfo = {};
+	appInfo.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+	appInfo.pApplicationName = name.c_str();
+	appInfo.pEngineName = name.c_str();
+	appInfo.apiVersion = apiVersion;
+	
+	vector<const char*>instanceExtensions = { VK_KHR_SURFACE_EXTENSION_NAME };
+
+	//разрешить поверхность, зависящую от системы
+#if defined(_WIN32)
+	instanceExtensions.push_back(VK_KHR_WIN32_SURFACE_EXTENSION_NAME);
+#endif
+
+	VkInstanceCreateInfo instanceCreateInfo = {};
+	instanceCreateInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+	instanceCreateInfo.pNext = nullptr;
+	instanceCreateInfo.pApplicationInfo = &appInfo;
+
+	if(!instanceExtensions.empty())
+	{
+		if (settings.validation)
+			instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
+
+		instanceCreateInfo.enabledExtensionCount = static_cast<uint32_t>(instanceExtensions.size());
+		instanceCreateInfo.ppEnabledExtensionNames = instanceExtensions.data();
+	}
+
+	if (settings.validation)
+	{
+		// The VK_LAYER_KHRONOS_validation contains all current validation functionality.
+		// Note that on Android this layer requires at least NDK r20
+		const char* validationLayerName = "VK_LAYER_KHRONOS_validation";
+		// Check if this layer is available at instance level
+		uint32_t instanceLayerCount;
+		vkEnumerateInstanceLayerProperties(&instanceLayerCount, nullptr);
+		std::vector<VkLayerProperties> instanceLayerProperties(instanceLayerCount);
+		vkEnumerateInstanceLayerProperties(&instanceLayerCount, instanceLayerProperties.data());
+		bool validationLayerPresent = false;
+		for (VkLayerProperties layer : instanceLayerProperties) {
+			if (strcmp(layer.layerName, validationLayerName) == 0) {
+				validationLayerPresent = true;
+				break;
+			}
+		}
+		if (validationLayerPresent) {
+			instanceCreateInfo.ppEnabledLayerNames = &validationLayerName;
+			instanceCreateInfo.enabledLayerCount = 1;
+		}
+		else {
+			std::cerr << "Validation layer VK_LAYER_KHRONOS_validation not present, validation is disabled";
+		}
+	}
+	return vkCreateInstance(&instanceCreateInfo, nullptr, &instance);
+}
+
+/***********************************************
+ *	функция:			PrepareFrame()
+ *	назначение:			подготовка следующего изображения для переключения свопа 
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::PrepareFrame()
+{
+	// Wait until the GPU has finished the frame that last used this slot, its per-frame resources may be reused after that
+	FrameSync& sync = frameSync[currentFrame];
+	VK_CHECK_RESULT(vkWaitForFences(device, 1, &sync.fence, VK_TRUE, UINT64_MAX));
+
+	// Acquire the next image from the swap chain
+	VkResult result = swapChain.acquireNextImage(sync.presentComplete, &currentBuffer);
+	// Recreate the swapchain if it's no longer compatible with the surface (OUT_OF_DATE) or no longer optimal for presentation (SUBOPTIMAL)
+	if ((result == VK_ERROR_OUT_OF_DATE_KHR) || (result == VK_SUBOPTIMAL_KHR)) 
+		WindowResize();
+	else 
+		VK_CHECK_RESULT(result);
+
+	// The pre-recorded command buffer of this image may still be executing for an older frame
+	if (imageFences[currentBuffer] != VK_NULL_HANDLE && imageFences[currentBuffer] != sync.fence)
+		VK_CHECK_RESULT(vkWaitForFences(device, 1, &imageFences[currentBuffer], VK_TRUE, UINT64_MAX));
+	imageFences[currentBuffer] = sync.fence;
+
+	submitInfo.pWaitSemaphores = &sync.presentComplete;
+	submitInfo.pSignalSemaphores = &sync.renderComplete;
+}
+
+/***********************************************
+ *	функция:			SubmitFrame()
+ *	назначение:			представление текущего изображения для переключения свопа 
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::SubmitFrame()
+{
+	// An empty submission signals the frame fence once everything submitted so far has completed,
+	// so samples are free to submit their own work without passing the fence
+	FrameSync& sync = frameSync[currentFrame];
+	VK_CHECK_RESULT(vkResetFences(device, 1, &sync.fence));
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 0, nullptr, sync.fence));
+
+	// The CPU continues with the next frame in flight instead of waiting for the queue to go idle
+	currentFrame = (currentFrame + 1) % static_cast<uint32_t>(frameSync.size());
+
+	VkResult result = swapChain.queuePresent(queue, currentBuffer, sync.renderComplete);
+	if (!((result == VK_SUCCESS) || (result == VK_SUBOPTIMAL_KHR))) {
+		if (result == VK_ERROR_OUT_OF_DATE_KHR) {
+			// Swap chain is no longer compatible with the surface and needs to be recreated
+			WindowResize();
+			return;
+		}
+		else 
+			VK_CHECK_RESULT(result);
+	}
+}
+
+/***********************************************
+*	функция:			RenderFrame()
+*	назначение:			создание буферов 
+*	входящие значения:	нет
+*	выходящие значения:	нет
+**********************************************/
+void VulkanBase::RenderFrame()
+{
+	PrepareFrame();
+	submitInfo.commandBufferCount = 1;
+	submitInfo.pCommandBuffers = &drawCmdBuffers[currentBuffer];
+	VK_CHECK_RESULT(vkQueueSubmit(queue, 1, &submitInfo, VK_NULL_HANDLE));
+	SubmitFrame();
+}
+
+/***********************************************
+ *	функция:			GetEnabledFeatures()
+ *	назначение:			включить необязательные возможности, которыми
+ *						пользуется непрямая отрисовка моделей, если
+ *						устройство их поддерживает (переопределение
+ *						должно вызвать базовую функцию)
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::GetEnabledFeatures()
+{
+	//несколько команд в одном vkCmdDrawIndexedIndirect
+	enabledFeatures.multiDrawIndirect = deviceFeatures.multiDrawIndirect;
+	//номер DrawData в firstInstance непрямой команды
+	enabledFeatures.drawIndirectFirstInstance = deviceFeatures.drawIndirectFirstInstance;
+}
+
+void VulkanBase::BuildCommandBuffers()
+{
+}
+
+void VulkanBase::DrawUI(const VkCommandBuffer commandBuffer)
+{
+	if (settings.overlay) {
+		const VkViewport viewport = vks::initializers::viewport((float)width, (float)height, 0.0f, 1.0f);
+		const VkRect2D scissor = vks::initializers::rect2D(width, height, 0, 0);
+		vkCmdSetViewport(commandBuffer, 0, 1, &viewport);
+		vkCmdSetScissor(commandBuffer, 0, 1, &scissor);
+
+		UIOverlay.Draw(commandBuffer);
+	}
+}
+
+void VulkanBase::OnUpdateUIOverlay(vks::UIOverlay* overlay)
+{
+}
+
+/***********************************************
+ *	функция:			prepare()
+ *	назначение:			создание буферов 
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+string VulkanBase::GetShadersPath() const
+{
+	string tmp = getAssetPath() + "//shaders//" + shaderDir + "//";
+	return getAssetPath() + "//shaders//" + shaderDir + "//";
+}
+
+void VulkanBase::ViewChanged()
+{
+
+}
+
+void VulkanBase::MouseMoved(double x, double y, bool& handled)
+{
+}
+
+/***********************************************
+ *	функция:			prepare()
+ *	назначение:			создание буферов 
+ *	входящие значения:	нет
+ *	выходящие значения:	нет
+ **********************************************/
+void VulkanBase::prepare()
+{
+	InitSwapchain();
+	CreateCommandPool();
+	SetupSwapChain();
+	CreateCommandBuffers();
+	СreateSynchronizationPrimitives();
+	SetupDepthStencil();
+	SetupRenderPass();
+	CreatePipelineCache();
+	SetupFrameBuffer();
+
+			string tmp = GetShadersPath() + "base//uioverlay.vert.spv";
+	if (settings.overlay) {
+		UIOverlay.device = vulkanDevice;
+		UIOverlay.queue = queue;
+		UIOverlay.shaders = {
+			LoadShader(GetShadersPath() + "base//uioverlay.vert.spv", VK_SHADER_STAGE_VERTEX_BIT),
+			LoadShader(GetShadersPath() + "base//uioverlay.frag.spv", VK_SHADER_STAGE_FRAGMENT_BIT),
+		};
+		UIOverlay.PrepareResources();
+		UIOverlay.PreparePipeline(pipelineCache, renderPass);
+	}
+}
+
+void VulkanBase::SetupDepthStencil()
+{
+	VkImageCreateInfo imageCI{};
+	imageCI.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+	imageCI.imageType = VK_IMAGE_TYPE_2D;
+	imageCI.format = depthFormat;
+	imageCI.extent = { width, height, 1 };
+	imageCI.mipLevels = 1;
+	imageCI.arrayLayers = 1;
+	imageCI.samples = VK_SAMPLE_COUNT_1_BIT;
+	imageCI.tiling = VK_IMAGE_TILING_OPTIMAL;
+	imageCI.usage = VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+	// Sampled usage lets compute passes read the depth buffer after rendering,
+	// only requested on demand and if the format supports sampling with optimal tiling
+	bool sampled = false;
+	if (settings.sampledDepth) {
+		VkFormatProperties formatProperties;
+		vkGetPhysicalDeviceFormatProperties(physicalDevice, depthFormat, &formatProperties);
+		sampled = (formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT) != 0;
+	}
+	if (sampled) {
+		imageCI.usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+	}
+
+	VK_CHECK_RESULT(vkCreateImage(device, &imageCI, nullptr, &depthStencil.image));
+	VK_CHECK_RESULT(vulkanDevice->allocator.AllocateImage(depthStencil.image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, depthStencil.mem));
+
+	VkImageViewCreateInfo imageViewCI{};
+	imageViewCI.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+	imageViewCI.viewType = VK_IMAGE_VIEW_TYPE_2D;
+	imageViewCI.image = depthStencil.image;
+	imageViewCI.format = depthFormat;
+	imageViewCI.subresourceRange.baseMipLevel = 0;
+	imageViewCI.subresourceRange.levelCount = 1;
+	imageViewCI.subresourceRange.baseArrayLayer = 0;
+	imageViewCI.subresourceRange.layerCount = 1;
+	imageViewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+	// Stencil aspect should only be set on depth + stencil formats (VK_FORMAT_D16_UNORM_S8_UINT..VK_FORMAT_D32_SFLOAT_S8_UINT
+	if (depthFormat >= VK_FORMAT_D16_UNORM_S8_UINT) {
+		imageViewCI.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
+	}
+	VK_CHECK_RESULT(vkCreateImageView(device, &imageViewCI, nullptr, &depthStencil.view));
+
+	// Only a single aspect may be sampled
+	depthStencil.depthView = VK_NULL_HANDLE;
+	if (sampled) {
+		imageViewCI.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
+		VK_CHECK_RESULT(vkCreateImageView(device, &imageViewCI, nullptr, &depthStencil.depthView));
+	}
+}
+
+void VulkanBase::SetupFrameBuffer()
+{
+	VkImageView attachments[2];
+
+	// Depth/Stencil attachment is the same for all frame buffers
+	attachments[1] = depthStencil.view;
+
+	VkFramebufferCreateInfo frameBufferCreateInfo = {};
+	frameBufferCreateInfo.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+	frameBufferCreateInfo.pNext = NULL;
+	frameBufferCreateInfo.renderPass = renderPass;
+	frameBufferCreateInfo.attachmentCount = 2;
+	frameBufferCreateInfo.pAttachments = attachments;
+	frameBufferCreateInfo.width = width;
+	frameBufferCreateInfo.height = height;
+	frameBufferCreateInfo.layers = 1;
+
+	// Create frame buffers for every swap chain image
+	frameBuffers.resize(swapChain.imageCount);
+	for (uint32_t i = 0; i < frameBuffers.size(); i++)
+	{
+		attachments[0] = swapChain.buffers[i].view;
+		VK_CHECK_RESULT(vkCreateFramebuffer(device, &frameBufferCreateInfo, nullptr, &frameBuffers[i]));
+	}
+}
+
+void VulkanBase::SetupRenderPass()
+{
+	std::array<VkAttachmentDescription, 2> attachments = {};
+	// Color attachment
+	attachments[0].format = swapChain.colorFormat;
+	attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
+	attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+	attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
+	// Depth attachment
+	attachments[1].format = depthFormat;
+	attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
+	attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+	attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+	attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+	attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+	attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+	VkAttachmentReference colorReference = {};
+	colorReference.attachment = 0;
+	colorReference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+	VkAttachmentReference depthReference = {};
+	depthReference.attachment = 1;
+	depthReference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+
+	VkSubpassDescription subpassDescription = {};
+	subpassDescription.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+	subpassDescription.colorAttachmentCount = 1;
+	subpassDescription.pColorAttachments = &colorReference;
+	subpassDescription.pDepthStencilAttachment = &depthReference;
+	subpassDescription.inputAttachmentCount = 0;
+	subpassDescription.pInputAttachments = nullptr;
+	subpassDescription.preserveAttachmentCount = 0;
+	subpassDescription.pPreserveAttachments = nullptr;
+	subpassDescription.pResolveAttachments = nullptr;
+
+	// Subpass dependencies for layout transitions
+	std::array<VkSubpassDependency, 2> dependencies;
+
+	dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[0].dstSubpass = 0;
+	dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+	dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+	dependencies[1].srcSubpass = 0;
+	dependencies[1].dstSubpass = VK_SUBPASS_EXTERNAL;
+	dependencies[1].srcStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
+	dependencies[1].dstStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
+	dependencies[1].srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+	dependencies[1].dstAccessMask = VK_ACCESS_MEMORY_READ_BIT;
+	dependencies[1].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
+
+	VkRenderPassCreateInfo renderPassInfo = {};
+	renderPassInfo.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+	renderPassInfo.attachmentCount = static_cast<uint32_t>(attachments.size());
+	renderPassInfo.pAttachments = attachments.data();
+	renderPassInfo.subpassCount = 1;
+	renderPassInfo.pSubpasses = &subpassDescription;
+	renderPassInfo.dependencyCount = static_cast<uint32_t>(dependencies.size());
+	renderPassInfo.pDependencies = dependencies.data();
+
+	VK_CHECK_RESULT(vkCreateRenderPass(device, &renderPassInfo, nullptr, &renderPass));
+}
+
+void VulkanBase::WindowResized()
+{
+}
@@ -1,87 +1,99 @@
-#pragma once
-
-#include <fstream>
-#include <stdlib.h>
-#include <string>
-#include <vector>
-
-#include "vulkan/vulkan.h"
-
-#include <ktx.h>
-#include <ktxvulkan.h>
-
-#include "VulkanBuffer.h"
-#include "VulkanDevice.h"
-#include "VulkanTools.h"
-
-//using namespace std;
-
-namespace vks
-{
-	class Texture
-	{
-	public:
-		VulkanDevice* device;
-		VkImage               image;
-		VkImageLayout         imageLayout;
-		VkDeviceMemory        deviceMemory;
-		VkImageView           view;
-		uint32_t              width, height;
-		uint32_t              mipLevels;
-		uint32_t              layerCount;
-		VkDescriptorImageInfo descriptor;
-		VkSampler             sampler;
-
-		void      UpdateDescriptor();
-		void      Destroy();
-		ktxResult LoadKTXFile(std::string filename, ktxTexture** target);
-	};
-
-	class Texture2D : public Texture
-	{
-	public:
-		void LoadFromFile(
-			std::string        filename,
-			VkFormat           format,
-			vks::VulkanDevice* device,
-			VkQueue            copyQueue,
-			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
-			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
-			bool               forceLinear = false);
-		void FromBuffer(
-			void* buffer,
-			VkDeviceSize       bufferSize,
-			VkFormat           format,
-			uint32_t           texWidth,
-			uint32_t           texHeight,
-			vks::VulkanDevice* device,
-			VkQueue            copyQueue,
-			VkFilter           filter = VK_FILTER_LINEAR,
-			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
-			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-	};
-
-	class Texture2DArray : public Texture
-	{
-	public:
-		void LoadFromFile(
-			std::string        filename,
-			VkFormat           format,
-			vks::VulkanDevice* device,
-			VkQueue            copyQueue,
-			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
-			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-	};
-
-	class TextureCubeMap : public Texture
-	{
-	public:
-		void LoadFromFile(
-			std::string        filename,
-			VkFormat           format,
-			vks::VulkanDevice* device,
-			VkQueue            copyQueue,
-			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
-			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-	};
-}
+#pragma once
+
+#include <fstream>
+#include <stdlib.h>
+#include <string>
+#include <vector>
+
+#include "vulkan/vulkan.h"
+
+#include <ktx.h>
+#include <ktxvulkan.h>
+
+#include "VulkanBuffer.h"
+#include "VulkanDevice.h"
+#include "VulkanTools.h"
+
+//using namespace std;
+
+namespace vks
+{
+	class Texture
+	{
+	public:
+		VulkanDevice* device;
+		VkImage               image;
+		VkImageLayout         imageLayout;
+		Allocation            deviceMemory;
+		VkImageView           view;
+		uint32_t              width, height;
+		uint32_t              mipLevels;
+		uint32_t              layerCount;
+		VkDescriptorImageInfo descriptor;
+		VkSampler             sampler;
+
+		void      UpdateDescriptor();
+		void      Destroy();
+		ktxResult LoadKTXFile(std::string filename, ktxTexture** target);
+	};
+
+	class Texture2D : public Texture
+	{
+	public:
+		void LoadFromFile(
+			std::string        filename,
+			VkFormat           format,
+			vks::VulkanDevice* device,
+			VkQueue            copyQueue,
+			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+			bool               forceLinear = false);
+		void FromBuffer(
+			void* buffer,
+			VkDeviceSize       bufferSize,
+			VkFormat           format,
+			uint32_t           texWidth,
+			uint32_t           texHeight,
+			vks::VulkanDevice* device,
+			VkQueue            copyQueue,
+			VkFilter           filter = VK_FILTER_LINEAR,
+			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	};
+
+	class Texture2DArray : public Texture
+	{
+	public:
+		void LoadFromFile(
+			std::string        filename,
+			VkFormat           format,
+			vks::VulkanDevice* device,
+			VkQueue            copyQueue,
+			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		void FromBuffer(
+			void* buffer,
+			VkDeviceSize       bufferSize,
+			VkFormat           format,
+			uint32_t           texWidth,
+			uint32_t           texHeight,
+			uint32_t           texLayerCount,
+			vks::VulkanDevice* device,
+			VkQueue            copyQueue,
+			VkFilter           filter = VK_FILTER_NEAREST,
+			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	};
+
+	class TextureCubeMap : public Texture
+	{
+	public:
+		void LoadFromFile(
+			std::string        filename,
+			VkFormat           format,
+			vks::VulkanDevice* device,
+			VkQueue            copyQueue,
+			VkImageUsageFlags  imageUsageFlags = VK_IMAGE_USAGE_SAMPLED_BIT,
+			VkImageLayout      imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+	};
+}
@@ -35,6 +35,12 @@ namespace vks
 		int32_t vertexCount = 0;
 		int32_t indexCount = 0;
 
+		// Draw data of the current frame and of the last upload, unchanged frames skip the upload
+		std::vector<uint8_t> vertexData;
+		std::vector<uint8_t> indexData;
+		std::vector<uint8_t> uploadedVertexData;
+		std::vector<uint8_t> uploadedIndexData;
+
 		std::vector<VkPipelineShaderStageCreateInfo> shaders;
 
 		VkDescriptorPool descriptorPool;
@@ -43,7 +49,7 @@ namespace vks
 		VkPipelineLayout pipelineLayout;
 		VkPipeline pipeline;
 
-		VkDeviceMemory fontMemory = VK_NULL_HANDLE;
+		Allocation fontMemory;
 		VkImage fontImage = VK_NULL_HANDLE;
 		VkImageView fontView = VK_NULL_HANDLE;
 		VkSampler sampler;
@@ -63,6 +69,7 @@ namespace vks
 		void PreparePipeline(const VkPipelineCache pipelineCache, const VkRenderPass renderPass);
 		void PrepareResources();
 
+		bool Changed();
 		bool Update();
 		void Draw(const VkCommandBuffer commandBuffer);
 		void Resize(uint32_t width, uint32_t height);
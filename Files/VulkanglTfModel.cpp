@@ -1,1594 +1,3265 @@
-#include "VulkanglTfModel.h"
-
-
-VkDescriptorSetLayout vkglTF::descriptorSetLayoutImage = VK_NULL_HANDLE;
-VkDescriptorSetLayout vkglTF::descriptorSetLayoutUbo = VK_NULL_HANDLE;
-VkMemoryPropertyFlags vkglTF::memoryPropertyFlags = 0;
-
-bool loadImageDataFuncEmpty(tinygltf::Image* image, const int imageIndex, string* error, string* warning, int req_width, int req_height, const unsigned char* bytes, int size, void* userData)
-{
-	// This function will be used for samples that don't require images to be loaded
-	return true;
-}
-
-bool loadImageDataFunc(tinygltf::Image* image, const int imageIndex, string* error, string* warning, int req_width, int req_height, const unsigned char* bytes, int size, void* userData)
-{
-	// KTX files will be handled by our own code
-	if (image->uri.find_last_of(".") != std::string::npos) {
-		if (image->uri.substr(image->uri.find_last_of(".") + 1) == "ktx") {
-			return true;
-		}
-	}
-
-	return LoadImageData(image, imageIndex, error, warning, req_width, req_height, bytes, size, userData);
-}
-
-namespace vkglTF
-{
-	/***********************************************
-	 *	:			loadImage()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	Texture* Model::GetTexture(uint32_t index)
-	{
-		return nullptr;
-	}
-	
-	Model::Model()
-	{
-		
-	}
-	
-	Model::~Model()
-	{
-	}
-
-	/***********************************************
-	 *	:			LoadNode()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	void Model::LoadNode(Node* parent, const tinygltf::Node& node, uint32_t nodeIndex, const tinygltf::Model& model, vector<uint32_t>
-	                     & indexBuffer, vector<Vertex>& vertexBuffer, float globalScale)
-	{
-		Node* newNode = new Node{};
-		newNode->index = nodeIndex;
-		newNode->parent = parent;
-		newNode->name = node.name;
-		newNode->skinIndex = node.skin;
-		newNode->matrix = mat4(1.0f);
-
-		//    
-		vec3 translation = vec3(0.0f);
-		if(node.translation.size() == 3)
-		{
-			translation = make_vec3(node.translation.data());
-			newNode->rotation = translation;
-		}
-
-		mat4 rotation = mat4(1.0f);
-		if(node.rotation.size() == 4)
-		{
-			quat q = make_quat(node.translation.data());
-			newNode->rotation = mat4(q);
-		}
-
-		vec3 scale = vec3(1.0f);
-		if(node.scale.size() == 3)
-		{
-			scale = make_vec3(node.scale.data());
-			newNode->scale = scale;
-		}
-
-		if(node.matrix.size() == 16)
-		{
-			newNode->matrix = make_mat4x4(node.matrix.data());
-			if(globalScale != 1.0f)
-			{
-				//
-			}
-		}
-
-		if(node.children.size() > 0)
-		{
-			for (auto i = 0; i < node.children.size(); i++)
-				LoadNode(newNode, model.nodes[node.children[i]], node.children[i], model, indexBuffer, vertexBuffer, globalScale);
-			
-		}
-
-		if(node.mesh > -1)
-		{
-			const tinygltf::Mesh mesh = model.meshes[node.mesh];
-			Mesh* newMesh = new Mesh(device, newNode->matrix);
-			newMesh->name = mesh.name;
-
-			for (size_t j=0; j<mesh.primitives.size(); j++)
-			{
-				const tinygltf::Primitive& primitive = mesh.primitives[j];
-
-				if (primitive.indices < 0)
-					continue;
-
-				uint32_t indexStart = static_cast<uint32_t>(indexBuffer.size());
-				uint32_t vertexStart = static_cast<uint32_t>(vertexBuffer.size());
-
-				uint32_t indexCount = 0;
-				uint32_t vertexCount = 0;
-
-				vec3 posMin{};
-				vec3 posMax{};
-				bool hasSkin = false;
-				//
-				{
-					const float* bufferPos = nullptr;
-					const float* bufferNormals = nullptr;
-					const float* bufferTexCoords = nullptr;
-					const float* bufferColors = nullptr;
-					const float* bufferTangents = nullptr;
-					uint32_t numColorComponents;
-					const uint16_t* bufferJoints = nullptr;
-					const float* bufferWeights = nullptr;
-
-					//  
-					assert(primitive.attributes.find("POSITION") != primitive.attributes.end());
-
-					const tinygltf::Accessor& posAccessor = model.accessors[primitive.attributes.find("POSITION")->second];
-					const tinygltf::BufferView& posView = model.bufferViews[posAccessor.bufferView];
-					bufferPos = reinterpret_cast<const float*>(&(model.buffers[posView.buffer].data[posAccessor.byteOffset + posView.byteOffset]));
-					posMin = glm::vec3(posAccessor.minValues[0], posAccessor.minValues[1], posAccessor.minValues[2]);
-					posMax = glm::vec3(posAccessor.maxValues[0], posAccessor.maxValues[1], posAccessor.maxValues[2]);
-
-					if (primitive.attributes.find("NORMAL") != primitive.attributes.end()) {
-						const tinygltf::Accessor& normAccessor = model.accessors[primitive.attributes.find("NORMAL")->second];
-						const tinygltf::BufferView& normView = model.bufferViews[normAccessor.bufferView];
-						bufferNormals = reinterpret_cast<const float*>(&(model.buffers[normView.buffer].data[normAccessor.byteOffset + normView.byteOffset]));
-					}
-
-					if (primitive.attributes.find("TEXCOORD_0") != primitive.attributes.end()) {
-						const tinygltf::Accessor& uvAccessor = model.accessors[primitive.attributes.find("TEXCOORD_0")->second];
-						const tinygltf::BufferView& uvView = model.bufferViews[uvAccessor.bufferView];
-						bufferTexCoords = reinterpret_cast<const float*>(&(model.buffers[uvView.buffer].data[uvAccessor.byteOffset + uvView.byteOffset]));
-					}
-
-					if (primitive.attributes.find("COLOR_0") != primitive.attributes.end())
-					{
-						const tinygltf::Accessor& colorAccessor = model.accessors[primitive.attributes.find("COLOR_0")->second];
-						const tinygltf::BufferView& colorView = model.bufferViews[colorAccessor.bufferView];
-						// Color buffer are either of type vec3 or vec4
-						numColorComponents = colorAccessor.type == TINYGLTF_PARAMETER_TYPE_FLOAT_VEC3 ? 3 : 4;
-						bufferColors = reinterpret_cast<const float*>(&(model.buffers[colorView.buffer].data[colorAccessor.byteOffset + colorView.byteOffset]));
-					}
-
-					if (primitive.attributes.find("TANGENT") != primitive.attributes.end())
-					{
-						const tinygltf::Accessor& tangentAccessor = model.accessors[primitive.attributes.find("TANGENT")->second];
-						const tinygltf::BufferView& tangentView = model.bufferViews[tangentAccessor.bufferView];
-						bufferTangents = reinterpret_cast<const float*>(&(model.buffers[tangentView.buffer].data[tangentAccessor.byteOffset + tangentView.byteOffset]));
-					}
-
-					// Skinning
-					// Joints
-					if (primitive.attributes.find("JOINTS_0") != primitive.attributes.end()) {
-						const tinygltf::Accessor& jointAccessor = model.accessors[primitive.attributes.find("JOINTS_0")->second];
-						const tinygltf::BufferView& jointView = model.bufferViews[jointAccessor.bufferView];
-						bufferJoints = reinterpret_cast<const uint16_t*>(&(model.buffers[jointView.buffer].data[jointAccessor.byteOffset + jointView.byteOffset]));
-					}
-
-					if (primitive.attributes.find("WEIGHTS_0") != primitive.attributes.end()) {
-						const tinygltf::Accessor& uvAccessor = model.accessors[primitive.attributes.find("WEIGHTS_0")->second];
-						const tinygltf::BufferView& uvView = model.bufferViews[uvAccessor.bufferView];
-						bufferWeights = reinterpret_cast<const float*>(&(model.buffers[uvView.buffer].data[uvAccessor.byteOffset + uvView.byteOffset]));
-					}
-
-					hasSkin = (bufferJoints && bufferWeights);
-
-					vertexCount = static_cast<uint32_t>(posAccessor.count);
-					
-					for(size_t v=0; v<posAccessor.count; v++)
-					{
-						Vertex vert{};
-						vert.pos = vec4(make_vec3(&bufferPos[v * 3]), 1.0f);
-
-						if(bufferColors)
-						{
-							switch (numColorComponents)
-							{
-							case 3:
-								vert.color = glm::vec4(glm::make_vec3(&bufferColors[v * 3]), 1.0f);
-								break;
-								
-							case 4:
-								vert.color = glm::make_vec4(&bufferColors[v * 4]);
-							}
-						}
-						else
-							vert.color = vec4(1.0f);
-						
-						vert.tangent = bufferTangents ? vec4(make_vec4(&bufferTangents[v * 4])) : vec4(0.0f);
-						vert.joint0 = hasSkin ? vec4(make_vec4(&bufferJoints[v * 4])) : vec4(0.0f);
-						vert.weight0 = hasSkin ? make_vec4(&bufferWeights[v * 4]) : vec4(0.0f);
-						vertexBuffer.push_back(vert);
-					}
-				}
-				//
-				{
-					const tinygltf::Accessor& accessor = model.accessors[primitive.indices];
-					const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
-					const tinygltf::Buffer& buffer = model.buffers[bufferView.buffer];
-
-					indexCount = static_cast<uint32_t>(accessor.count);
-
-					uint32_t* buf;
-					uint16_t* buf1;
-					uint8_t* buf2;
-					
-					switch (accessor.componentType)
-					{
-					case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT:
-						buf = new uint32_t[accessor.count];
-
-						memcpy(buf, &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(uint16_t));
-						for (size_t index = 0; index < accessor.count; index++)
-							indexBuffer.push_back(buf[index] + vertexStart);
-						break;
-
-					case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
-						buf1 = new uint16_t[accessor.count];
-
-						memcpy(buf1, &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(uint16_t));
-						for (size_t index = 0; index < accessor.count; index++)
-							indexBuffer.push_back(buf1[index] + vertexStart);
-						break;
-
-					case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE:
-						buf2 = new uint8_t[accessor.count];
-
-						memcpy(buf2, &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(uint16_t));
-						for (size_t index = 0; index < accessor.count; index++)
-							indexBuffer.push_back(buf2[index] + vertexStart);
-						break;
-
-					default:
-						std::cerr << "Index component type " << accessor.componentType << " not supported!" << std::endl;
-						return;
-					}
-				}
-				Primitive* newPrimitive = new Primitive(indexStart, indexCount, primitive.material > -1 ? materials[primitive.material] : materials.back());
-				newPrimitive->firstVertex = vertexStart;
-				newPrimitive->vertexCount = vertexCount;
-				newPrimitive->SetDimensions(posMin, posMax);
-				newMesh->primitives.push_back(newPrimitive);
-			}
-			newNode->mesh = newMesh;
-		}
-		if (parent)
-			parent->children.push_back(newNode);
-		else
-			nodes.push_back(newNode);
-
-		linearNodes.push_back(newNode);
-	}
-	
-	/***********************************************
-	 *	:			loadImage()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	void Model::LoadSkins(tinygltf::Model& gltfModel)
-	{
-		for (tinygltf::Skin& source : gltfModel.skins) {
-			Skin* newSkin = new Skin{};
-			newSkin->name = source.name;
-
-			// Find skeleton root node
-			if (source.skeleton > -1) {
-				newSkin->skeletonRoot = nodeFromIndex(source.skeleton);
-			}
-
-			// Find joint nodes
-			for (int jointIndex : source.joints) {
-				Node* node = nodeFromIndex(jointIndex);
-				if (node) {
-					newSkin->joints.push_back(nodeFromIndex(jointIndex));
-				}
-			}
-
-			// Get inverse bind matrices from buffer
-			if (source.inverseBindMatrices > -1) {
-				const tinygltf::Accessor& accessor = gltfModel.accessors[source.inverseBindMatrices];
-				const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
-				const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
-				newSkin->inverseBindMatrices.resize(accessor.count);
-				memcpy(newSkin->inverseBindMatrices.data(), &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(glm::mat4));
-			}
-
-			skins.push_back(newSkin);
-		}
-	}
-	
-	/***********************************************
-	 *	:			loadImage()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	void Model::loadImage(tinygltf::Model& gltfModel, VulkanDevice* device, VkQueue transferQueue)
-	{
-		for(tinygltf::Image &image: gltfModel.images)
-		{
-			Texture texture;
-			texture.FromglTfImage(image, path, device, transferQueue);
-			textures.push_back(texture);
-		}
-	}
-	
-	/***********************************************
-	 *	:			LoadMaterials()
-	 *	:			  
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	void Model::LoadMaterials(tinygltf::Model& gltfModel)
-	{
-		for (tinygltf::Material& mat: gltfModel.materials)
-		{
-			Material material(device);
-			if (mat.values.find("baseColorTexture") != mat.values.end())
-				material.baseColorTexture = GetTexture(gltfModel.textures[mat.values["baseColorTexture"].TextureIndex()].source);
-
-			// Metallic roughness workflow
-			if (mat.values.find("metallicRoughnessTexture") != mat.values.end()) {
-				material.metallicRoughnessTexture = GetTexture(gltfModel.textures[mat.values["metallicRoughnessTexture"].TextureIndex()].source);
-			}
-			if (mat.values.find("roughnessFactor") != mat.values.end()) {
-				material.roughnessFactor = static_cast<float>(mat.values["roughnessFactor"].Factor());
-			}
-			if (mat.values.find("metallicFactor") != mat.values.end()) {
-				material.metallicFactor = static_cast<float>(mat.values["metallicFactor"].Factor());
-			}
-			if (mat.values.find("baseColorFactor") != mat.values.end()) {
-				material.baseColorFactor = glm::make_vec4(mat.values["baseColorFactor"].ColorFactor().data());
-			}
-			if (mat.additionalValues.find("normalTexture") != mat.additionalValues.end()) {
-				material.normalTexture = GetTexture(gltfModel.textures[mat.additionalValues["normalTexture"].TextureIndex()].source);
-			}
-			if (mat.additionalValues.find("emissiveTexture") != mat.additionalValues.end()) {
-				material.emissiveTexture = GetTexture(gltfModel.textures[mat.additionalValues["emissiveTexture"].TextureIndex()].source);
-			}
-			if (mat.additionalValues.find("occlusionTexture") != mat.additionalValues.end()) {
-				material.occlusionTexture = GetTexture(gltfModel.textures[mat.additionalValues["occlusionTexture"].TextureIndex()].source);
-			}
-			if (mat.additionalValues.find("alphaMode") != mat.additionalValues.end()) {
-				tinygltf::Parameter param = mat.additionalValues["alphaMode"];
-				if (param.string_value == "BLEND") {
-					material.alphaMode = Material::ALPHAMODE_BLEND;
-				}
-				if (param.string_value == "MASK") {
-					material.alphaMode = Material::ALPHAMODE_MASK;
-				}
-			}
-			if (mat.additionalValues.find("alphaCutoff") != mat.additionalValues.end()) {
-				material.alphaCutoff = static_cast<float>(mat.additionalValues["alphaCutoff"].Factor());
-			}
-
-			materials.push_back(material);
-		}
-		// Push a default material at the end of the list for meshes with no material assigned
-		materials.push_back(Material(device));
-	}
-	
-	void Model::LoadAnimations(tinygltf::Model& gltfModel)
-	{
-		for (tinygltf::Animation& anim : gltfModel.animations)
-		{
-			Animation animation{};
-			animation.name = anim.name;
-			if (anim.name.empty()) 
-				animation.name = std::to_string(animations.size());
-
-			// Samplers
-			for (auto& samp : anim.samplers)
-			{
-				AnimationSampler sampler{};
-
-				if (samp.interpolation == "LINEAR") 
-					sampler.interpolation = AnimationSampler::InterpolationType::LINEAR;
-				
-				if (samp.interpolation == "STEP") 
-					sampler.interpolation = AnimationSampler::InterpolationType::STEP;
-				
-				if (samp.interpolation == "CUBICSPLINE") 
-					sampler.interpolation = AnimationSampler::InterpolationType::CUBICSPLINE;
-
-				// Read sampler input time values
-				{
-					const tinygltf::Accessor& accessor = gltfModel.accessors[samp.input];
-					const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
-					const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
-
-					assert(accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT);
-
-					float* buf = new float[accessor.count];
-					memcpy(buf, &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(float));
-					for (size_t index = 0; index < accessor.count; index++) {
-						sampler.inputs.push_back(buf[index]);
-					}
-
-					for (auto input : sampler.inputs) 
-					{
-						if (input < animation.start) 
-							animation.start = input;
-						
-						if (input > animation.end) 
-							animation.end = input;
-					}
-				}
-
-				// Read sampler output T/R/S values 
-				{
-					const tinygltf::Accessor& accessor = gltfModel.accessors[samp.output];
-					const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
-					const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
-
-					assert(accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT);
-
-					switch (accessor.type) {
-					case TINYGLTF_TYPE_VEC3: {
-						glm::vec3* buf = new glm::vec3[accessor.count];
-						memcpy(buf, &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(glm::vec3));
-						for (size_t index = 0; index < accessor.count; index++) {
-							sampler.outputsVec4.push_back(glm::vec4(buf[index], 0.0f));
-						}
-						break;
-					}
-					case TINYGLTF_TYPE_VEC4: {
-						glm::vec4* buf = new glm::vec4[accessor.count];
-						memcpy(buf, &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(glm::vec4));
-						for (size_t index = 0; index < accessor.count; index++) {
-							sampler.outputsVec4.push_back(buf[index]);
-						}
-						break;
-					}
-					default: {
-						std::cout << "unknown type" << std::endl;
-						break;
-					}
-					}
-				}
-				animation.samplers.push_back(sampler);
-			}
-			
-			// Channels
-			for (auto& source : anim.channels) {
-				AnimationChannel channel{};
-
-				if (source.target_path == "rotation") {
-					channel.path = AnimationChannel::PathType::ROTATION;
-				}
-				if (source.target_path == "translation") {
-					channel.path = AnimationChannel::PathType::TRANSLATION;
-				}
-				if (source.target_path == "scale") {
-					channel.path = AnimationChannel::PathType::SCALE;
-				}
-				if (source.target_path == "weights") {
-					std::cout << "weights not yet supported, skipping channel" << std::endl;
-					continue;
-				}
-				channel.samplerIndex = source.sampler;
-				channel.node = nodeFromIndex(source.target_node);
-				if (!channel.node) {
-					continue;
-				}
-
-				animation.channels.push_back(channel);
-			}
-
-			animations.push_back(animation);
-		}
-	}
-
-	/***********************************************
-	 *	:			LoadFromFile()
-	 *	:			   
-	 *	 :	
-	 *	 :	
-	 **********************************************/
-	void Model::LoadFromFile(string filename, VulkanDevice* device, VkQueue transferQueue, uint32_t fileLoadingFlags, float scale)
-	{
-		tinygltf::Model gltfModel;
-		tinygltf::TinyGLTF gltfContext;
-
-		if (fileLoadingFlags & FileLoadingFlags::DontLoadImages)
-			gltfContext.SetImageLoader(loadImageDataFuncEmpty, nullptr);
-		else
-			gltfContext.SetImageLoader(loadImageDataFunc, nullptr);
-
-		size_t pos = filename.find_last_of('/');
-		path = filename.substr(0, pos);
-		
-		string error, warning;
-
-		this->device = device;
-
-		bool fileLoaded = gltfContext.LoadASCIIFromFile(&gltfModel, &error, &warning, filename);
-
-		vector<uint32_t>indexBuffer;
-		vector<Vertex>vertexBuffer;
-
-		if(fileLoaded)
-		{
-			if (!(fileLoadingFlags & FileLoadingFlags::DontLoadImages))
-				loadImage(gltfModel, device, transferQueue);
-
-			LoadMaterials(gltfModel);
-
-			const tinygltf::Scene& scene = gltfModel.scenes[gltfModel.defaultScene > -1 ? gltfModel.defaultScene : 0];
-
-			for (size_t i=0; i<scene.nodes.size(); i++)
-			{
-				const tinygltf::Node node = gltfModel.nodes[scene.nodes[i]];
-				LoadNode(nullptr, node, scene.nodes[i], gltfModel, indexBuffer, vertexBuffer, scale);
-			}
-			
-			if (!gltfModel.animations.empty())
-				LoadAnimations(gltfModel);
-
-			LoadSkins(gltfModel);
-
-			for(auto node: linearNodes)
-			{
-				// 
-				if (node->skinIndex > -1)
-					node->skin = skins[node->skinIndex];
-
-				if (node->mesh)
-					node->Update();
-			}
-		}
-		else
-		{
-			tools::exitFatal("   glTF  \"" + filename + "\": " + error, -1);
-			return;
-		}
-
-		if((fileLoadingFlags & PreTransformVertices) || (fileLoadingFlags & PreMultiplyVertexColors) || (fileLoadingFlags & FlipY))
-		{
-			const bool preTransform = fileLoadingFlags & PreTransformVertices;
-			const bool preMultiplyColor = fileLoadingFlags & PreMultiplyVertexColors;
-			const bool flipY = fileLoadingFlags & FlipY;
-			for (Node* node : linearNodes) 
-			{
-				if (node->mesh) 
-				{
-					const mat4 localMatrix = node->getMatrix();
-					for (Primitive* primitive : node->mesh->primitives) 
-					{
-						for (uint32_t i = 0; i < primitive->vertexCount; i++) 
-						{
-							Vertex& vertex = vertexBuffer[primitive->firstVertex + i];
-							// Pre-transform vertex positions by node-hierarchy
-							if (preTransform) 
-							{
-								vertex.pos = vec3(localMatrix * vec4(vertex.pos, 1.0f));
-								vertex.normal = normalize(mat3(localMatrix) * vertex.normal);
-							}
-							// Flip Y-Axis of vertex positions
-							if (flipY) 
-							{
-								vertex.pos.y *= -1.0f;
-								vertex.normal.y *= -1.0f;
-							}
-							// Pre-Multiply vertex colors with material base color
-							if (preMultiplyColor) 
-								vertex.color = primitive->material.baseColorFactor * vertex.color;
-						}
-					}
-				}
-			}
-		}
-
-		for (auto extension : gltfModel.extensionsUsed) 
-		{
-			if (extension == "KHR_materials_pbrSpecularGlossiness") 
-			{
-				std::cout << "Required extension: " << extension;
-				metallicRoughnessWorkflow = false;
-			}
-		}
-
-		size_t vertexBufferSize = vertexBuffer.size() * sizeof(Vertex);
-		size_t indexBufferSize = indexBuffer.size() * sizeof(uint32_t);
-		indices.count = static_cast<uint32_t>(indexBuffer.size());
-		vertices.count = static_cast<uint32_t>(vertexBuffer.size());
-
-		assert((vertexBufferSize > 0) && (indexBufferSize > 0));
-
-		struct StagingBuffer {
-			VkBuffer buffer;
-			VkDeviceMemory memory;
-		} vertexStaging, indexStaging;
-
-		// Create staging buffers
-		// Vertex data
-		VK_CHECK_RESULT(device->createBuffer(
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			vertexBufferSize,
-			&vertexStaging.buffer,
-			&vertexStaging.memory,
-			vertexBuffer.data()));
-		// Index data
-		VK_CHECK_RESULT(device->createBuffer(
-			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			indexBufferSize,
-			&indexStaging.buffer,
-			&indexStaging.memory,
-			indexBuffer.data()));
-
-		// Create device local buffers
-		// Vertex buffer
-		VK_CHECK_RESULT(device->createBuffer(
-			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | memoryPropertyFlags,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			vertexBufferSize,
-			&vertices.buffer,
-			&vertices.memory));
-		// Index buffer
-		VK_CHECK_RESULT(device->createBuffer(
-			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | memoryPropertyFlags,
-			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-			indexBufferSize,
-			&indices.buffer,
-			&indices.memory));
-
-		// Copy from staging buffers
-		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-		VkBufferCopy copyRegion = {};
-
-		copyRegion.size = vertexBufferSize;
-		vkCmdCopyBuffer(copyCmd, vertexStaging.buffer, vertices.buffer, 1, &copyRegion);
-
-		copyRegion.size = indexBufferSize;
-		vkCmdCopyBuffer(copyCmd, indexStaging.buffer, indices.buffer, 1, &copyRegion);
-
-		device->flushCommandBuffer(copyCmd, transferQueue, true);
-
-		vkDestroyBuffer(device->logicalDevice, vertexStaging.buffer, nullptr);
-		vkFreeMemory(device->logicalDevice, vertexStaging.memory, nullptr);
-		vkDestroyBuffer(device->logicalDevice, indexStaging.buffer, nullptr);
-		vkFreeMemory(device->logicalDevice, indexStaging.memory, nullptr);
-
-		GetSceneDimensions();
-
-		// Setup descriptors
-		uint32_t uboCount{ 0 };
-		uint32_t imageCount{ 0 };
-		for (auto node : linearNodes) {
-			if (node->mesh) {
-				uboCount++;
-			}
-		}
-		for (auto material : materials) {
-			if (material.baseColorTexture != nullptr) {
-				imageCount++;
-			}
-		}
-		std::vector<VkDescriptorPoolSize> poolSizes = {
-			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, uboCount },
-		};
-		if (imageCount > 0) {
-			poolSizes.push_back({ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageCount });
-		}
-		VkDescriptorPoolCreateInfo descriptorPoolCI{};
-		descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
-		descriptorPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
-		descriptorPoolCI.pPoolSizes = poolSizes.data();
-		descriptorPoolCI.maxSets = uboCount + imageCount;
-		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolCI, nullptr, &descriptorPool));
-
-		// Descriptors for per-node uniform buffers
-		{
-			// Layout is global, so only create if it hasn't already been created before
-			if (descriptorSetLayoutUbo == VK_NULL_HANDLE) {
-				std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
-					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 0),
-				};
-				VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
-				descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-				descriptorLayoutCI.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
-				descriptorLayoutCI.pBindings = setLayoutBindings.data();
-				VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayoutUbo));
-			}
-			for (auto node : nodes) {
-				prepareNodeDescriptor(node, descriptorSetLayoutUbo);
-			}
-		}
-
-		// Descriptors for per-material images
-		{
-			// Layout is global, so only create if it hasn't already been created before
-			if (descriptorSetLayoutImage == VK_NULL_HANDLE) {
-				std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
-					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 0),
-				};
-				VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
-				descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
-				descriptorLayoutCI.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
-				descriptorLayoutCI.pBindings = setLayoutBindings.data();
-				VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayoutImage));
-			}
-			for (auto& material : materials) {
-				if (material.baseColorTexture != nullptr) {
-					material.CreateDescriptorSet(descriptorPool, vkglTF::descriptorSetLayoutImage);
-				}
-			}
-		}
-	}
-	
-	/***********************************************
-	 *	:			BindBuffers()
-	 *	:			 
-	 *	 :	commandBuffer -  
-	 *	 :	
-	 **********************************************/
-	void Model::BindBuffers(VkCommandBuffer commandBuffer)
-	{
-		const VkDeviceSize offset[1] = { 0 };
-		vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertices.buffer, offset);
-		vkCmdBindIndexBuffer(commandBuffer, indices.buffer, 0, VK_INDEX_TYPE_UINT32);
-		buffersBound = true;
-	}
-	
-	/***********************************************
-	 *	:			DrawNode()
-	 *	:			  
-	 *	 :	index -  
-	 *						parent - ,   
-	 *	 :	
-	 **********************************************/
-	void Model::DrawNode(Node* node, VkCommandBuffer commandBuffer, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet)
-	{
-		if(node->mesh)
-		{
-			for(Primitive* primitive: node->mesh->primitives)
-			{
-				if (renderFlags & vkglTF::RenderFlag::BindImages)
-					vkCmdBindDescriptorSets(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindImageSet, 1, &primitive->material.descriptorSet, 0, nullptr);
-
-				vkCmdDrawIndexed(commandBuffer, primitive->indexCount, 1, primitive->firstIndex, 0, 0);
-			}
-		}
-		for (auto& child : node->children)
-			DrawNode(child, commandBuffer);
-	}
-	
-	/***********************************************
-	 *	:			draw()
-	 *	:			 
-	 *	 :	index -  
-	 *						parent - ,   
-	 *	 :	
-	 **********************************************/
-	void Model::draw(VkCommandBuffer commandBuffer, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet)
-	{
-		if (!buffersBound)
-		{
-			const VkDeviceSize offset[1] = { 0 };
-			vkCmdBindVertexBuffers(commandBuffer, 0, 1, &vertices.buffer, offset);
-			vkCmdBindIndexBuffer(commandBuffer, indices.buffer, 0, VK_INDEX_TYPE_UINT32);
-		}
-		for (auto& node : nodes)
-			DrawNode(node, commandBuffer, renderFlags, pipelineLayout, bindImageSet);
-	}
-	
-	/***********************************************
-	 *	:			GetNodeDimensions()
-	 *	:			  
-	 *	 :	index -  
-	 *						parent - ,   
-	 *	 :	
-	 **********************************************/
-	void Model::GetNodeDimensions(Node* node, vec3& min, vec3& max)
-	{
-		if (node->mesh) {
-			for (Primitive* primitive : node->mesh->primitives) {
-				glm::vec4 locMin = glm::vec4(primitive->dimensions.min, 1.0f) * node->getMatrix();
-				glm::vec4 locMax = glm::vec4(primitive->dimensions.max, 1.0f) * node->getMatrix();
-				if (locMin.x < min.x) { min.x = locMin.x; }
-				if (locMin.y < min.y) { min.y = locMin.y; }
-				if (locMin.z < min.z) { min.z = locMin.z; }
-				if (locMax.x > max.x) { max.x = locMax.x; }
-				if (locMax.y > max.y) { max.y = locMax.y; }
-				if (locMax.z > max.z) { max.z = locMax.z; }
-			}
-		}
-		for (auto child : node->children) {
-			GetNodeDimensions(child, min, max);
-		}
-	}
-	
-	/***********************************************
-	 *	:			GetSceneDimensions()
-	 *	:			  
-	 *	 :	index -  
-	 *						parent - ,   
-	 *	 :	
-	 **********************************************/
-	void Model::GetSceneDimensions()
-	{
-		dimensions.min = vec3(FLT_MAX);
-		dimensions.max = vec3(-FLT_MAX);
-		for (auto node : nodes) {
-			GetNodeDimensions(node, dimensions.min, dimensions.max);
-		}
-		dimensions.size = dimensions.max - dimensions.min;
-		dimensions.center = (dimensions.min + dimensions.max) / 2.0f;
-		dimensions.radius = glm::distance(dimensions.min, dimensions.max) / 2.0f;
-	}
-	
-	/***********************************************
-	 *	:			GetSceneDimensions()
-	 *	:			  
-	 *	 :	index -  
-	 *						parent - ,   
-	 *	 :	
-	 **********************************************/
-	void Model::UpdateAnimation(uint32_t index, float time)
-	{
-		if (index > static_cast<uint32_t>(animations.size()) - 1) {
-			std::cout << "No animation with index " << index << std::endl;
-			return;
-		}
-		Animation& animation = animations[index];
-
-		bool updated = false;
-		for (auto& channel : animation.channels)
-		{
-			AnimationSampler& sampler = animation.samplers[channel.samplerIndex];
-			if (sampler.inputs.size() > sampler.outputsVec4.size())
-				continue;
-
-			for (auto i = 0; i < sampler.inputs.size() - 1; i++)
-			{
-				if ((time >= sampler.inputs[i]) && (time <= sampler.inputs[i + 1])) {
-					float u = std::max(0.0f, time - sampler.inputs[i]) / (sampler.inputs[i + 1] - sampler.inputs[i]);
-					if (u <= 1.0f) {
-						switch (channel.path) {
-						case vkglTF::AnimationChannel::PathType::TRANSLATION: {
-							glm::vec4 trans = glm::mix(sampler.outputsVec4[i], sampler.outputsVec4[i + 1], u);
-							channel.node->translation = glm::vec3(trans);
-							break;
-						}
-						case vkglTF::AnimationChannel::PathType::SCALE: {
-							glm::vec4 trans = glm::mix(sampler.outputsVec4[i], sampler.outputsVec4[i + 1], u);
-							channel.node->scale = glm::vec3(trans);
-							break;
-						}
-						case vkglTF::AnimationChannel::PathType::ROTATION: {
-							glm::quat q1;
-							q1.x = sampler.outputsVec4[i].x;
-							q1.y = sampler.outputsVec4[i].y;
-							q1.z = sampler.outputsVec4[i].z;
-							q1.w = sampler.outputsVec4[i].w;
-							glm::quat q2;
-							q2.x = sampler.outputsVec4[i + 1].x;
-							q2.y = sampler.outputsVec4[i + 1].y;
-							q2.z = sampler.outputsVec4[i + 1].z;
-							q2.w = sampler.outputsVec4[i + 1].w;
-							channel.node->rotation = glm::normalize(glm::slerp(q1, q2, u));
-							break;
-						}
-						}
-						updated = true;
-					}
-				}
-			}
-		}
-
-		if (updated) 
-		{
-			for (auto& node : nodes) 
-				node->Update();
-		}
-	}
-	
-	/***********************************************
-	 *	:			FindNode()
-	 *	:			  ( )  
-	 *	 :	index -  
-	 *						parent - ,   
-	 *	 :	
-	 **********************************************/
-	Node* Model::FindNode(Node* parent, uint32_t index)
-	{
-		Node* nodeFound = nullptr;
-
-		if (parent->index == index)
-			return parent;
-
-		for (auto& child : parent->children)
-		{
-			nodeFound = FindNode(child, index);
-			if(nodeFound)
-				break;
-		}
-		return nodeFound;
-	}
-
-	/***********************************************
-	 *	:			nodeFromIndex()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	Node* Model::nodeFromIndex(uint32_t index)
-	{
-		Node* nodeFound = nullptr;
-
-		for(auto& node: nodes)
-		{
-			nodeFound = FindNode(node, index);
-			if(nodeFound)
-				break;
-		}
-		return nodeFound;
-	}
-	
-	/***********************************************
-	 *	:			nodeFromIndex()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	void Model::prepareNodeDescriptor(Node* node, VkDescriptorSetLayout descriptorSetLayout)
-	{
-		if (node->mesh) {
-			VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
-			descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-			descriptorSetAllocInfo.descriptorPool = descriptorPool;
-			descriptorSetAllocInfo.pSetLayouts = &descriptorSetLayout;
-			descriptorSetAllocInfo.descriptorSetCount = 1;
-			VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &descriptorSetAllocInfo, &node->mesh->uniformBuffer.descriptorSet));
-
-			VkWriteDescriptorSet writeDescriptorSet{};
-			writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-			writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
-			writeDescriptorSet.descriptorCount = 1;
-			writeDescriptorSet.dstSet = node->mesh->uniformBuffer.descriptorSet;
-			writeDescriptorSet.dstBinding = 0;
-			writeDescriptorSet.pBufferInfo = &node->mesh->uniformBuffer.descriptor;
-
-			vkUpdateDescriptorSets(device->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
-		}
-		for (auto& child : node->children) {
-			prepareNodeDescriptor(child, descriptorSetLayout);
-		}
-	}
-
-	
-	/*************************************************************************
-	 *    glTF 
-	 *
-	***********************************************************************/
-	/***********************************************
-	 *	:			nodeFromIndex()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	void Texture::UpdateDescriptor()
-	{
-		descriptor.sampler = sampler;
-		descriptor.imageView = view;
-		descriptor.imageLayout = imageLayout;
-	}
-	
-	/***********************************************
-	 *	:			nodeFromIndex()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	void Texture::Destroy()
-	{
-		vkDestroyImageView(device->logicalDevice, view, nullptr);
-		vkDestroyImage(device->logicalDevice, image, nullptr);
-		vkFreeMemory(device->logicalDevice, deviceMemory, nullptr);
-		vkDestroySampler(device->logicalDevice, sampler, nullptr);
-	}
-	
-	/***********************************************
-	 *	:			nodeFromIndex()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	void Texture::FromglTfImage(tinygltf::Image& gltfimage, string path, VulkanDevice* device, VkQueue copyQueue)
-	{
-		this->device = device;
-
-		bool isKtx = false;
-		// Image points to an external ktx file
-		if (gltfimage.uri.find_last_of(".") != std::string::npos) {
-			if (gltfimage.uri.substr(gltfimage.uri.find_last_of(".") + 1) == "ktx") {
-				isKtx = true;
-			}
-		}
-
-		VkFormat format;
-
-		if(!isKtx)
-		{
-			// Texture was loaded using STB_Image
-
-			unsigned char* buffer = nullptr;
-			VkDeviceSize bufferSize = 0;
-			bool deleteBuffer = false;
-			if (gltfimage.component == 3) 
-			{
-				// Most devices don't support RGB only on Vulkan so convert if necessary
-				// TODO: Check actual format support and transform only if required
-				bufferSize = gltfimage.width * gltfimage.height * 4;
-				buffer = new unsigned char[bufferSize];
-				unsigned char* rgba = buffer;
-				unsigned char* rgb = &gltfimage.image[0];
-				for (size_t i = 0; i < gltfimage.width * gltfimage.height; ++i) {
-					for (int32_t j = 0; j < 3; ++j) {
-						rgba[j] = rgb[j];
-					}
-					rgba += 4;
-					rgb += 3;
-				}
-				deleteBuffer = true;
-			}
-			else
-			{
-				buffer = &gltfimage.image[0];
-				bufferSize = gltfimage.image.size();
-			}
-
-			format = VK_FORMAT_R8G8B8A8_UNORM;
-
-			VkFormatProperties formatProperties;
-
-			width = gltfimage.width;
-			height = gltfimage.height;
-
-			// 
-			mipLevels = static_cast<uint32_t>(floor(std::log2(std::max(width, height))) + 1.0);
-
-			vkGetPhysicalDeviceFormatProperties(device->physicalDevice, format, &formatProperties);
-			assert(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT);
-			assert(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT);
-
-			
-			VkMemoryAllocateInfo memAllocInfo{};
-			memAllocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-			VkMemoryRequirements memReqs{};
-
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingMemory;
-
-			VkBufferCreateInfo bufferCreateInfo{};
-			bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-			bufferCreateInfo.size = bufferSize;
-			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			VK_CHECK_RESULT(vkCreateBuffer(device->logicalDevice, &bufferCreateInfo, nullptr, &stagingBuffer));
-			vkGetBufferMemoryRequirements(device->logicalDevice, stagingBuffer, &memReqs);
-			memAllocInfo.allocationSize = memReqs.size;
-			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &stagingMemory));
-			VK_CHECK_RESULT(vkBindBufferMemory(device->logicalDevice, stagingBuffer, stagingMemory, 0));
-
-			uint8_t* data;
-			VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, stagingMemory, 0, memReqs.size, 0, (void**)&data));
-			memcpy(data, buffer, bufferSize);
-			vkUnmapMemory(device->logicalDevice, stagingMemory);
-
-			VkImageCreateInfo imageCreateInfo{};
-			imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
-			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-			imageCreateInfo.format = format;
-			imageCreateInfo.mipLevels = mipLevels;
-			imageCreateInfo.arrayLayers = 1;
-			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-			imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
-			imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			imageCreateInfo.extent = { width, height, 1 };
-			imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
-			VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageCreateInfo, nullptr, &image));
-			vkGetImageMemoryRequirements(device->logicalDevice, image, &memReqs);
-			memAllocInfo.allocationSize = memReqs.size;
-			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &deviceMemory));
-			VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, 0));
-
-			VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-			VkImageSubresourceRange subresourceRange = {};
-			subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			subresourceRange.levelCount = 1;
-			subresourceRange.layerCount = 1;
-
-			{
-				VkImageMemoryBarrier imageMemoryBarrier{};
-				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				imageMemoryBarrier.srcAccessMask = 0;
-				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-				imageMemoryBarrier.image = image;
-				imageMemoryBarrier.subresourceRange = subresourceRange;
-				vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-			}
-
-			VkBufferImageCopy bufferCopyRegion = {};
-			bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			bufferCopyRegion.imageSubresource.mipLevel = 0;
-			bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
-			bufferCopyRegion.imageSubresource.layerCount = 1;
-			bufferCopyRegion.imageExtent.width = width;
-			bufferCopyRegion.imageExtent.height = height;
-			bufferCopyRegion.imageExtent.depth = 1;
-
-			vkCmdCopyBufferToImage(copyCmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferCopyRegion);
-
-			{
-				VkImageMemoryBarrier imageMemoryBarrier{};
-				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-				imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-				imageMemoryBarrier.image = image;
-				imageMemoryBarrier.subresourceRange = subresourceRange;
-				vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-			}
-
-			device->flushCommandBuffer(copyCmd, copyQueue, true);
-
-			vkFreeMemory(device->logicalDevice, stagingMemory, nullptr);
-			vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
-
-			// Generate the mip chain (glTF uses jpg and png, so we need to create this manually)
-			VkCommandBuffer blitCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-
-			for (uint32_t i = 1; i < mipLevels; i++) {
-				VkImageBlit imageBlit{};
-
-				imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				imageBlit.srcSubresource.layerCount = 1;
-				imageBlit.srcSubresource.mipLevel = i - 1;
-				imageBlit.srcOffsets[1].x = int32_t(width >> (i - 1));
-				imageBlit.srcOffsets[1].y = int32_t(height >> (i - 1));
-				imageBlit.srcOffsets[1].z = 1;
-
-				imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				imageBlit.dstSubresource.layerCount = 1;
-				imageBlit.dstSubresource.mipLevel = i;
-				imageBlit.dstOffsets[1].x = int32_t(width >> i);
-				imageBlit.dstOffsets[1].y = int32_t(height >> i);
-				imageBlit.dstOffsets[1].z = 1;
-
-				VkImageSubresourceRange mipSubRange = {};
-				mipSubRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				mipSubRange.baseMipLevel = i;
-				mipSubRange.levelCount = 1;
-				mipSubRange.layerCount = 1;
-
-				{
-					VkImageMemoryBarrier imageMemoryBarrier{};
-					imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-					imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-					imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-					imageMemoryBarrier.srcAccessMask = 0;
-					imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-					imageMemoryBarrier.image = image;
-					imageMemoryBarrier.subresourceRange = mipSubRange;
-					vkCmdPipelineBarrier(blitCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-				}
-
-				vkCmdBlitImage(blitCmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
-
-				{
-					VkImageMemoryBarrier imageMemoryBarrier{};
-					imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-					imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
-					imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-					imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-					imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-					imageMemoryBarrier.image = image;
-					imageMemoryBarrier.subresourceRange = mipSubRange;
-					vkCmdPipelineBarrier(blitCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-				}
-			}
-
-			subresourceRange.levelCount = mipLevels;
-			imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-			{
-				VkImageMemoryBarrier imageMemoryBarrier{};
-				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
-				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-				imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-				imageMemoryBarrier.image = image;
-				imageMemoryBarrier.subresourceRange = subresourceRange;
-				vkCmdPipelineBarrier(blitCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
-			}
-
-			device->flushCommandBuffer(blitCmd, copyQueue, true);
-		}
-		else
-		{
-			// Texture is stored in an external ktx file
-			std::string filename = path + "/" + gltfimage.uri;
-
-			ktxTexture* ktxTexture;
-
-			ktxResult result = KTX_SUCCESS;
-
-			if (!tools::fileExists(filename)) {
-				tools::exitFatal("Could not load texture from " + filename + "\n\nThe file may be part of the additional asset pack.\n\nRun \"download_assets.py\" in the repository root to download the latest version.", -1);
-			}
-			result = ktxTexture_CreateFromNamedFile(filename.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktxTexture);
-			assert(result == KTX_SUCCESS);
-
-			this->device = device;
-			width = ktxTexture->baseWidth;
-			height = ktxTexture->baseHeight;
-			mipLevels = ktxTexture->numLevels;
-
-			ktx_uint8_t* ktxTextureData = ktxTexture_GetData(ktxTexture);
-			ktx_size_t ktxTextureSize = ktxTexture_GetSize(ktxTexture);
-			// @todo: Use ktxTexture_GetVkFormat(ktxTexture)
-			format = VK_FORMAT_R8G8B8A8_UNORM;
-
-			// Get device properties for the requested texture format
-			VkFormatProperties formatProperties;
-			vkGetPhysicalDeviceFormatProperties(device->physicalDevice, format, &formatProperties);
-
-			VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
-			VkBuffer stagingBuffer;
-			VkDeviceMemory stagingMemory;
-
-			VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo();
-			bufferCreateInfo.size = ktxTextureSize;
-			// This buffer is used as a transfer source for the buffer copy
-			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
-			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			VK_CHECK_RESULT(vkCreateBuffer(device->logicalDevice, &bufferCreateInfo, nullptr, &stagingBuffer));
-
-			VkMemoryAllocateInfo memAllocInfo = vks::initializers::memoryAllocateInfo();
-			VkMemoryRequirements memReqs;
-			vkGetBufferMemoryRequirements(device->logicalDevice, stagingBuffer, &memReqs);
-			memAllocInfo.allocationSize = memReqs.size;
-			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &stagingMemory));
-			VK_CHECK_RESULT(vkBindBufferMemory(device->logicalDevice, stagingBuffer, stagingMemory, 0));
-
-			uint8_t* data;
-			VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, stagingMemory, 0, memReqs.size, 0, (void**)&data));
-			memcpy(data, ktxTextureData, ktxTextureSize);
-			vkUnmapMemory(device->logicalDevice, stagingMemory);
-
-			std::vector<VkBufferImageCopy> bufferCopyRegions;
-			for (uint32_t i = 0; i < mipLevels; i++)
-			{
-				ktx_size_t offset;
-				KTX_error_code result = ktxTexture_GetImageOffset(ktxTexture, i, 0, 0, &offset);
-				assert(result == KTX_SUCCESS);
-				VkBufferImageCopy bufferCopyRegion = {};
-				bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-				bufferCopyRegion.imageSubresource.mipLevel = i;
-				bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
-				bufferCopyRegion.imageSubresource.layerCount = 1;
-				bufferCopyRegion.imageExtent.width = std::max(1u, ktxTexture->baseWidth >> i);
-				bufferCopyRegion.imageExtent.height = std::max(1u, ktxTexture->baseHeight >> i);
-				bufferCopyRegion.imageExtent.depth = 1;
-				bufferCopyRegion.bufferOffset = offset;
-				bufferCopyRegions.push_back(bufferCopyRegion);
-			}
-
-			// Create optimal tiled target image
-			VkImageCreateInfo imageCreateInfo = vks::initializers::imageCreateInfo();
-			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
-			imageCreateInfo.format = format;
-			imageCreateInfo.mipLevels = mipLevels;
-			imageCreateInfo.arrayLayers = 1;
-			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
-			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
-			imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-			imageCreateInfo.extent = { width, height, 1 };
-			imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
-			VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageCreateInfo, nullptr, &image));
-
-			vkGetImageMemoryRequirements(device->logicalDevice, image, &memReqs);
-			memAllocInfo.allocationSize = memReqs.size;
-			memAllocInfo.memoryTypeIndex = device->getMemoryType(memReqs.memoryTypeBits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT);
-			VK_CHECK_RESULT(vkAllocateMemory(device->logicalDevice, &memAllocInfo, nullptr, &deviceMemory));
-			VK_CHECK_RESULT(vkBindImageMemory(device->logicalDevice, image, deviceMemory, 0));
-
-			VkImageSubresourceRange subresourceRange = {};
-			subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-			subresourceRange.baseMipLevel = 0;
-			subresourceRange.levelCount = mipLevels;
-			subresourceRange.layerCount = 1;
-
-			vks::tools::setImageLayout(copyCmd, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
-			vkCmdCopyBufferToImage(copyCmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(bufferCopyRegions.size()), bufferCopyRegions.data());
-			vks::tools::setImageLayout(copyCmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
-			device->flushCommandBuffer(copyCmd, copyQueue);
-			this->imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-
-			vkFreeMemory(device->logicalDevice, stagingMemory, nullptr);
-			vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
-
-			ktxTexture_Destroy(ktxTexture);
-		}
-		
-		VkSamplerCreateInfo samplerInfo{};
-		samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-		samplerInfo.magFilter = VK_FILTER_LINEAR;
-		samplerInfo.minFilter = VK_FILTER_LINEAR;
-		samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
-		samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-		samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-		samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
-		samplerInfo.compareOp = VK_COMPARE_OP_NEVER;
-		samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
-		samplerInfo.maxAnisotropy = 1.0;
-		samplerInfo.anisotropyEnable = VK_FALSE;
-		samplerInfo.maxLod = (float)mipLevels;
-		samplerInfo.maxAnisotropy = 8.0f;
-		samplerInfo.anisotropyEnable = VK_TRUE;
-		VK_CHECK_RESULT(vkCreateSampler(device->logicalDevice, &samplerInfo, nullptr, &sampler));
-
-		VkImageViewCreateInfo viewInfo{};
-		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
-		viewInfo.image = image;
-		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
-		viewInfo.format = format;
-		viewInfo.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
-		viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-		viewInfo.subresourceRange.layerCount = 1;
-		viewInfo.subresourceRange.levelCount = mipLevels;
-		VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewInfo, nullptr, &view));
-
-		descriptor.sampler = sampler;
-		descriptor.imageView = view;
-		descriptor.imageLayout = imageLayout;
-	}
-	/***********************************************
-	 *	:			Mesh()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	Mesh::Mesh(VulkanDevice* device, mat4 matrix)
-	{
-		this->device = device;
-		this->uniformBlock.matrix = matrix;
-		VK_CHECK_RESULT(device->createBuffer(
-			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-			sizeof(uniformBlock),
-			&uniformBuffer.buffer,
-			&uniformBuffer.memory,
-			&uniformBlock));
-		VK_CHECK_RESULT(vkMapMemory(device->logicalDevice, uniformBuffer.memory, 0, sizeof(uniformBlock), 0, &uniformBuffer.mapped));
-		uniformBuffer.descriptor = { uniformBuffer.buffer, 0, sizeof(uniformBlock) };
-	}
-
-	/***********************************************
-	 *	:			~Mesh()
-	 *	:			   
-	 *	 :	index -  
-	 *	 :	
-	 **********************************************/
-	Mesh::~Mesh()
-	{
-		vkDestroyBuffer(device->logicalDevice, uniformBuffer.buffer, nullptr);
-		vkFreeMemory(device->logicalDevice, uniformBuffer.memory, nullptr);
-	}
-	
-	/*************************************************************************
-	 *  Node 
-	 *
-	***********************************************************************/
-	mat4 Node::localMatrix()
-	{
-		return translate(mat4(1.0f), translation) * mat4(rotation) * glm::scale(mat4(1.0f), scale) * matrix;
-	}
-	
-	mat4 Node::getMatrix()
-	{
-		glm::mat4 m = localMatrix();
-		vkglTF::Node* p = parent;
-		while (p) {
-			m = p->localMatrix() * m;
-			p = p->parent;
-		}
-		return m;
-	}
-	void Node::Update()
-	{
-		if (mesh) {
-			glm::mat4 m = getMatrix();
-			if (skin) {
-				mesh->uniformBlock.matrix = m;
-				// Update join matrices
-				glm::mat4 inverseTransform = glm::inverse(m);
-				for (size_t i = 0; i < skin->joints.size(); i++) {
-					vkglTF::Node* jointNode = skin->joints[i];
-					glm::mat4 jointMat = jointNode->getMatrix() * skin->inverseBindMatrices[i];
-					jointMat = inverseTransform * jointMat;
-					mesh->uniformBlock.jointMatrix[i] = jointMat;
-				}
-				mesh->uniformBlock.jointcount = (float)skin->joints.size();
-				memcpy(mesh->uniformBuffer.mapped, &mesh->uniformBlock, sizeof(mesh->uniformBlock));
-			}
-			else {
-				memcpy(mesh->uniformBuffer.mapped, &m, sizeof(glm::mat4));
-			}
-		}
-
-		for (auto& child : children) {
-			child->Update();
-		}
-	}
-
-	Node::~Node()
-	{
-		if (mesh) {
-			delete mesh;
-		}
-		for (auto& child : children) {
-			delete child;
-		}
-	}
-	
-	/*************************************************************************
-	 *  Vertex 
-	 *
-	***********************************************************************/
-	VkVertexInputBindingDescription Vertex::vertexInputBindingDescription;
-	std::vector<VkVertexInputAttributeDescription> Vertex::vertexInputAttributeDescriptions;
-	VkPipelineVertexInputStateCreateInfo Vertex::pipelineVertexInputStateCreateInfo;
-	
-	/***********************************************
-	 *	:			InputBindingDescription()
-	 *	:			   
-	 *	 :	fileName -  
-	 *						device -  
-	 *	 :	
-	 **********************************************/
-	VkVertexInputBindingDescription Vertex::InputBindingDescription(uint32_t binding)
-	{
-		return VkVertexInputBindingDescription({ binding, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX });
-	}
-	
-	/***********************************************
-	 *	:			InputAttributeDescription()
-	 *	:			   
-	 *	 :	fileName -  
-	 *						device -  
-	 *	 :	
-	 **********************************************/
-	VkVertexInputAttributeDescription Vertex::InputAttributeDescription(uint32_t binding, uint32_t location, VertexComponent component)
-	{
-		switch (component) {
-		case VertexComponent::Position:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, pos) });
-		case VertexComponent::Normal:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal) });
-		case VertexComponent::UV:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, uv) });
-		case VertexComponent::Color:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, color) });
-		case VertexComponent::Tangent:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, tangent) });
-		case VertexComponent::Joint0:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, joint0) });
-		case VertexComponent::Weight0:
-			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, weight0) });
-		default:
-			return VkVertexInputAttributeDescription({});
-		}
-	}
-	
-	/***********************************************
-	 *	:			InputAttributeDescriptions()
-	 *	:			   
-	 *	 :	fileName -  
-	 *						device -  
-	 *	 :	
-	 **********************************************/
-	vector<VkVertexInputAttributeDescription> Vertex::InputAttributeDescriptions(uint32_t binding, const vector<VertexComponent> components)
-	{
-		std::vector<VkVertexInputAttributeDescription> result;
-		uint32_t location = 0;
-		for (VertexComponent component : components) {
-			result.push_back(Vertex::InputAttributeDescription(binding, location, component));
-			location++;
-		}
-		return result;
-	}
-	
-	/***********************************************
-	 *	:			GetPipelineVertexInputState()
-	 *	:			   
-	 *	 :	fileName -  
-	 *						device -  
-	 *	 :	
-	 **********************************************/
-	VkPipelineVertexInputStateCreateInfo* Vertex::GetPipelineVertexInputState(const vector<VertexComponent> components)
-	{
-		vertexInputBindingDescription = InputBindingDescription(0);
-		vertexInputAttributeDescriptions = InputAttributeDescriptions(0, components);
-		pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-		pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
-		pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = &Vertex::vertexInputBindingDescription;
-		pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInputAttributeDescriptions.size());
-		pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions.data();
-		return &pipelineVertexInputStateCreateInfo;
-	}
-
-	/***********************************************
-	 *	:			CreateDescriptorSet()
-	 *	:			   
-	 *	 :	fileName -  
-	 *						device -  
-	 *	 :	
-	 **********************************************/
-	void Material::CreateDescriptorSet(VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout)
-	{
-		VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
-		descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
-		descriptorSetAllocInfo.descriptorPool = descriptorPool;
-		descriptorSetAllocInfo.pSetLayouts = &descriptorSetLayout;
-		descriptorSetAllocInfo.descriptorSetCount = 1;
-		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &descriptorSetAllocInfo, &descriptorSet));
-
-		std::vector<VkDescriptorImageInfo> imageDescriptors = {
-			baseColorTexture->descriptor,
-		};
-
-		VkWriteDescriptorSet writeDescriptorSet{};
-		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-		writeDescriptorSet.descriptorCount = 1;
-		writeDescriptorSet.dstSet = descriptorSet;
-		writeDescriptorSet.dstBinding = 0;
-		writeDescriptorSet.pImageInfo = &baseColorTexture->descriptor;
-		vkUpdateDescriptorSets(device->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
-	}
-	
-	/***********************************************
-	 *	:			SetDimensions()
-	 *	:			   
-	 *	 :	fileName -  
-	 *						device -  
-	 *	 :	
-	 **********************************************/
-	void Primitive::SetDimensions(vec3 min, vec3 max)
-	{
-		dimensions.min = min;
-		dimensions.max = max;
-		dimensions.size = max - min;
-		dimensions.center = (min + max) / 2.0f;
-		dimensions.radius = glm::distance(min, max) / 2.0f;
-	}
-}
+#include "VulkanglTfModel.h"
+
+
+VkDescriptorSetLayout vkglTF::descriptorSetLayoutImage = VK_NULL_HANDLE;
+VkDescriptorSetLayout vkglTF::descriptorSetLayoutUbo = VK_NULL_HANDLE;
+VkDescriptorSetLayout vkglTF::descriptorSetLayoutIndirect = VK_NULL_HANDLE;
+VkDescriptorSetLayout vkglTF::descriptorSetLayoutBindless = VK_NULL_HANDLE;
+uint32_t vkglTF::bindlessTextureCapacity = 0;
+VkMemoryPropertyFlags vkglTF::memoryPropertyFlags = 0;
+
+bool loadImageDataFuncEmpty(tinygltf::Image* image, const int imageIndex, string* error, string* warning, int req_width, int req_height, const unsigned char* bytes, int size, void* userData)
+{
+	// This function will be used for samples that don't require images to be loaded
+	return true;
+}
+
+bool loadImageDataFunc(tinygltf::Image* image, const int imageIndex, string* error, string* warning, int req_width, int req_height, const unsigned char* bytes, int size, void* userData)
+{
+	// KTX files will be handled by our own code
+	if (image->uri.find_last_of(".") != std::string::npos) {
+		if (image->uri.substr(image->uri.find_last_of(".") + 1) == "ktx") {
+			return true;
+		}
+	}
+
+	return LoadImageData(image, imageIndex, error, warning, req_width, req_height, bytes, size, userData);
+}
+
+namespace vkglTF
+{
+	/***********************************************
+	 *	функция:			loadImage()
+	 *	назначение:			загрузить изображения модели
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	Texture* Model::GetTexture(uint32_t index)
+	{
+		//без загруженных изображений (DontLoadImages) текстур нет
+		if (index < textures.size())
+			return &textures[index];
+		return nullptr;
+	}
+	
+	Model::Model()
+	{
+		
+	}
+	
+	Model::~Model()
+	{
+		Unload();
+	}
+
+	/***********************************************
+	 *	функция:			Unload()
+	 *	назначение:			освободить сцену и ресурсы модели (пулы
+	 *						узлов, граней, примитивов и скинов
+	 *						освобождаются целиком)
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::Unload()
+	{
+		nodes.clear();
+		linearNodes.clear();
+		for (vector<PrimitiveDraw>& bucket : alphaBuckets)
+			bucket.clear();
+		skins.clear();
+		animations.clear();
+		clips.clear();
+		primitivePool.Clear();
+		meshPool.Clear();
+		skinPool.Clear();
+		nodePool.Clear();
+
+		//состояние прошлой сцены: границы отсечения и палитра пересоздаются
+		//при первом UpdateBounds() и PrepareJointBuffer()
+		worldBounds = BoxArray();
+		visiblePrimitives.clear();
+		jointPalette.clear();
+		morphWeightCount = 0;
+		buffersBound = false;
+
+		if (!device)
+			return;
+
+		jointBuffer.destroy();
+		jointBuffer = Buffer();
+		uniformRing.buffer.destroy();
+		uniformRing = NodeUniformRing();
+		indirectBuffer.destroy();
+		indirectBuffer = Buffer();
+		drawDataBuffer.destroy();
+		drawDataBuffer = Buffer();
+		materialBuffer.destroy();
+		materialBuffer = Buffer();
+		bindlessDescriptorSet = VK_NULL_HANDLE;
+		indirectDescriptorSet = VK_NULL_HANDLE;
+		indirectCommandCount = 0;
+		indirectCommands.clear();
+		for (IndirectBatch& batch : indirectBatches)
+			batch = IndirectBatch();
+
+		if (vertices.buffer != VK_NULL_HANDLE)
+		{
+			vkDestroyBuffer(device->logicalDevice, vertices.buffer, nullptr);
+			device->allocator.Free(vertices.memory);
+		}
+		if (indices.buffer != VK_NULL_HANDLE)
+		{
+			vkDestroyBuffer(device->logicalDevice, indices.buffer, nullptr);
+			device->allocator.Free(indices.memory);
+		}
+		vertices = {};
+		indices = {};
+
+		for (Texture& texture : textures)
+			texture.Destroy();
+		textures.clear();
+		materials.clear();
+
+		if (descriptorPool != VK_NULL_HANDLE)
+			vkDestroyDescriptorPool(device->logicalDevice, descriptorPool, nullptr);
+		descriptorPool = VK_NULL_HANDLE;
+	}
+
+	/***********************************************
+	 *	функция:			CountNodes()
+	 *	назначение:			посчитать узлы, грани и примитивы поддерева
+	 *						для резервирования пулов модели
+	 *	входящие значения:	model - модель glTF
+	 *						nodeIndex - индекс узла
+	 *						nodeCount, meshCount, primitiveCount - счетчики
+	 *	выходящие значения:	нет
+	 **********************************************/
+	static void CountNodes(const tinygltf::Model& model, int nodeIndex, size_t& nodeCount, size_t& meshCount, size_t& primitiveCount)
+	{
+		const tinygltf::Node& node = model.nodes[nodeIndex];
+		nodeCount++;
+		if (node.mesh > -1)
+		{
+			meshCount++;
+			primitiveCount += model.meshes[node.mesh].primitives.size();
+		}
+		for (int child : node.children)
+			CountNodes(model, child, nodeCount, meshCount, primitiveCount);
+	}
+
+	/***********************************************
+	 *	функция:			ReadVec3Accessor()
+	 *	назначение:			прочитать vec3 аксессор (в том числе
+	 *						разреженный, как у целей морфинга)
+	 *	входящие значения:	model - модель glTF
+	 *						accessorIndex - индекс аксессора
+	 *						values - массив для записи
+	 *	выходящие значения:	нет
+	 **********************************************/
+	static void ReadVec3Accessor(const tinygltf::Model& model, int accessorIndex, vector<vec3>& values)
+	{
+		const tinygltf::Accessor& accessor = model.accessors[accessorIndex];
+		values.assign(accessor.count, vec3(0.0f));
+
+		if (accessor.bufferView > -1)
+		{
+			const tinygltf::BufferView& view = model.bufferViews[accessor.bufferView];
+			const size_t stride = accessor.ByteStride(view);
+			const unsigned char* data = &model.buffers[view.buffer].data[accessor.byteOffset + view.byteOffset];
+			for (size_t v = 0; v < accessor.count; v++)
+				values[v] = make_vec3(reinterpret_cast<const float*>(data + v * stride));
+		}
+
+		if (!accessor.sparse.isSparse)
+			return;
+
+		const tinygltf::BufferView& indexView = model.bufferViews[accessor.sparse.indices.bufferView];
+		const tinygltf::BufferView& valueView = model.bufferViews[accessor.sparse.values.bufferView];
+		const unsigned char* indexData = &model.buffers[indexView.buffer].data[accessor.sparse.indices.byteOffset + indexView.byteOffset];
+		const float* valueData = reinterpret_cast<const float*>(&model.buffers[valueView.buffer].data[accessor.sparse.values.byteOffset + valueView.byteOffset]);
+		for (int k = 0; k < accessor.sparse.count; k++)
+		{
+			uint32_t index = 0;
+			switch (accessor.sparse.indices.componentType)
+			{
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_INT:
+				index = reinterpret_cast<const uint32_t*>(indexData)[k];
+				break;
+			case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT:
+				index = reinterpret_cast<const uint16_t*>(indexData)[k];
+				break;
+			default:
+				index = indexData[k];
+				break;
+			}
+			if (index < values.size())
+				values[index] = make_vec3(&valueData[k * 3]);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			LoadNode()
+	 *	назначение:			загрузка узла модели
+	 *	входящие значения:	parent - родитель или nullptr для корня
+	 *						newNode - место узла в пуле модели
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::LoadNode(Node* parent, Node* newNode, const tinygltf::Node& node, uint32_t nodeIndex, const tinygltf::Model& model, vector<uint32_t>
+	                     & indexBuffer, vector<Vertex>& vertexBuffer, float globalScale)
+	{
+		newNode->index = nodeIndex;
+		newNode->parent = parent;
+		newNode->name = node.name;
+		newNode->skinIndex = node.skin;
+		newNode->matrix = mat4(1.0f);
+
+		//формирование матрицы для локального узла
+		vec3 translation = vec3(0.0f);
+		if(node.translation.size() == 3)
+		{
+			translation = make_vec3(node.translation.data());
+			newNode->translation = translation;
+		}
+
+		mat4 rotation = mat4(1.0f);
+		if(node.rotation.size() == 4)
+		{
+			quat q = make_quat(node.rotation.data());
+			newNode->rotation = q;
+		}
+
+		vec3 scale = vec3(1.0f);
+		if(node.scale.size() == 3)
+		{
+			scale = make_vec3(node.scale.data());
+			newNode->scale = scale;
+		}
+
+		if(node.matrix.size() == 16)
+		{
+			newNode->matrix = make_mat4x4(node.matrix.data());
+			if(globalScale != 1.0f)
+			{
+				//
+			}
+		}
+
+		if(node.children.size() > 0)
+		{
+			//дети узла занимают в пуле непрерывный диапазон
+			newNode->children.count = static_cast<uint32_t>(node.children.size());
+			newNode->children.first = nodePool.CreateRange(node.children.size());
+			for (auto i = 0; i < node.children.size(); i++)
+				LoadNode(newNode, newNode->children[i], model.nodes[node.children[i]], node.children[i], model, indexBuffer, vertexBuffer, globalScale);
+			
+		}
+
+		if(node.mesh > -1)
+		{
+			const tinygltf::Mesh mesh = model.meshes[node.mesh];
+			Mesh* newMesh = meshPool.Create(device, newNode->matrix);
+			newMesh->name = mesh.name;
+
+			for (size_t j=0; j<mesh.primitives.size(); j++)
+			{
+				const tinygltf::Primitive& primitive = mesh.primitives[j];
+
+				if (primitive.indices < 0)
+					continue;
+
+				uint32_t indexStart = static_cast<uint32_t>(indexBuffer.size());
+				uint32_t vertexStart = static_cast<uint32_t>(vertexBuffer.size());
+
+				uint32_t indexCount = 0;
+				uint32_t vertexCount = 0;
+
+				vec3 posMin{};
+				vec3 posMax{};
+				bool hasSkin = false;
+				//Вершины
+				{
+					const float* bufferPos = nullptr;
+					const float* bufferNormals = nullptr;
+					const float* bufferTexCoords = nullptr;
+					const float* bufferColors = nullptr;
+					const float* bufferTangents = nullptr;
+					uint32_t numColorComponents;
+					const uint16_t* bufferJoints = nullptr;
+					const float* bufferWeights = nullptr;
+
+					//Запрос атрибутов позиции
+					assert(primitive.attributes.find("POSITION") != primitive.attributes.end());
+
+					const tinygltf::Accessor& posAccessor = model.accessors[primitive.attributes.find("POSITION")->second];
+					const tinygltf::BufferView& posView = model.bufferViews[posAccessor.bufferView];
+					bufferPos = reinterpret_cast<const float*>(&(model.buffers[posView.buffer].data[posAccessor.byteOffset + posView.byteOffset]));
+					posMin = glm::vec3(posAccessor.minValues[0], posAccessor.minValues[1], posAccessor.minValues[2]);
+					posMax = glm::vec3(posAccessor.maxValues[0], posAccessor.maxValues[1], posAccessor.maxValues[2]);
+
+					if (primitive.attributes.find("NORMAL") != primitive.attributes.end()) {
+						const tinygltf::Accessor& normAccessor = model.accessors[primitive.attributes.find("NORMAL")->second];
+						const tinygltf::BufferView& normView = model.bufferViews[normAccessor.bufferView];
+						bufferNormals = reinterpret_cast<const float*>(&(model.buffers[normView.buffer].data[normAccessor.byteOffset + normView.byteOffset]));
+					}
+
+					if (primitive.attributes.find("TEXCOORD_0") != primitive.attributes.end()) {
+						const tinygltf::Accessor& uvAccessor = model.accessors[primitive.attributes.find("TEXCOORD_0")->second];
+						const tinygltf::BufferView& uvView = model.bufferViews[uvAccessor.bufferView];
+						bufferTexCoords = reinterpret_cast<const float*>(&(model.buffers[uvView.buffer].data[uvAccessor.byteOffset + uvView.byteOffset]));
+					}
+
+					if (primitive.attributes.find("COLOR_0") != primitive.attributes.end())
+					{
+						const tinygltf::Accessor& colorAccessor = model.accessors[primitive.attributes.find("COLOR_0")->second];
+						const tinygltf::BufferView& colorView = model.bufferViews[colorAccessor.bufferView];
+						// Color buffer are either of type vec3 or vec4
+						numColorComponents = colorAccessor.type == TINYGLTF_PARAMETER_TYPE_FLOAT_VEC3 ? 3 : 4;
+						bufferColors = reinterpret_cast<const float*>(&(model.buffers[colorView.buffer].data[colorAccessor.byteOffset + colorView.byteOffset]));
+					}
+
+					if (primitive.attributes.find("TANGENT") != primitive.attributes.end())
+					{
+						const tinygltf::Accessor& tangentAccessor = model.accessors[primitive.attributes.find("TANGENT")->second];
+						const tinygltf::BufferView& tangentView = model.bufferViews[tangentAccessor.bufferView];
+						bufferTangents = reinterpret_cast<const float*>(&(model.buffers[tangentView.buffer].data[tangentAccessor.byteOffset + tangentView.byteOffset]));
+					}
+
+					// Skinning
+					// Joints
+					if (primitive.attributes.find("JOINTS_0") != primitive.attributes.end()) {
+						const tinygltf::Accessor& jointAccessor = model.accessors[primitive.attributes.find("JOINTS_0")->second];
+						const tinygltf::BufferView& jointView = model.bufferViews[jointAccessor.bufferView];
+						bufferJoints = reinterpret_cast<const uint16_t*>(&(model.buffers[jointView.buffer].data[jointAccessor.byteOffset + jointView.byteOffset]));
+					}
+
+					if (primitive.attributes.find("WEIGHTS_0") != primitive.attributes.end()) {
+						const tinygltf::Accessor& uvAccessor = model.accessors[primitive.attributes.find("WEIGHTS_0")->second];
+						const tinygltf::BufferView& uvView = model.bufferViews[uvAccessor.bufferView];
+						bufferWeights = reinterpret_cast<const float*>(&(model.buffers[uvView.buffer].data[uvAccessor.byteOffset + uvView.byteOffset]));
+					}
+
+					hasSkin = (bufferJoints && bufferWeights);
+
+					vertexCount = static_cast<uint32_t>(posAccessor.count);
+					
+					for(size_t v=0; v<posAccessor.count; v++)
+					{
+						Vertex vert{};
+						vert.pos = vec4(make_vec3(&bufferPos[v * 3]), 1.0f);
+						vert.normal = bufferNormals ? normalize(make_vec3(&bufferNormals[v * 3])) : vec3(0.0f);
+						vert.uv = bufferTexCoords ? make_vec2(&bufferTexCoords[v * 2]) : vec2(0.0f);
+
+						if(bufferColors)
+						{
+							switch (numColorComponents)
+							{
+							case 3:
+								vert.color = glm::vec4(glm::make_vec3(&bufferColors[v * 3]), 1.0f);
+								break;
+								
+							case 4:
+								vert.color = glm::make_vec4(&bufferColors[v * 4]);
+							}
+						}
+						else
+							vert.color = vec4(1.0f);
+						
+						vert.tangent = bufferTangents ? vec4(make_vec4(&bufferTangents[v * 4])) : vec4(0.0f);
+						vert.joint0 = hasSkin ? vec4(make_vec4(&bufferJoints[v * 4])) : vec4(0.0f);
+						vert.weight0 = hasSkin ? make_vec4(&bufferWeights[v * 4]) : vec4(0.0f);
+						vertexBuffer.push_back(vert);
+					}
+				}
+				//индексы
+				{
+					const tinygltf::Accessor& accessor = model.accessors[primitive.indices];
+					const tinygltf::BufferView& bufferView = model.bufferViews[accessor.bufferView];
+					const tinygltf::Buffer& buffer = model.buffers[bufferView.buffer];
+
+					indexCount = static_cast<uint32_t>(accessor.count);
+
+					//индексы читаются прямо из буфера glTF (смещения выровнены по размеру компонента)
+					const unsigned char* data = &buffer.data[accessor.byteOffset + bufferView.byteOffset];
+					switch (accessor.componentType)
+					{
+					case TINYGLTF_PARAMETER_TYPE_UNSIGNED_INT: {
+						const uint32_t* buf = reinterpret_cast<const uint32_t*>(data);
+						for (size_t index = 0; index < accessor.count; index++)
+							indexBuffer.push_back(buf[index] + vertexStart);
+						break;
+					}
+					case TINYGLTF_COMPONENT_TYPE_UNSIGNED_SHORT: {
+						const uint16_t* buf = reinterpret_cast<const uint16_t*>(data);
+						for (size_t index = 0; index < accessor.count; index++)
+							indexBuffer.push_back(buf[index] + vertexStart);
+						break;
+					}
+					case TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE: {
+						const uint8_t* buf = data;
+						for (size_t index = 0; index < accessor.count; index++)
+							indexBuffer.push_back(buf[index] + vertexStart);
+						break;
+					}
+
+					default:
+						std::cerr << "Index component type " << accessor.componentType << " not supported!" << std::endl;
+						return;
+					}
+				}
+				//цели морфинга: сохраняются только вершины с ненулевым смещением
+				if (!primitive.targets.empty())
+				{
+					newMesh->morphTargets.resize(std::max(newMesh->morphTargets.size(), primitive.targets.size()));
+
+					vector<vector<vec3>> positions(primitive.targets.size());
+					vector<vector<vec3>> normals(primitive.targets.size());
+					vector<int32_t> rows(vertexCount, -1);
+					for (size_t t = 0; t < primitive.targets.size(); t++)
+					{
+						const auto& target = primitive.targets[t];
+						if (target.find("POSITION") != target.end())
+							ReadVec3Accessor(model, target.find("POSITION")->second, positions[t]);
+						if (target.find("NORMAL") != target.end())
+							ReadVec3Accessor(model, target.find("NORMAL")->second, normals[t]);
+						positions[t].resize(vertexCount, vec3(0.0f));
+						normals[t].resize(vertexCount, vec3(0.0f));
+
+						for (uint32_t v = 0; v < vertexCount; v++)
+						{
+							if ((positions[t][v] == vec3(0.0f)) && (normals[t][v] == vec3(0.0f)))
+								continue;
+
+							if (rows[v] < 0)
+							{
+								rows[v] = static_cast<int32_t>(newMesh->morphVertices.size());
+								newMesh->morphVertices.push_back(vertexStart + v);
+							}
+							MorphTarget& morphTarget = newMesh->morphTargets[t];
+							morphTarget.vertices.push_back(static_cast<uint32_t>(rows[v]));
+							morphTarget.positions.push_back(positions[t][v]);
+							morphTarget.normals.push_back(normals[t][v]);
+						}
+					}
+				}
+
+				Primitive* newPrimitive = primitivePool.Create(indexStart, indexCount, primitive.material > -1 ? materials[primitive.material] : materials.back());
+				newPrimitive->firstVertex = vertexStart;
+				newPrimitive->vertexCount = vertexCount;
+				//место в worldBounds совпадает с местом в пуле
+				newPrimitive->cullIndex = static_cast<uint32_t>(primitivePool.Size() - 1);
+				newPrimitive->SetDimensions(posMin, posMax);
+				newMesh->primitives.push_back(newPrimitive);
+			}
+			//веса узла заменяют веса по умолчанию из описания граней
+			const vector<double>& weights = node.weights.empty() ? mesh.weights : node.weights;
+			newMesh->weights.assign(weights.begin(), weights.end());
+			newMesh->weights.resize(newMesh->morphTargets.size(), 0.0f);
+
+			newNode->mesh = newMesh;
+		}
+		if (!parent)
+			nodes.push_back(newNode);
+
+		linearNodes.push_back(newNode);
+	}
+	
+	/***********************************************
+	 *	функция:			loadImage()
+	 *	назначение:			загрузить изображения модели
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::LoadSkins(tinygltf::Model& gltfModel)
+	{
+		for (tinygltf::Skin& source : gltfModel.skins) {
+			Skin* newSkin = skinPool.Create();
+			newSkin->name = source.name;
+
+			// Find skeleton root node
+			if (source.skeleton > -1) {
+				newSkin->skeletonRoot = nodeFromIndex(source.skeleton);
+			}
+
+			// Find joint nodes
+			for (int jointIndex : source.joints) {
+				Node* node = nodeFromIndex(jointIndex);
+				if (node) {
+					newSkin->joints.push_back(nodeFromIndex(jointIndex));
+				}
+			}
+
+			// Get inverse bind matrices from buffer
+			if (source.inverseBindMatrices > -1) {
+				const tinygltf::Accessor& accessor = gltfModel.accessors[source.inverseBindMatrices];
+				const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
+				const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
+				newSkin->inverseBindMatrices.resize(accessor.count);
+				memcpy(newSkin->inverseBindMatrices.data(), &buffer.data[accessor.byteOffset + bufferView.byteOffset], accessor.count * sizeof(glm::mat4));
+			}
+			newSkin->inverseBindMatrices.resize(newSkin->joints.size(), mat4(1.0f));
+
+			skins.push_back(newSkin);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			PrepareJointBuffer()
+	 *	назначение:			создать общий буфер матриц суставов
+	 *						(framesInFlight областей) и распределить
+	 *						в нем места скинов
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::PrepareJointBuffer()
+	{
+		uint32_t jointCount = 0;
+		for (Skin* skin : skins)
+		{
+			skin->jointOffset = jointCount;
+			jointCount += static_cast<uint32_t>(skin->joints.size());
+		}
+
+		//буфер не может быть пустым, модели без скинов получают одну матрицу
+		jointPalette.assign(std::max(jointCount, 1u), mat4(1.0f));
+		for (Skin* skin : skins)
+			skin->jointMatrices = jointPalette.data() + skin->jointOffset;
+
+		//область кадра начинается с динамического смещения storage буфера
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(device->properties.limits.minStorageBufferOffsetAlignment, 16);
+		const VkDeviceSize paletteSize = jointPalette.size() * sizeof(mat4);
+		const uint32_t frameCount = std::max(framesInFlight, 1u);
+		uniformRing.jointFrameSize = (paletteSize + alignment - 1) & ~(alignment - 1);
+		uniformRing.jointBuffer = &jointBuffer;
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&jointBuffer,
+			uniformRing.jointFrameSize * frameCount));
+		VK_CHECK_RESULT(jointBuffer.map());
+		for (uint32_t frame = 0; frame < frameCount; frame++)
+			memcpy(static_cast<uint8_t*>(jointBuffer.mapped) + frame * uniformRing.jointFrameSize, jointPalette.data(), paletteSize);
+		//набор описывает одну область, смещение кадра задается при связывании
+		jointBuffer.setupDescriptor(uniformRing.jointFrameSize);
+	}
+	
+	/***********************************************
+	 *	функция:			loadImage()
+	 *	назначение:			загрузить изображения модели
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::loadImage(tinygltf::Model& gltfModel, VulkanDevice* device, VkQueue transferQueue)
+	{
+		for(tinygltf::Image &image: gltfModel.images)
+		{
+			Texture texture;
+			texture.FromglTfImage(image, path, device, transferQueue);
+			textures.push_back(texture);
+		}
+	}
+	
+	/***********************************************
+	 *	функция:			LoadMaterials()
+	 *	назначение:			загрузить материалы модели
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::LoadMaterials(tinygltf::Model& gltfModel)
+	{
+		for (tinygltf::Material& mat: gltfModel.materials)
+		{
+			Material material(device);
+			if (mat.values.find("baseColorTexture") != mat.values.end())
+				material.baseColorTexture = GetTexture(gltfModel.textures[mat.values["baseColorTexture"].TextureIndex()].source);
+
+			// Metallic roughness workflow
+			if (mat.values.find("metallicRoughnessTexture") != mat.values.end()) {
+				material.metallicRoughnessTexture = GetTexture(gltfModel.textures[mat.values["metallicRoughnessTexture"].TextureIndex()].source);
+			}
+			if (mat.values.find("roughnessFactor") != mat.values.end()) {
+				material.roughnessFactor = static_cast<float>(mat.values["roughnessFactor"].Factor());
+			}
+			if (mat.values.find("metallicFactor") != mat.values.end()) {
+				material.metallicFactor = static_cast<float>(mat.values["metallicFactor"].Factor());
+			}
+			if (mat.values.find("baseColorFactor") != mat.values.end()) {
+				material.baseColorFactor = glm::make_vec4(mat.values["baseColorFactor"].ColorFactor().data());
+			}
+			if (mat.additionalValues.find("normalTexture") != mat.additionalValues.end()) {
+				material.normalTexture = GetTexture(gltfModel.textures[mat.additionalValues["normalTexture"].TextureIndex()].source);
+			}
+			if (mat.additionalValues.find("emissiveTexture") != mat.additionalValues.end()) {
+				material.emissiveTexture = GetTexture(gltfModel.textures[mat.additionalValues["emissiveTexture"].TextureIndex()].source);
+			}
+			if (mat.additionalValues.find("occlusionTexture") != mat.additionalValues.end()) {
+				material.occlusionTexture = GetTexture(gltfModel.textures[mat.additionalValues["occlusionTexture"].TextureIndex()].source);
+			}
+			if (mat.additionalValues.find("alphaMode") != mat.additionalValues.end()) {
+				tinygltf::Parameter param = mat.additionalValues["alphaMode"];
+				if (param.string_value == "BLEND") {
+					material.alphaMode = Material::ALPHAMODE_BLEND;
+				}
+				if (param.string_value == "MASK") {
+					material.alphaMode = Material::ALPHAMODE_MASK;
+				}
+			}
+			if (mat.additionalValues.find("alphaCutoff") != mat.additionalValues.end()) {
+				material.alphaCutoff = static_cast<float>(mat.additionalValues["alphaCutoff"].Factor());
+			}
+
+			material.index = static_cast<uint32_t>(materials.size());
+			materials.push_back(material);
+		}
+		// Push a default material at the end of the list for meshes with no material assigned
+		materials.push_back(Material(device));
+		materials.back().index = static_cast<uint32_t>(materials.size()) - 1;
+	}
+	
+	void Model::LoadAnimations(tinygltf::Model& gltfModel)
+	{
+		for (tinygltf::Animation& anim : gltfModel.animations)
+		{
+			Animation animation{};
+			animation.name = anim.name;
+			if (anim.name.empty()) 
+				animation.name = std::to_string(animations.size());
+
+			// Samplers
+			for (auto& samp : anim.samplers)
+			{
+				AnimationSampler sampler{};
+
+				if (samp.interpolation == "LINEAR") 
+					sampler.interpolation = AnimationSampler::InterpolationType::LINEAR;
+				
+				if (samp.interpolation == "STEP") 
+					sampler.interpolation = AnimationSampler::InterpolationType::STEP;
+				
+				if (samp.interpolation == "CUBICSPLINE") 
+					sampler.interpolation = AnimationSampler::InterpolationType::CUBICSPLINE;
+
+				// Read sampler input time values
+				{
+					const tinygltf::Accessor& accessor = gltfModel.accessors[samp.input];
+					const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
+					const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
+
+					assert(accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT);
+
+					const float* buf = reinterpret_cast<const float*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
+					sampler.inputs.assign(buf, buf + accessor.count);
+
+					for (auto input : sampler.inputs) 
+					{
+						if (input < animation.start) 
+							animation.start = input;
+						
+						if (input > animation.end) 
+							animation.end = input;
+					}
+				}
+
+				// Read sampler output T/R/S values 
+				{
+					const tinygltf::Accessor& accessor = gltfModel.accessors[samp.output];
+					const tinygltf::BufferView& bufferView = gltfModel.bufferViews[accessor.bufferView];
+					const tinygltf::Buffer& buffer = gltfModel.buffers[bufferView.buffer];
+
+					assert(accessor.componentType == TINYGLTF_COMPONENT_TYPE_FLOAT);
+
+					switch (accessor.type) {
+					case TINYGLTF_TYPE_SCALAR: {
+						const float* buf = reinterpret_cast<const float*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
+						sampler.outputs.assign(buf, buf + accessor.count);
+						break;
+					}
+					case TINYGLTF_TYPE_VEC3: {
+						const glm::vec3* buf = reinterpret_cast<const glm::vec3*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
+						for (size_t index = 0; index < accessor.count; index++) {
+							sampler.outputsVec4.push_back(glm::vec4(buf[index], 0.0f));
+						}
+						break;
+					}
+					case TINYGLTF_TYPE_VEC4: {
+						const glm::vec4* buf = reinterpret_cast<const glm::vec4*>(&buffer.data[accessor.byteOffset + bufferView.byteOffset]);
+						sampler.outputsVec4.assign(buf, buf + accessor.count);
+						break;
+					}
+					default: {
+						std::cout << "unknown type" << std::endl;
+						break;
+					}
+					}
+				}
+				animation.samplers.push_back(sampler);
+			}
+			
+			// Channels
+			for (auto& source : anim.channels) {
+				AnimationChannel channel{};
+
+				if (source.target_path == "rotation") {
+					channel.path = AnimationChannel::PathType::ROTATION;
+				}
+				if (source.target_path == "translation") {
+					channel.path = AnimationChannel::PathType::TRANSLATION;
+				}
+				if (source.target_path == "scale") {
+					channel.path = AnimationChannel::PathType::SCALE;
+				}
+				if (source.target_path == "weights") {
+					channel.path = AnimationChannel::PathType::WEIGHTS;
+				}
+				channel.samplerIndex = source.sampler;
+				channel.node = nodeFromIndex(source.target_node);
+				if (!channel.node) {
+					continue;
+				}
+				if ((channel.path == AnimationChannel::PathType::WEIGHTS) && !channel.node->mesh) {
+					continue;
+				}
+
+				animation.channels.push_back(channel);
+			}
+
+			animations.push_back(animation);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			LoadFromFile()
+	 *	назначение:			загрузить модель из файла
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::LoadFromFile(string filename, VulkanDevice* device, VkQueue transferQueue, uint32_t fileLoadingFlags, float scale)
+	{
+		tinygltf::Model gltfModel;
+		tinygltf::TinyGLTF gltfContext;
+
+		if (fileLoadingFlags & FileLoadingFlags::DontLoadImages)
+			gltfContext.SetImageLoader(loadImageDataFuncEmpty, nullptr);
+		else
+			gltfContext.SetImageLoader(loadImageDataFunc, nullptr);
+
+		size_t pos = filename.find_last_of('/');
+		path = filename.substr(0, pos);
+		
+		string error, warning;
+
+		Unload();
+		this->device = device;
+		//области кольцевых буферов должны совпадать с кадрами в полете VulkanBase
+		framesInFlight = std::max(device->framesInFlight, 1u);
+
+		bool fileLoaded = gltfContext.LoadASCIIFromFile(&gltfModel, &error, &warning, filename);
+
+		vector<uint32_t>indexBuffer;
+		vector<Vertex>vertexBuffer;
+
+		if(fileLoaded)
+		{
+			if (!(fileLoadingFlags & FileLoadingFlags::DontLoadImages))
+				loadImage(gltfModel, device, transferQueue);
+
+			LoadMaterials(gltfModel);
+
+			const tinygltf::Scene& scene = gltfModel.scenes[gltfModel.defaultScene > -1 ? gltfModel.defaultScene : 0];
+
+			size_t nodeCount = 0, meshCount = 0, primitiveCount = 0;
+			for (int root : scene.nodes)
+				CountNodes(gltfModel, root, nodeCount, meshCount, primitiveCount);
+			nodePool.Reserve(nodeCount);
+			meshPool.Reserve(meshCount);
+			primitivePool.Reserve(primitiveCount);
+			skinPool.Reserve(gltfModel.skins.size());
+
+			Node* roots = nodePool.CreateRange(scene.nodes.size());
+			for (size_t i=0; i<scene.nodes.size(); i++)
+			{
+				const tinygltf::Node node = gltfModel.nodes[scene.nodes[i]];
+				LoadNode(nullptr, &roots[i], node, scene.nodes[i], gltfModel, indexBuffer, vertexBuffer, scale);
+			}
+			
+			if (!gltfModel.animations.empty())
+				LoadAnimations(gltfModel);
+
+			LoadSkins(gltfModel);
+			PrepareJointBuffer();
+
+			//веса морфинга всех граней подряд для ModelPose
+			morphWeightCount = 0;
+			for (Node* node : linearNodes)
+			{
+				if (!node->mesh)
+					continue;
+				node->mesh->weightOffset = morphWeightCount;
+				morphWeightCount += static_cast<uint32_t>(node->mesh->weights.size());
+			}
+
+			if (fileLoadingFlags & FileLoadingFlags::CompiledAnimations)
+				CompileAnimations(animationSampleRate);
+
+			if (fileLoadingFlags & FileLoadingFlags::CompressedAnimations)
+				CompressAnimations(animationTolerance);
+
+			for(auto node: linearNodes)
+			{
+				//применить шкуру
+				if (node->skinIndex > -1)
+					node->skin = skins[node->skinIndex];
+
+				if (node->mesh)
+					node->Update();
+			}
+		}
+		else
+		{
+			tools::exitFatal("Не удалось загрузить glTF файл \"" + filename + "\": " + error, -1);
+			return;
+		}
+
+		if((fileLoadingFlags & PreTransformVertices) || (fileLoadingFlags & PreMultiplyVertexColors) || (fileLoadingFlags & FlipY))
+		{
+			const bool preTransform = fileLoadingFlags & PreTransformVertices;
+			const bool preMultiplyColor = fileLoadingFlags & PreMultiplyVertexColors;
+			const bool flipY = fileLoadingFlags & FlipY;
+			for (Node* node : linearNodes) 
+			{
+				if (node->mesh) 
+				{
+					const mat4 localMatrix = node->getMatrix();
+					for (Primitive* primitive : node->mesh->primitives) 
+					{
+						for (uint32_t i = 0; i < primitive->vertexCount; i++) 
+						{
+							Vertex& vertex = vertexBuffer[primitive->firstVertex + i];
+							// Pre-transform vertex positions by node-hierarchy
+							if (preTransform) 
+							{
+								vertex.pos = vec3(localMatrix * vec4(vertex.pos, 1.0f));
+								vertex.normal = normalize(mat3(localMatrix) * vertex.normal);
+							}
+							// Flip Y-Axis of vertex positions
+							if (flipY) 
+							{
+								vertex.pos.y *= -1.0f;
+								vertex.normal.y *= -1.0f;
+							}
+							// Pre-Multiply vertex colors with material base color
+							if (preMultiplyColor) 
+								vertex.color = primitive->material.baseColorFactor * vertex.color;
+						}
+					}
+					//смещения морфинга преобразуются так же, как вершины
+					for (MorphTarget& target : node->mesh->morphTargets)
+					{
+						for (size_t i = 0; i < target.vertices.size(); i++)
+						{
+							if (preTransform)
+							{
+								target.positions[i] = mat3(localMatrix) * target.positions[i];
+								target.normals[i] = mat3(localMatrix) * target.normals[i];
+							}
+							if (flipY)
+							{
+								target.positions[i].y *= -1.0f;
+								target.normals[i].y *= -1.0f;
+							}
+						}
+					}
+				}
+			}
+		}
+
+		for (Node* node : linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+
+			Mesh* mesh = node->mesh;
+			mesh->morphBasePositions.clear();
+			mesh->morphBaseNormals.clear();
+			for (uint32_t vertex : mesh->morphVertices)
+			{
+				mesh->morphBasePositions.push_back(vertexBuffer[vertex].pos);
+				mesh->morphBaseNormals.push_back(vertexBuffer[vertex].normal);
+			}
+		}
+
+		for (auto extension : gltfModel.extensionsUsed) 
+		{
+			if (extension == "KHR_materials_pbrSpecularGlossiness") 
+			{
+				std::cout << "Required extension: " << extension;
+				metallicRoughnessWorkflow = false;
+			}
+		}
+
+		size_t vertexBufferSize = vertexBuffer.size() * sizeof(Vertex);
+		size_t indexBufferSize = indexBuffer.size() * sizeof(uint32_t);
+		indices.count = static_cast<uint32_t>(indexBuffer.size());
+		vertices.count = static_cast<uint32_t>(vertexBuffer.size());
+
+		assert((vertexBufferSize > 0) && (indexBufferSize > 0));
+
+		struct StagingBuffer {
+			VkBuffer buffer;
+			vks::Allocation memory;
+		} vertexStaging, indexStaging;
+
+		// Create staging buffers
+		// Vertex data
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			vertexBufferSize,
+			&vertexStaging.buffer,
+			&vertexStaging.memory,
+			vertexBuffer.data()));
+		// Index data
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			indexBufferSize,
+			&indexStaging.buffer,
+			&indexStaging.memory,
+			indexBuffer.data()));
+
+		// Create device local buffers
+		// Vertex buffer
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | memoryPropertyFlags,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			vertexBufferSize,
+			&vertices.buffer,
+			&vertices.memory));
+		// Index buffer
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | memoryPropertyFlags,
+			VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+			indexBufferSize,
+			&indices.buffer,
+			&indices.memory));
+
+		// Copy from staging buffers
+		VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+		VkBufferCopy copyRegion = {};
+
+		copyRegion.size = vertexBufferSize;
+		vkCmdCopyBuffer(copyCmd, vertexStaging.buffer, vertices.buffer, 1, &copyRegion);
+
+		copyRegion.size = indexBufferSize;
+		vkCmdCopyBuffer(copyCmd, indexStaging.buffer, indices.buffer, 1, &copyRegion);
+
+		device->flushCommandBuffer(copyCmd, transferQueue, true);
+
+		vkDestroyBuffer(device->logicalDevice, vertexStaging.buffer, nullptr);
+		device->allocator.Free(vertexStaging.memory);
+		vkDestroyBuffer(device->logicalDevice, indexStaging.buffer, nullptr);
+		device->allocator.Free(indexStaging.memory);
+
+		GetSceneDimensions();
+		BuildAlphaBuckets();
+
+		// Setup descriptors
+		//параметры всех граней читаются из одного набора по динамическому смещению
+		//в режиме BindlessMaterials вместо набора на материал один набор на модель
+		const bool bindless = fileLoadingFlags & FileLoadingFlags::BindlessMaterials;
+		uint32_t imageCount{ 0 };
+		uint32_t setCount{ 2 };
+		if (bindless) {
+			imageCount = std::max(static_cast<uint32_t>(textures.size()), 1u);
+			setCount++;
+		}
+		else {
+			for (auto& material : materials) {
+				if (material.baseColorTexture != nullptr) {
+					imageCount++;
+					setCount++;
+				}
+			}
+		}
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1 },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 3 },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, bindless ? 2u : 1u },
+		};
+		if (imageCount > 0) {
+			poolSizes.push_back({ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, imageCount });
+		}
+		VkDescriptorPoolCreateInfo descriptorPoolCI{};
+		descriptorPoolCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+		descriptorPoolCI.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+		descriptorPoolCI.pPoolSizes = poolSizes.data();
+		descriptorPoolCI.maxSets = setCount;
+		VK_CHECK_RESULT(vkCreateDescriptorPool(device->logicalDevice, &descriptorPoolCI, nullptr, &descriptorPool));
+
+		// Descriptors for per-node uniform buffers
+		{
+			// Layout is global, so only create if it hasn't already been created before
+			if (descriptorSetLayoutUbo == VK_NULL_HANDLE) {
+				std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 0),
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 1),
+				};
+				VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
+				descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				descriptorLayoutCI.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
+				descriptorLayoutCI.pBindings = setLayoutBindings.data();
+				VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayoutUbo));
+			}
+			PrepareUniformRing(descriptorSetLayoutUbo);
+		}
+
+		// Descriptors for indirect drawing
+		{
+			// Layout is global, so only create if it hasn't already been created before
+			if (descriptorSetLayoutIndirect == VK_NULL_HANDLE) {
+				std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 0),
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, VK_SHADER_STAGE_VERTEX_BIT, 1),
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 2),
+				};
+				VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
+				descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				descriptorLayoutCI.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
+				descriptorLayoutCI.pBindings = setLayoutBindings.data();
+				VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayoutIndirect));
+			}
+			PrepareIndirect(descriptorSetLayoutIndirect);
+		}
+
+		// Descriptors for all materials and images of the model
+		if (bindless)
+		{
+			// Layout is global, so only create if it hasn't already been created before
+			if (descriptorSetLayoutBindless == VK_NULL_HANDLE) {
+				//комбинированный сэмплер считается и сэмплером, и изображением; гарантированный минимум пределов - 16
+				const VkPhysicalDeviceLimits& limits = device->properties.limits;
+				bindlessTextureCapacity = std::min({ MAX_BINDLESS_TEXTURES,
+					limits.maxPerStageDescriptorSamplers, limits.maxPerStageDescriptorSampledImages,
+					limits.maxDescriptorSetSamplers, limits.maxDescriptorSetSampledImages });
+				std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, VK_SHADER_STAGE_FRAGMENT_BIT, 0),
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 1, bindlessTextureCapacity),
+				};
+				//размер массива изображений задается при выделении набора, незаписанные элементы допустимы
+				std::vector<VkDescriptorBindingFlags> bindingFlags = {
+					0,
+					VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_VARIABLE_DESCRIPTOR_COUNT_BIT,
+				};
+				VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsCI{};
+				bindingFlagsCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+				bindingFlagsCI.bindingCount = static_cast<uint32_t>(bindingFlags.size());
+				bindingFlagsCI.pBindingFlags = bindingFlags.data();
+				VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
+				descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				descriptorLayoutCI.pNext = &bindingFlagsCI;
+				descriptorLayoutCI.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
+				descriptorLayoutCI.pBindings = setLayoutBindings.data();
+				VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayoutBindless));
+			}
+			PrepareBindless(descriptorSetLayoutBindless);
+		}
+		// Descriptors for per-material images
+		else
+		{
+			// Layout is global, so only create if it hasn't already been created before
+			if (descriptorSetLayoutImage == VK_NULL_HANDLE) {
+				std::vector<VkDescriptorSetLayoutBinding> setLayoutBindings = {
+					vks::initializers::descriptorSetLayoutBinding(VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, VK_SHADER_STAGE_FRAGMENT_BIT, 0),
+				};
+				VkDescriptorSetLayoutCreateInfo descriptorLayoutCI{};
+				descriptorLayoutCI.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				descriptorLayoutCI.bindingCount = static_cast<uint32_t>(setLayoutBindings.size());
+				descriptorLayoutCI.pBindings = setLayoutBindings.data();
+				VK_CHECK_RESULT(vkCreateDescriptorSetLayout(device->logicalDevice, &descriptorLayoutCI, nullptr, &descriptorSetLayoutImage));
+			}
+			for (auto& material : materials) {
+				if (material.baseColorTexture != nullptr) {
+					material.CreateDescriptorSet(descriptorPool, vkglTF::descriptorSetLayoutImage);
+				}
+			}
+		}
+	}
+	
+	/***********************************************
+	 *	функция:			BindBuffers()
+	 *	назначение:			связывание буфферов
+	 *	входящие значения:	commandBuffer - коммандный буффер
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindBuffers(VkCommandBuffer commandBuffer)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		BindBuffers(recorder, vertices.buffer);
+	}
+	
+	/***********************************************
+	 *	функция:			BindBuffers()
+	 *	назначение:			связывание буфферов с заменой буфера вершин
+	 *						(вершины экземпляра, например после морфинга)
+	 *	входящие значения:	commandBuffer - коммандный буффер
+	 *						vertexBuffer - буфер вершин экземпляра
+	 *						vertexOffset - смещение вершин в буфере
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindBuffers(VkCommandBuffer commandBuffer, VkBuffer vertexBuffer, VkDeviceSize vertexOffset)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		BindBuffers(recorder, vertexBuffer, vertexOffset);
+	}
+
+	/***********************************************
+	 *	функция:			BindBuffers()
+	 *	назначение:			связать буфер вершин (модели или экземпляра)
+	 *						и индексы модели через обертку, после
+	 *						этого отрисовка модели свои буферы не
+	 *						связывает (buffersBound)
+	 *	входящие значения:	recorder - обертка командного буфера
+	 *						vertexBuffer - буфер вершин
+	 *						vertexOffset - смещение вершин в буфере
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindBuffers(vks::CommandRecorder& recorder, VkBuffer vertexBuffer, VkDeviceSize vertexOffset)
+	{
+		recorder.BindVertexBuffer(0, vertexBuffer, vertexOffset);
+		recorder.BindIndexBuffer(indices.buffer, 0, VK_INDEX_TYPE_UINT32);
+		buffersBound = true;
+	}
+
+	/***********************************************
+	 *	функция:			BindBuffers()
+	 *	назначение:			связать буферы модели перед отрисовкой, если
+	 *						вызывающий не связал свои (buffersBound)
+	 *	входящие значения:	recorder - обертка командного буфера
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindBuffers(vks::CommandRecorder& recorder)
+	{
+		if (buffersBound)
+			return;
+		recorder.BindVertexBuffer(0, vertices.buffer);
+		recorder.BindIndexBuffer(indices.buffer, 0, VK_INDEX_TYPE_UINT32);
+	}
+
+	/***********************************************
+	 *	функция:			BindNodeTransform()
+	 *	назначение:			передать матрицу грани константой или
+	 *						связать ее блок в кольцевом буфере
+	 *	входящие значения:	mesh - грань узла
+	 *						renderFlags - PushNodeMatrix, BindNodeUniforms
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindNodeTransform(vks::CommandRecorder& recorder, const Mesh* mesh, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindNodeSet)
+	{
+		//матрицы суставов читаются только из набора грани; константа фиксирует
+		//матрицу на момент записи, в отличие от блока в кольцевом буфере
+		if ((renderFlags & RenderFlag::PushNodeMatrix) && mesh->uniformBlock.jointCount == 0)
+		{
+			recorder.PushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT, PUSH_NODE_MATRIX_OFFSET, sizeof(mat4), &mesh->uniformBlock.matrix);
+			return;
+		}
+		if (renderFlags & RenderFlag::BindNodeUniforms)
+		{
+			const NodeUniformRing* ring = mesh->uniformRing;
+			const uint32_t offsets[2] = { ring->Offset(mesh->uniformSlot), ring->JointOffset() };
+			recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindNodeSet, ring->descriptorSet, 2, offsets);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			DrawNode()
+	 *	назначение:			отображение узла модели
+	 *	входящие значения:	index - индекс узла
+	 *						parent - узел, с которого искать
+	 *						visible - видимость примитивов по cullIndex
+	 *						(nullptr - рисовать все)
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 *						(для перегрузки с командным буфером)
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::DrawNode(Node* node, VkCommandBuffer commandBuffer, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawNode(node, recorder, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+		return recorder.statistics;
+	}
+
+	void Model::DrawNode(Node* node, vks::CommandRecorder& recorder, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		bool meshVisible = node->mesh != nullptr;
+		if (meshVisible && visible)
+		{
+			meshVisible = false;
+			for (Primitive* primitive : node->mesh->primitives)
+				meshVisible |= visible[primitive->cullIndex] != 0;
+		}
+
+		if(meshVisible)
+		{
+			BindNodeTransform(recorder, node->mesh, renderFlags, pipelineLayout, bindNodeSet);
+
+			for(Primitive* primitive: node->mesh->primitives)
+			{
+				if (visible && !visible[primitive->cullIndex])
+					continue;
+
+				if (renderFlags & vkglTF::RenderFlag::BindImages)
+					recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindImageSet, primitive->material.descriptorSet);
+
+				if (renderFlags & vkglTF::RenderFlag::PushMaterialIndex)
+					recorder.PushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(uint32_t), &primitive->material.index);
+
+				recorder.DrawIndexed(primitive->indexCount, 1, primitive->firstIndex, 0, 0);
+			}
+		}
+		for (Node* child : node->children)
+			DrawNode(child, recorder, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+	}
+	
+	/***********************************************
+	 *	функция:			draw()
+	 *	назначение:			отображение модели
+	 *	входящие значения:	index - индекс узла
+	 *						parent - узел, с которого искать
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::draw(VkCommandBuffer commandBuffer, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		draw(recorder, renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+		return recorder.statistics;
+	}
+
+	/***********************************************
+	 *	функция:			draw()
+	 *	назначение:			отображение модели через обертку, уже
+	 *						связанные наборы и буферы не связываются
+	 *						повторно (в том числе между моделями и
+	 *						вызовами за кадр)
+	 *	входящие значения:	recorder - обертка командного буфера
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::draw(vks::CommandRecorder& recorder, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet)
+	{
+		DrawVisible(recorder, nullptr, renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+	}
+
+	/***********************************************
+	 *	функция:			draw()
+	 *	назначение:			отображение модели с отсечением примитивов
+	 *						вне пирамиды видимости и перекрытых
+	 *	входящие значения:	frustum - пирамида видимости в мировой
+	 *						системе координат модели
+	 *						occlusion - буфер перекрытия, уже
+	 *						отрисованный в этом кадре (или nullptr)
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::draw(VkCommandBuffer commandBuffer, const vks::Frustum& frustum, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const vks::OcclusionBuffer* occlusion)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		draw(recorder, frustum, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, occlusion);
+		return recorder.statistics;
+	}
+
+	void Model::draw(vks::CommandRecorder& recorder, const vks::Frustum& frustum, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const vks::OcclusionBuffer* occlusion)
+	{
+		UpdateBounds();
+		frustum.CheckBoxes(worldBounds, visiblePrimitives.data());
+		if (occlusion)
+			occlusion->TestBoxes(worldBounds, visiblePrimitives.data());
+		DrawVisible(recorder, visiblePrimitives.data(), renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+	}
+
+	/***********************************************
+	 *	функция:			DrawVisible()
+	 *	назначение:			отображение видимых примитивов модели
+	 *						(видимость посчитана заранее, например
+	 *						иерархией границ)
+	 *	входящие значения:	visible - видимость по Primitive::cullIndex
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::DrawVisible(VkCommandBuffer commandBuffer, const uint8_t* visible, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawVisible(recorder, visible, renderFlags, pipelineLayout, bindImageSet, bindNodeSet);
+		return recorder.statistics;
+	}
+
+	void Model::DrawVisible(vks::CommandRecorder& recorder, const uint8_t* visible, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet)
+	{
+		BindBuffers(recorder);
+		for (auto& node : nodes)
+			DrawNode(node, recorder, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+	}
+
+	/***********************************************
+	 *	функция:			UpdateBounds()
+	 *	назначение:			пересчитать мировые границы примитивов
+	 *						граней, матрица которых изменилась
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::UpdateBounds()
+	{
+		if (worldBounds.count != primitivePool.Size())
+		{
+			worldBounds.Resize(primitivePool.Size());
+			visiblePrimitives.assign(primitivePool.Size(), 1);
+			for (Mesh& mesh : meshPool)
+				mesh.boundsDirty = true;
+		}
+
+		for (Mesh& mesh : meshPool)
+		{
+			if (!mesh.boundsDirty)
+				continue;
+
+			//коробка в мировой системе: центр переносится матрицей, полуразмер - модулем ее поворота
+			const mat4& matrix = mesh.uniformBlock.matrix;
+			const mat3 extentMatrix(abs(vec3(matrix[0])), abs(vec3(matrix[1])), abs(vec3(matrix[2])));
+			for (Primitive* primitive : mesh.primitives)
+			{
+				const vec3 center = vec3(matrix * vec4(primitive->dimensions.center, 1.0f));
+				const vec3 extent = extentMatrix * (primitive->dimensions.size * 0.5f);
+				worldBounds.Set(primitive->cullIndex, center - extent, center + extent);
+			}
+			mesh.boundsDirty = false;
+		}
+	}
+	
+	/***********************************************
+	 *	функция:			BuildAlphaBuckets()
+	 *	назначение:			разложить примитивы по режимам прозрачности
+	 *						материала (один раз после загрузки)
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BuildAlphaBuckets()
+	{
+		for (vector<PrimitiveDraw>& bucket : alphaBuckets)
+			bucket.clear();
+		for (Node* node : linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+			for (Primitive* primitive : node->mesh->primitives)
+				alphaBuckets[primitive->material.alphaMode].push_back({ node, primitive });
+		}
+	}
+
+	/***********************************************
+	 *	функция:			DrawAlphaMode()
+	 *	назначение:			отображение примитивов одного режима
+	 *						прозрачности (конвейер связывает вызывающий)
+	 *	входящие значения:	alphaMode - корзина примитивов
+	 *						visible - видимость по Primitive::cullIndex
+	 *						(или nullptr)
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 *						(для перегрузки с командным буфером)
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::DrawAlphaMode(VkCommandBuffer commandBuffer, Material::AlphaMode alphaMode, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawAlphaMode(recorder, alphaMode, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+		return recorder.statistics;
+	}
+
+	void Model::DrawAlphaMode(vks::CommandRecorder& recorder, Material::AlphaMode alphaMode, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		BindBuffers(recorder);
+
+		//примитивы одной грани идут подряд, константы передаются только при смене
+		const Mesh* boundMesh = nullptr;
+		const Material* pushedMaterial = nullptr;
+		for (const PrimitiveDraw& draw : alphaBuckets[alphaMode])
+		{
+			Primitive* primitive = draw.primitive;
+			if (visible && !visible[primitive->cullIndex])
+				continue;
+
+			if (draw.node->mesh != boundMesh)
+			{
+				BindNodeTransform(recorder, draw.node->mesh, renderFlags, pipelineLayout, bindNodeSet);
+				boundMesh = draw.node->mesh;
+			}
+
+			if (renderFlags & vkglTF::RenderFlag::BindImages)
+				recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindImageSet, primitive->material.descriptorSet);
+
+			if ((renderFlags & vkglTF::RenderFlag::PushMaterialIndex) && &primitive->material != pushedMaterial)
+			{
+				recorder.PushConstants(pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(uint32_t), &primitive->material.index);
+				pushedMaterial = &primitive->material;
+			}
+
+			recorder.DrawIndexed(primitive->indexCount, 1, primitive->firstIndex, 0, 0);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			DrawDepthPrepass()
+	 *	назначение:			проход только глубины по непрозрачным
+	 *						и маскированным примитивам. Следующий проход
+	 *						цвета этих корзин рисуется с VK_COMPARE_OP_EQUAL
+	 *						без записи глубины, вершинные шейдеры обоих
+	 *						проходов должны считать положение одинаково
+	 *	входящие значения:	opaquePipeline - конвейер без фрагментного
+	 *						шейдера, вход только Position
+	 *						(Vertex::GetPipelineVertexInputState)
+	 *						maskPipeline - конвейер с проверкой alphaCutoff
+	 *						(VK_NULL_HANDLE - маскированные не рисуются,
+	 *						их проход цвета тогда с LESS_OR_EQUAL)
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 *						(для перегрузки с командным буфером)
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::DrawDepthPrepass(VkCommandBuffer commandBuffer, VkPipeline opaquePipeline, VkPipeline maskPipeline, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawDepthPrepass(recorder, opaquePipeline, maskPipeline, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+		return recorder.statistics;
+	}
+
+	void Model::DrawDepthPrepass(vks::CommandRecorder& recorder, VkPipeline opaquePipeline, VkPipeline maskPipeline, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		//непрозрачным материалы не нужны
+		recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, opaquePipeline);
+		DrawAlphaMode(recorder, Material::ALPHAMODE_OPAQUE, renderFlags & (RenderFlag::BindNodeUniforms | RenderFlag::PushNodeMatrix), pipelineLayout, bindImageSet, bindNodeSet, visible);
+
+		if (maskPipeline != VK_NULL_HANDLE && !alphaBuckets[Material::ALPHAMODE_MASK].empty())
+		{
+			recorder.BindPipeline(VK_PIPELINE_BIND_POINT_GRAPHICS, maskPipeline);
+			DrawAlphaMode(recorder, Material::ALPHAMODE_MASK, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+		}
+	}
+
+	/***********************************************
+	 *	функция:			DrawBlended()
+	 *	назначение:			отображение полупрозрачных примитивов
+	 *						сзади вперед (после непрозрачных)
+	 *	входящие значения:	cameraPosition - положение камеры в мировой
+	 *						системе координат модели
+	 *						visible - видимость по Primitive::cullIndex
+	 *						(или nullptr)
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 *						(для перегрузки с командным буфером)
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::DrawBlended(VkCommandBuffer commandBuffer, vec3 cameraPosition, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawBlended(recorder, cameraPosition, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+		return recorder.statistics;
+	}
+
+	void Model::DrawBlended(vks::CommandRecorder& recorder, vec3 cameraPosition, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindImageSet, uint32_t bindNodeSet, const uint8_t* visible)
+	{
+		vector<PrimitiveDraw>& bucket = alphaBuckets[Material::ALPHAMODE_BLEND];
+		if (bucket.empty())
+			return;
+
+		//порядок прошлого кадра почти верный, сортировка вставками почти линейна
+		UpdateBounds();
+		auto distance = [&](const PrimitiveDraw& draw)
+		{
+			const uint32_t i = draw.primitive->cullIndex;
+			const vec3 center = 0.5f * vec3(worldBounds.minX[i] + worldBounds.maxX[i], worldBounds.minY[i] + worldBounds.maxY[i], worldBounds.minZ[i] + worldBounds.maxZ[i]);
+			const vec3 offset = center - cameraPosition;
+			return dot(offset, offset);
+		};
+		for (size_t i = 1; i < bucket.size(); i++)
+		{
+			const PrimitiveDraw draw = bucket[i];
+			const float key = distance(draw);
+			size_t j = i;
+			for (; j > 0 && distance(bucket[j - 1]) < key; j--)
+				bucket[j] = bucket[j - 1];
+			bucket[j] = draw;
+		}
+
+		DrawAlphaMode(recorder, Material::ALPHAMODE_BLEND, renderFlags, pipelineLayout, bindImageSet, bindNodeSet, visible);
+	}
+
+	/***********************************************
+	 *	функция:			GetNodeDimensions()
+	 *	назначение:			получение размерности узла
+	 *	входящие значения:	index - индекс узла
+	 *						parent - узел, с которого искать
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::GetNodeDimensions(Node* node, vec3& min, vec3& max)
+	{
+		if (node->mesh) {
+			for (Primitive* primitive : node->mesh->primitives) {
+				glm::vec4 locMin = glm::vec4(primitive->dimensions.min, 1.0f) * node->getMatrix();
+				glm::vec4 locMax = glm::vec4(primitive->dimensions.max, 1.0f) * node->getMatrix();
+				if (locMin.x < min.x) { min.x = locMin.x; }
+				if (locMin.y < min.y) { min.y = locMin.y; }
+				if (locMin.z < min.z) { min.z = locMin.z; }
+				if (locMax.x > max.x) { max.x = locMax.x; }
+				if (locMax.y > max.y) { max.y = locMax.y; }
+				if (locMax.z > max.z) { max.z = locMax.z; }
+			}
+		}
+		for (Node* child : node->children) {
+			GetNodeDimensions(child, min, max);
+		}
+	}
+	
+	/***********************************************
+	 *	функция:			GetSceneDimensions()
+	 *	назначение:			получение размерности сцены
+	 *	входящие значения:	index - индекс узла
+	 *						parent - узел, с которого искать
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::GetSceneDimensions()
+	{
+		dimensions.min = vec3(FLT_MAX);
+		dimensions.max = vec3(-FLT_MAX);
+		for (auto node : nodes) {
+			GetNodeDimensions(node, dimensions.min, dimensions.max);
+		}
+		dimensions.size = dimensions.max - dimensions.min;
+		dimensions.center = (dimensions.min + dimensions.max) / 2.0f;
+		dimensions.radius = glm::distance(dimensions.min, dimensions.max) / 2.0f;
+	}
+	
+	/***********************************************
+	 *	функция:			CompileAnimations()
+	 *	назначение:			пересэмплировать анимации в клипы
+	 *						с постоянным шагом (формат SoA)
+	 *	входящие значения:	sampleRate - число кадров в секунду
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::CompileAnimations(float sampleRate)
+	{
+		clips.resize(animations.size());
+		for (size_t i = 0; i < animations.size(); i++)
+			clips[i].Compile(animations[i], sampleRate);
+	}
+
+	/***********************************************
+	 *	функция:			CompressAnimations()
+	 *	назначение:			сжать ключи анимаций модели
+	 *	входящие значения:	tolerance - допустимая ошибка (единицы
+	 *						модели для смещения и масштаба,
+	 *						радианы для вращения)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::CompressAnimations(float tolerance)
+	{
+		for (auto& animation : animations)
+		{
+			for (auto& channel : animation.channels)
+			{
+				if (channel.path != AnimationChannel::PathType::WEIGHTS)
+					animation.samplers[channel.samplerIndex].Compress(channel.path, tolerance);
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			UpdateAnimation()
+	 *	назначение:			применить анимацию к узлам модели
+	 *	входящие значения:	index - индекс анимации
+	 *						time - время анимации
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::UpdateAnimation(uint32_t index, float time)
+	{
+		if (AnimateNodes(index, time))
+		{
+			for (auto& node : nodes)
+				node->Update();
+		}
+	}
+
+	/***********************************************
+	 *	функция:			AnimateNodes()
+	 *	назначение:			записать анимацию в узлы модели без
+	 *						обновления буферов (Node::Update)
+	 *	входящие значения:	index - индекс анимации
+	 *						time - время анимации
+	 *						pose - поза для весов морфинга (из рабочего
+	 *						потока: Mesh::weights читает поток отрисовки,
+	 *						веса попадают в грани в UploadPose);
+	 *						nullptr - писать в Mesh::weights
+	 *	выходящие значения:	true, если узлы изменились
+	 **********************************************/
+	bool Model::AnimateNodes(uint32_t index, float time, ModelPose* pose)
+	{
+		if (index > static_cast<uint32_t>(animations.size()) - 1) {
+			std::cout << "No animation with index " << index << std::endl;
+			return false;
+		}
+
+		//грани без канала весов сохраняют веса прошлого кадра
+		if (pose)
+		{
+			pose->morphWeights.resize(morphWeightCount);
+			for (Node* node : linearNodes)
+			{
+				if (node->mesh)
+					copy(node->mesh->weights.begin(), node->mesh->weights.end(), pose->morphWeights.begin() + node->mesh->weightOffset);
+			}
+		}
+		auto sampleWeights = [&](const AnimationSampler& sampler, const AnimationChannel& channel)
+		{
+			Mesh* mesh = channel.node->mesh;
+			if (!mesh)
+				return;
+			float* weights = pose ? pose->morphWeights.data() + mesh->weightOffset : mesh->weights.data();
+			sampler.SampleWeights(time, weights, mesh->weights.size());
+		};
+
+		//скомпилированный клип: индекс кадра за O(1) и интерполяция всех каналов сразу
+		if (index < clips.size())
+		{
+			clips[index].Sample(time, animationPose);
+			clips[index].Apply(animationPose);
+
+			//веса морфинга в клип не компилируются
+			for (auto& channel : animations[index].channels)
+			{
+				if (channel.path == AnimationChannel::PathType::WEIGHTS)
+					sampleWeights(animations[index].samplers[channel.samplerIndex], channel);
+			}
+			return true;
+		}
+
+		Animation& animation = animations[index];
+
+		bool updated = false;
+		for (auto& channel : animation.channels)
+		{
+			AnimationSampler& sampler = animation.samplers[channel.samplerIndex];
+			if (!sampler.IsValid())
+				continue;
+
+			if ((time < sampler.KeyTime(0)) || (time > sampler.KeyTime(sampler.KeyCount() - 1)))
+				continue;
+
+			if (channel.path == AnimationChannel::PathType::WEIGHTS)
+			{
+				sampleWeights(sampler, channel);
+				continue;
+			}
+
+			const vec4 value = sampler.Sample(time, channel.path);
+			switch (channel.path) {
+			case vkglTF::AnimationChannel::PathType::TRANSLATION:
+				channel.node->translation = vec3(value);
+				break;
+			case vkglTF::AnimationChannel::PathType::SCALE:
+				channel.node->scale = vec3(value);
+				break;
+			case vkglTF::AnimationChannel::PathType::ROTATION:
+				channel.node->rotation = quat(value.w, value.x, value.y, value.z);
+				break;
+			}
+			updated = true;
+		}
+
+		return updated;
+	}
+
+	/***********************************************
+	 *	функция:			EvaluatePose()
+	 *	назначение:			посчитать мировые матрицы узлов и палитры
+	 *						скинов без записи в буферы (можно вызывать
+	 *						из рабочего потока)
+	 *	входящие значения:	pose - поза для записи результата
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::EvaluatePose(ModelPose& pose)
+	{
+		uint32_t maxIndex = 0;
+		for (Node* node : linearNodes)
+			maxIndex = std::max(maxIndex, node->index);
+		pose.worldMatrices.resize(maxIndex + 1);
+
+		//обход сверху вниз: матрица родителя считается один раз
+		vector<Node*> stack(nodes.begin(), nodes.end());
+		while (!stack.empty())
+		{
+			Node* node = stack.back();
+			stack.pop_back();
+			const mat4 parent = node->parent ? pose.worldMatrices[node->parent->index] : mat4(1.0f);
+			pose.worldMatrices[node->index] = parent * node->localMatrix();
+			for (Node* child : node->children)
+				stack.push_back(child);
+		}
+
+		pose.jointMatrices.resize(jointPalette.size());
+		for (Node* node : linearNodes)
+		{
+			if (!node->mesh || !node->skin)
+				continue;
+
+			const Skin* skin = node->skin;
+			const mat4 inverseTransform = inverse(pose.worldMatrices[node->index]);
+			for (size_t i = 0; i < skin->joints.size(); i++)
+				pose.jointMatrices[skin->jointOffset + i] = inverseTransform * pose.worldMatrices[skin->joints[i]->index] * skin->inverseBindMatrices[i];
+		}
+	}
+
+	/***********************************************
+	 *	функция:			UploadPose()
+	 *	назначение:			записать рассчитанную позу в буферы граней
+	 *						и общий буфер матриц суставов, веса
+	 *						морфинга - в Mesh::weights
+	 *	входящие значения:	pose - поза из EvaluatePose()
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::UploadPose(const ModelPose& pose)
+	{
+		if (pose.worldMatrices.empty())
+			return;
+
+		for (Node* node : linearNodes)
+		{
+			if (!node->mesh)
+				continue;
+
+			Mesh* mesh = node->mesh;
+			mesh->uniformBlock.matrix = pose.worldMatrices[node->index];
+			if (node->skin)
+			{
+				mesh->uniformBlock.jointOffset = node->skin->jointOffset;
+				mesh->uniformBlock.jointCount = node->skin->computeSkinned ? 0 : static_cast<uint32_t>(node->skin->joints.size());
+			}
+			mesh->boundsDirty = true;
+			mesh->UpdateUniforms();
+
+			if (!pose.morphWeights.empty())
+			{
+				const float* weights = pose.morphWeights.data() + mesh->weightOffset;
+				copy(weights, weights + mesh->weights.size(), mesh->weights.begin());
+			}
+		}
+
+		if (!pose.jointMatrices.empty())
+		{
+			memcpy(jointPalette.data(), pose.jointMatrices.data(), pose.jointMatrices.size() * sizeof(mat4));
+			uniformRing.WriteJoints(0, jointPalette.data(), jointPalette.size());
+		}
+	}
+	
+	/***********************************************
+	 *	функция:			FindNode()
+	 *	назначение:			поиск узла (дочернего узла) по индексу
+	 *	входящие значения:	index - индекс узла
+	 *						parent - узел, с которого искать
+	 *	выходящие значения:	нет
+	 **********************************************/
+	Node* Model::FindNode(Node* parent, uint32_t index)
+	{
+		Node* nodeFound = nullptr;
+
+		if (parent->index == index)
+			return parent;
+
+		for (Node* child : parent->children)
+		{
+			nodeFound = FindNode(child, index);
+			if(nodeFound)
+				break;
+		}
+		return nodeFound;
+	}
+
+	/***********************************************
+	 *	функция:			nodeFromIndex()
+	 *	назначение:			поиск узла по индексу
+	 *	входящие значения:	index - индекс узла
+	 *	выходящие значения:	нет
+	 **********************************************/
+	Node* Model::nodeFromIndex(uint32_t index)
+	{
+		Node* nodeFound = nullptr;
+
+		for(auto& node: nodes)
+		{
+			nodeFound = FindNode(node, index);
+			if(nodeFound)
+				break;
+		}
+		return nodeFound;
+	}
+	
+	/***********************************************
+	 *	функция:			PrepareUniformRing()
+	 *	назначение:			разместить блоки параметров всех граней
+	 *						в кольцевом буфере (framesInFlight областей)
+	 *						и создать общий набор дескрипторов
+	 *	входящие значения:	descriptorSetLayout - макет набора граней
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::PrepareUniformRing(VkDescriptorSetLayout descriptorSetLayout)
+	{
+		//кольцо читается и как uniform, и как storage буфер (непрямая отрисовка)
+		const VkDeviceSize alignment = std::max<VkDeviceSize>(std::max(device->properties.limits.minUniformBufferOffsetAlignment, device->properties.limits.minStorageBufferOffsetAlignment), 16);
+		uniformRing.stride = (sizeof(Mesh::UniformBlock) + alignment - 1) & ~(alignment - 1);
+		uniformRing.frameCount = std::max(framesInFlight, 1u);
+		uniformRing.frame = 0;
+
+		uint32_t slot = 0;
+		for (Mesh& mesh : meshPool)
+		{
+			mesh.uniformRing = &uniformRing;
+			mesh.uniformSlot = slot++;
+		}
+		uniformRing.frameSize = uniformRing.stride * std::max(slot, 1u);
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&uniformRing.buffer,
+			uniformRing.frameSize * uniformRing.frameCount));
+		VK_CHECK_RESULT(uniformRing.buffer.map());
+
+		//все области начинаются с текущих значений граней
+		for (uint32_t frame = 0; frame < uniformRing.frameCount; frame++)
+			BeginFrame(frame);
+		BeginFrame(0);
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
+		descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocInfo.pSetLayouts = &descriptorSetLayout;
+		descriptorSetAllocInfo.descriptorSetCount = 1;
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &descriptorSetAllocInfo, &uniformRing.descriptorSet));
+
+		//динамический буфер описывает один блок, смещение задается при связывании
+		VkDescriptorBufferInfo uniformDescriptor{ uniformRing.buffer.buffer, 0, sizeof(Mesh::UniformBlock) };
+
+		VkWriteDescriptorSet writeDescriptorSets[2]{};
+		writeDescriptorSets[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+		writeDescriptorSets[0].descriptorCount = 1;
+		writeDescriptorSets[0].dstSet = uniformRing.descriptorSet;
+		writeDescriptorSets[0].dstBinding = 0;
+		writeDescriptorSets[0].pBufferInfo = &uniformDescriptor;
+
+		//матрицы суставов: область кадра общего буфера модели, смещение скина передается в UniformBlock
+		writeDescriptorSets[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC;
+		writeDescriptorSets[1].descriptorCount = 1;
+		writeDescriptorSets[1].dstSet = uniformRing.descriptorSet;
+		writeDescriptorSets[1].dstBinding = 1;
+		writeDescriptorSets[1].pBufferInfo = &jointBuffer.descriptor;
+
+		vkUpdateDescriptorSets(device->logicalDevice, 2, writeDescriptorSets, 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			BeginFrame()
+	 *	назначение:			перейти к области кадра в кольцевом буфере
+	 *						и записать в нее блоки всех граней и палитры
+	 *						суставов (вызывать после ожидания ограждения
+	 *						кадра, до обновления узлов и записи команд)
+	 *	входящие значения:	frameIndex - номер кадра в полете
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BeginFrame(uint32_t frameIndex)
+	{
+		if (!uniformRing.buffer.mapped)
+			return;
+
+		uniformRing.frame = frameIndex % uniformRing.frameCount;
+		for (Mesh& mesh : meshPool)
+			mesh.UpdateUniforms();
+		uniformRing.WriteJoints(0, jointPalette.data(), jointPalette.size());
+	}
+
+	/***********************************************
+	 *	функция:			PrepareIndirect()
+	 *	назначение:			построить буфер команд непрямой отрисовки
+	 *						и данные примитивов, команды группируются
+	 *						по режиму прозрачности материала
+	 *	входящие значения:	descriptorSetLayout - макет набора
+	 *						(descriptorSetLayoutIndirect)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::PrepareIndirect(VkDescriptorSetLayout descriptorSetLayout)
+	{
+		vector<VkDrawIndexedIndirectCommand> commands;
+		vector<DrawData> drawData;
+		for (uint32_t mode = 0; mode < 3; mode++)
+		{
+			indirectBatches[mode].firstCommand = static_cast<uint32_t>(commands.size());
+			for (Node* node : linearNodes)
+			{
+				if (!node->mesh)
+					continue;
+
+				for (Primitive* primitive : node->mesh->primitives)
+				{
+					if (primitive->material.alphaMode != mode)
+						continue;
+
+					//индексы абсолютные, номер записи передается через firstInstance
+					VkDrawIndexedIndirectCommand command{};
+					command.indexCount = primitive->indexCount;
+					command.instanceCount = 1;
+					command.firstIndex = primitive->firstIndex;
+					command.vertexOffset = 0;
+					command.firstInstance = static_cast<uint32_t>(commands.size());
+					commands.push_back(command);
+
+					DrawData data{};
+					data.transformIndex = static_cast<uint32_t>(node->mesh->uniformSlot * uniformRing.stride / 16);
+					data.materialIndex = static_cast<uint32_t>(&primitive->material - materials.data());
+					data.firstIndex = primitive->firstIndex;
+					data.indexCount = primitive->indexCount;
+					data.bounds = vec4(primitive->dimensions.center, primitive->dimensions.radius);
+					drawData.push_back(data);
+				}
+			}
+			indirectBatches[mode].commandCount = static_cast<uint32_t>(commands.size()) - indirectBatches[mode].firstCommand;
+		}
+		indirectCommandCount = static_cast<uint32_t>(commands.size());
+		indirectCommands = commands;
+
+		//буферы не могут быть пустыми
+		commands.resize(std::max<size_t>(commands.size(), 1));
+		drawData.resize(std::max<size_t>(drawData.size(), 1));
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&indirectBuffer,
+			commands.size() * sizeof(VkDrawIndexedIndirectCommand),
+			commands.data()));
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&drawDataBuffer,
+			drawData.size() * sizeof(DrawData),
+			drawData.data()));
+
+		VkDescriptorSetAllocateInfo descriptorSetAllocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &descriptorSetAllocInfo, &indirectDescriptorSet));
+
+		//кольцо граней целиком на один кадр, смещение кадра задается при связывании
+		VkDescriptorBufferInfo ringDescriptor{ uniformRing.buffer.buffer, 0, uniformRing.frameSize };
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+			vks::initializers::writeDescriptorSet(indirectDescriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 0, &ringDescriptor),
+			vks::initializers::writeDescriptorSet(indirectDescriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 1, &jointBuffer.descriptor),
+			vks::initializers::writeDescriptorSet(indirectDescriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 2, &drawDataBuffer.descriptor),
+		};
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			PrepareBindless()
+	 *	назначение:			записать параметры всех материалов в буфер
+	 *						материалов и все текстуры модели в один
+	 *						массив изображений
+	 *	входящие значения:	descriptorSetLayout - макет набора
+	 *						(descriptorSetLayoutBindless)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::PrepareBindless(VkDescriptorSetLayout descriptorSetLayout)
+	{
+		if (textures.size() > bindlessTextureCapacity)
+			tools::exitFatal("Число текстур модели \"" + path + "\" больше " + std::to_string(bindlessTextureCapacity) + " (пределы устройства на сэмплеры)", -1);
+
+		auto textureIndex = [this](const Texture* texture) {
+			return texture ? static_cast<int32_t>(texture - textures.data()) : -1;
+		};
+
+		vector<MaterialData> materialData(materials.size());
+		for (const Material& material : materials)
+		{
+			MaterialData& data = materialData[material.index];
+			data = {};
+			data.baseColorFactor = material.baseColorFactor;
+			data.metallicFactor = material.metallicFactor;
+			data.roughnessFactor = material.roughnessFactor;
+			data.alphaCutoff = material.alphaCutoff;
+			data.alphaMode = material.alphaMode;
+			data.baseColorTexture = textureIndex(material.baseColorTexture);
+			data.metallicRoughnessTexture = textureIndex(material.metallicRoughnessTexture);
+			data.normalTexture = textureIndex(material.normalTexture);
+			data.occlusionTexture = textureIndex(material.occlusionTexture);
+			data.emissiveTexture = textureIndex(material.emissiveTexture);
+		}
+
+		VK_CHECK_RESULT(device->createBuffer(
+			VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+			&materialBuffer,
+			materialData.size() * sizeof(MaterialData),
+			materialData.data()));
+
+		const uint32_t textureCount = std::max(static_cast<uint32_t>(textures.size()), 1u);
+		VkDescriptorSetVariableDescriptorCountAllocateInfo variableCountInfo{};
+		variableCountInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+		variableCountInfo.descriptorSetCount = 1;
+		variableCountInfo.pDescriptorCounts = &textureCount;
+		VkDescriptorSetAllocateInfo descriptorSetAllocInfo = vks::initializers::descriptorSetAllocateInfo(descriptorPool, &descriptorSetLayout, 1);
+		descriptorSetAllocInfo.pNext = &variableCountInfo;
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &descriptorSetAllocInfo, &bindlessDescriptorSet));
+
+		vector<VkDescriptorImageInfo> imageDescriptors;
+		for (const Texture& texture : textures)
+			imageDescriptors.push_back(texture.descriptor);
+
+		std::vector<VkWriteDescriptorSet> writeDescriptorSets = {
+			vks::initializers::writeDescriptorSet(bindlessDescriptorSet, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 0, &materialBuffer.descriptor),
+		};
+		if (!imageDescriptors.empty())
+		{
+			VkWriteDescriptorSet imageWrite = vks::initializers::writeDescriptorSet(bindlessDescriptorSet, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 1, imageDescriptors.data(), static_cast<uint32_t>(imageDescriptors.size()));
+			writeDescriptorSets.push_back(imageWrite);
+		}
+		vkUpdateDescriptorSets(device->logicalDevice, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, nullptr);
+	}
+
+	/***********************************************
+	 *	функция:			BindMaterials()
+	 *	назначение:			связать набор материалов и текстур модели
+	 *						(один раз на кадр вместо набора на примитив)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						pipelineLayout - макет конвейера
+	 *						bindSet - номер набора материалов
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindMaterials(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t bindSet)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		BindMaterials(recorder, pipelineLayout, bindSet);
+	}
+
+	void Model::BindMaterials(vks::CommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t bindSet)
+	{
+		recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindSet, bindlessDescriptorSet);
+	}
+
+	/***********************************************
+	 *	функция:			BindIndirect()
+	 *	назначение:			связать буферы модели и набор данных
+	 *						непрямой отрисовки текущего кадра
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						pipelineLayout - макет конвейера
+	 *						bindSet - номер набора данных отрисовки
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Model::BindIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t bindSet)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		BindIndirect(recorder, pipelineLayout, bindSet);
+	}
+
+	void Model::BindIndirect(vks::CommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t bindSet)
+	{
+		BindBuffers(recorder);
+
+		const uint32_t frameOffsets[2] = { uniformRing.Offset(0), uniformRing.JointOffset() };
+		recorder.BindDescriptorSet(VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, bindSet, indirectDescriptorSet, 2, frameOffsets);
+	}
+
+	/***********************************************
+	 *	функция:			DrawIndirect()
+	 *	назначение:			отобразить все примитивы с заданным режимом
+	 *						прозрачности одной непрямой командой
+	 *						(шейдер indirect.vert)
+	 *	входящие значения:	commandBuffer - командный буфер
+	 *						pipelineLayout - макет конвейера
+	 *						alphaMode - режим прозрачности (конвейер)
+	 *						bindSet - номер набора данных отрисовки
+	 *	выходящие значения:	счетчики привязок и вызовов отрисовки
+	 **********************************************/
+	vks::CommandRecorder::Statistics Model::DrawIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, Material::AlphaMode alphaMode, uint32_t bindSet)
+	{
+		vks::CommandRecorder recorder(commandBuffer);
+		DrawIndirect(recorder, pipelineLayout, alphaMode, bindSet);
+		return recorder.statistics;
+	}
+
+	void Model::DrawIndirect(vks::CommandRecorder& recorder, VkPipelineLayout pipelineLayout, Material::AlphaMode alphaMode, uint32_t bindSet)
+	{
+		const IndirectBatch& batch = indirectBatches[alphaMode];
+		if (batch.commandCount == 0)
+			return;
+
+		BindIndirect(recorder, pipelineLayout, bindSet);
+
+		const VkDeviceSize offset = batch.firstCommand * sizeof(VkDrawIndexedIndirectCommand);
+		if (!device->enabledFeatures.drawIndirectFirstInstance)
+		{
+			//ненулевой firstInstance допустим только в прямой команде
+			for (uint32_t i = batch.firstCommand; i < batch.firstCommand + batch.commandCount; i++)
+			{
+				const VkDrawIndexedIndirectCommand& command = indirectCommands[i];
+				recorder.DrawIndexed(command.indexCount, command.instanceCount, command.firstIndex, command.vertexOffset, command.firstInstance);
+			}
+		}
+		else if (device->enabledFeatures.multiDrawIndirect)
+		{
+			recorder.DrawIndexedIndirect(indirectBuffer.buffer, offset, batch.commandCount, sizeof(VkDrawIndexedIndirectCommand));
+		}
+		else
+		{
+			//без multiDrawIndirect по одной команде, буфер остается тем же
+			for (uint32_t i = 0; i < batch.commandCount; i++)
+				recorder.DrawIndexedIndirect(indirectBuffer.buffer, offset + i * sizeof(VkDrawIndexedIndirectCommand), 1, sizeof(VkDrawIndexedIndirectCommand));
+		}
+	}
+
+	
+	/*************************************************************************
+	 * класс для загрузки glTF текстуры
+	 *
+	***********************************************************************/
+	/***********************************************
+	 *	функция:			nodeFromIndex()
+	 *	назначение:			поиск узла по индексу
+	 *	входящие значения:	index - индекс узла
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Texture::UpdateDescriptor()
+	{
+		descriptor.sampler = sampler;
+		descriptor.imageView = view;
+		descriptor.imageLayout = imageLayout;
+	}
+	
+	/***********************************************
+	 *	функция:			nodeFromIndex()
+	 *	назначение:			поиск узла по индексу
+	 *	входящие значения:	index - индекс узла
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Texture::Destroy()
+	{
+		vkDestroyImageView(device->logicalDevice, view, nullptr);
+		vkDestroyImage(device->logicalDevice, image, nullptr);
+		device->allocator.Free(deviceMemory);
+		vkDestroySampler(device->logicalDevice, sampler, nullptr);
+	}
+	
+	/***********************************************
+	 *	функция:			nodeFromIndex()
+	 *	назначение:			поиск узла по индексу
+	 *	входящие значения:	index - индекс узла
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Texture::FromglTfImage(tinygltf::Image& gltfimage, string path, VulkanDevice* device, VkQueue copyQueue)
+	{
+		this->device = device;
+
+		bool isKtx = false;
+		// Image points to an external ktx file
+		if (gltfimage.uri.find_last_of(".") != std::string::npos) {
+			if (gltfimage.uri.substr(gltfimage.uri.find_last_of(".") + 1) == "ktx") {
+				isKtx = true;
+			}
+		}
+
+		VkFormat format;
+
+		if(!isKtx)
+		{
+			// Texture was loaded using STB_Image
+
+			unsigned char* buffer = nullptr;
+			VkDeviceSize bufferSize = 0;
+			bool deleteBuffer = false;
+			if (gltfimage.component == 3) 
+			{
+				// Most devices don't support RGB only on Vulkan so convert if necessary
+				// TODO: Check actual format support and transform only if required
+				bufferSize = gltfimage.width * gltfimage.height * 4;
+				buffer = new unsigned char[bufferSize];
+				unsigned char* rgba = buffer;
+				unsigned char* rgb = &gltfimage.image[0];
+				for (size_t i = 0; i < gltfimage.width * gltfimage.height; ++i) {
+					for (int32_t j = 0; j < 3; ++j) {
+						rgba[j] = rgb[j];
+					}
+					rgba += 4;
+					rgb += 3;
+				}
+				deleteBuffer = true;
+			}
+			else
+			{
+				buffer = &gltfimage.image[0];
+				bufferSize = gltfimage.image.size();
+			}
+
+			format = VK_FORMAT_R8G8B8A8_UNORM;
+
+			VkFormatProperties formatProperties;
+
+			width = gltfimage.width;
+			height = gltfimage.height;
+
+			//моя правка
+			mipLevels = static_cast<uint32_t>(floor(std::log2(std::max(width, height))) + 1.0);
+
+			vkGetPhysicalDeviceFormatProperties(device->physicalDevice, format, &formatProperties);
+			assert(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_SRC_BIT);
+			assert(formatProperties.optimalTilingFeatures & VK_FORMAT_FEATURE_BLIT_DST_BIT);
+
+			
+
+			VkBuffer stagingBuffer;
+			vks::Allocation stagingMemory;
+
+			VkBufferCreateInfo bufferCreateInfo{};
+			bufferCreateInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+			bufferCreateInfo.size = bufferSize;
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			VK_CHECK_RESULT(vkCreateBuffer(device->logicalDevice, &bufferCreateInfo, nullptr, &stagingBuffer));
+			VK_CHECK_RESULT(device->allocator.AllocateBuffer(stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingMemory));
+
+			uint8_t* data = static_cast<uint8_t*>(stagingMemory.mapped);
+			memcpy(data, buffer, bufferSize);
+
+			VkImageCreateInfo imageCreateInfo{};
+			imageCreateInfo.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageCreateInfo.format = format;
+			imageCreateInfo.mipLevels = mipLevels;
+			imageCreateInfo.arrayLayers = 1;
+			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT;
+			imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageCreateInfo.extent = { width, height, 1 };
+			imageCreateInfo.usage = VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT;
+			VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageCreateInfo, nullptr, &image));
+			VK_CHECK_RESULT(device->allocator.AllocateImage(image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, deviceMemory));
+
+			VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+			VkImageSubresourceRange subresourceRange = {};
+			subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			subresourceRange.levelCount = 1;
+			subresourceRange.layerCount = 1;
+
+			{
+				VkImageMemoryBarrier imageMemoryBarrier{};
+				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				imageMemoryBarrier.srcAccessMask = 0;
+				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				imageMemoryBarrier.image = image;
+				imageMemoryBarrier.subresourceRange = subresourceRange;
+				vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+			}
+
+			VkBufferImageCopy bufferCopyRegion = {};
+			bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			bufferCopyRegion.imageSubresource.mipLevel = 0;
+			bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
+			bufferCopyRegion.imageSubresource.layerCount = 1;
+			bufferCopyRegion.imageExtent.width = width;
+			bufferCopyRegion.imageExtent.height = height;
+			bufferCopyRegion.imageExtent.depth = 1;
+
+			vkCmdCopyBufferToImage(copyCmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &bufferCopyRegion);
+
+			{
+				VkImageMemoryBarrier imageMemoryBarrier{};
+				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+				imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				imageMemoryBarrier.image = image;
+				imageMemoryBarrier.subresourceRange = subresourceRange;
+				vkCmdPipelineBarrier(copyCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+			}
+
+			device->flushCommandBuffer(copyCmd, copyQueue, true);
+
+			device->allocator.Free(stagingMemory);
+			vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
+
+			// Generate the mip chain (glTF uses jpg and png, so we need to create this manually)
+			VkCommandBuffer blitCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+
+			for (uint32_t i = 1; i < mipLevels; i++) {
+				VkImageBlit imageBlit{};
+
+				imageBlit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				imageBlit.srcSubresource.layerCount = 1;
+				imageBlit.srcSubresource.mipLevel = i - 1;
+				imageBlit.srcOffsets[1].x = int32_t(width >> (i - 1));
+				imageBlit.srcOffsets[1].y = int32_t(height >> (i - 1));
+				imageBlit.srcOffsets[1].z = 1;
+
+				imageBlit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				imageBlit.dstSubresource.layerCount = 1;
+				imageBlit.dstSubresource.mipLevel = i;
+				imageBlit.dstOffsets[1].x = int32_t(width >> i);
+				imageBlit.dstOffsets[1].y = int32_t(height >> i);
+				imageBlit.dstOffsets[1].z = 1;
+
+				VkImageSubresourceRange mipSubRange = {};
+				mipSubRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				mipSubRange.baseMipLevel = i;
+				mipSubRange.levelCount = 1;
+				mipSubRange.layerCount = 1;
+
+				{
+					VkImageMemoryBarrier imageMemoryBarrier{};
+					imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+					imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+					imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					imageMemoryBarrier.srcAccessMask = 0;
+					imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					imageMemoryBarrier.image = image;
+					imageMemoryBarrier.subresourceRange = mipSubRange;
+					vkCmdPipelineBarrier(blitCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+				}
+
+				vkCmdBlitImage(blitCmd, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &imageBlit, VK_FILTER_LINEAR);
+
+				{
+					VkImageMemoryBarrier imageMemoryBarrier{};
+					imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+					imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+					imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+					imageMemoryBarrier.image = image;
+					imageMemoryBarrier.subresourceRange = mipSubRange;
+					vkCmdPipelineBarrier(blitCmd, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+				}
+			}
+
+			subresourceRange.levelCount = mipLevels;
+			imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+			{
+				VkImageMemoryBarrier imageMemoryBarrier{};
+				imageMemoryBarrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+				imageMemoryBarrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+				imageMemoryBarrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				imageMemoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+				imageMemoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+				imageMemoryBarrier.image = image;
+				imageMemoryBarrier.subresourceRange = subresourceRange;
+				vkCmdPipelineBarrier(blitCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+			}
+
+			device->flushCommandBuffer(blitCmd, copyQueue, true);
+		}
+		else
+		{
+			// Texture is stored in an external ktx file
+			std::string filename = path + "/" + gltfimage.uri;
+
+			ktxTexture* ktxTexture;
+
+			ktxResult result = KTX_SUCCESS;
+
+			if (!tools::fileExists(filename)) {
+				tools::exitFatal("Could not load texture from " + filename + "\n\nThe file may be part of the additional asset pack.\n\nRun \"download_assets.py\" in the repository root to download the latest version.", -1);
+			}
+			result = ktxTexture_CreateFromNamedFile(filename.c_str(), KTX_TEXTURE_CREATE_LOAD_IMAGE_DATA_BIT, &ktxTexture);
+			assert(result == KTX_SUCCESS);
+
+			this->device = device;
+			width = ktxTexture->baseWidth;
+			height = ktxTexture->baseHeight;
+			mipLevels = ktxTexture->numLevels;
+
+			ktx_uint8_t* ktxTextureData = ktxTexture_GetData(ktxTexture);
+			ktx_size_t ktxTextureSize = ktxTexture_GetSize(ktxTexture);
+			// @todo: Use ktxTexture_GetVkFormat(ktxTexture)
+			format = VK_FORMAT_R8G8B8A8_UNORM;
+
+			// Get device properties for the requested texture format
+			VkFormatProperties formatProperties;
+			vkGetPhysicalDeviceFormatProperties(device->physicalDevice, format, &formatProperties);
+
+			VkCommandBuffer copyCmd = device->createCommandBuffer(VK_COMMAND_BUFFER_LEVEL_PRIMARY, true);
+			VkBuffer stagingBuffer;
+			vks::Allocation stagingMemory;
+
+			VkBufferCreateInfo bufferCreateInfo = vks::initializers::bufferCreateInfo();
+			bufferCreateInfo.size = ktxTextureSize;
+			// This buffer is used as a transfer source for the buffer copy
+			bufferCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+			bufferCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			VK_CHECK_RESULT(vkCreateBuffer(device->logicalDevice, &bufferCreateInfo, nullptr, &stagingBuffer));
+
+			VK_CHECK_RESULT(device->allocator.AllocateBuffer(stagingBuffer, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, stagingMemory));
+
+			uint8_t* data = static_cast<uint8_t*>(stagingMemory.mapped);
+			memcpy(data, ktxTextureData, ktxTextureSize);
+
+			std::vector<VkBufferImageCopy> bufferCopyRegions;
+			for (uint32_t i = 0; i < mipLevels; i++)
+			{
+				ktx_size_t offset;
+				KTX_error_code result = ktxTexture_GetImageOffset(ktxTexture, i, 0, 0, &offset);
+				assert(result == KTX_SUCCESS);
+				VkBufferImageCopy bufferCopyRegion = {};
+				bufferCopyRegion.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				bufferCopyRegion.imageSubresource.mipLevel = i;
+				bufferCopyRegion.imageSubresource.baseArrayLayer = 0;
+				bufferCopyRegion.imageSubresource.layerCount = 1;
+				bufferCopyRegion.imageExtent.width = std::max(1u, ktxTexture->baseWidth >> i);
+				bufferCopyRegion.imageExtent.height = std::max(1u, ktxTexture->baseHeight >> i);
+				bufferCopyRegion.imageExtent.depth = 1;
+				bufferCopyRegion.bufferOffset = offset;
+				bufferCopyRegions.push_back(bufferCopyRegion);
+			}
+
+			// Create optimal tiled target image
+			VkImageCreateInfo imageCreateInfo = vks::initializers::imageCreateInfo();
+			imageCreateInfo.imageType = VK_IMAGE_TYPE_2D;
+			imageCreateInfo.format = format;
+			imageCreateInfo.mipLevels = mipLevels;
+			imageCreateInfo.arrayLayers = 1;
+			imageCreateInfo.samples = VK_SAMPLE_COUNT_1_BIT;
+			imageCreateInfo.tiling = VK_IMAGE_TILING_OPTIMAL;
+			imageCreateInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+			imageCreateInfo.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			imageCreateInfo.extent = { width, height, 1 };
+			imageCreateInfo.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+			VK_CHECK_RESULT(vkCreateImage(device->logicalDevice, &imageCreateInfo, nullptr, &image));
+
+			VK_CHECK_RESULT(device->allocator.AllocateImage(image, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, deviceMemory));
+
+			VkImageSubresourceRange subresourceRange = {};
+			subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+			subresourceRange.baseMipLevel = 0;
+			subresourceRange.levelCount = mipLevels;
+			subresourceRange.layerCount = 1;
+
+			vks::tools::setImageLayout(copyCmd, image, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, subresourceRange);
+			vkCmdCopyBufferToImage(copyCmd, stagingBuffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<uint32_t>(bufferCopyRegions.size()), bufferCopyRegions.data());
+			vks::tools::setImageLayout(copyCmd, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, subresourceRange);
+			device->flushCommandBuffer(copyCmd, copyQueue);
+			this->imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+			device->allocator.Free(stagingMemory);
+			vkDestroyBuffer(device->logicalDevice, stagingBuffer, nullptr);
+
+			ktxTexture_Destroy(ktxTexture);
+		}
+		
+		VkSamplerCreateInfo samplerInfo{};
+		samplerInfo.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+		samplerInfo.magFilter = VK_FILTER_LINEAR;
+		samplerInfo.minFilter = VK_FILTER_LINEAR;
+		samplerInfo.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
+		samplerInfo.addressModeU = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		samplerInfo.addressModeV = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		samplerInfo.addressModeW = VK_SAMPLER_ADDRESS_MODE_MIRRORED_REPEAT;
+		samplerInfo.compareOp = VK_COMPARE_OP_NEVER;
+		samplerInfo.borderColor = VK_BORDER_COLOR_FLOAT_OPAQUE_WHITE;
+		samplerInfo.maxAnisotropy = 1.0;
+		samplerInfo.anisotropyEnable = VK_FALSE;
+		samplerInfo.maxLod = (float)mipLevels;
+		samplerInfo.maxAnisotropy = 8.0f;
+		samplerInfo.anisotropyEnable = VK_TRUE;
+		VK_CHECK_RESULT(vkCreateSampler(device->logicalDevice, &samplerInfo, nullptr, &sampler));
+
+		VkImageViewCreateInfo viewInfo{};
+		viewInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+		viewInfo.image = image;
+		viewInfo.viewType = VK_IMAGE_VIEW_TYPE_2D;
+		viewInfo.format = format;
+		viewInfo.components = { VK_COMPONENT_SWIZZLE_R, VK_COMPONENT_SWIZZLE_G, VK_COMPONENT_SWIZZLE_B, VK_COMPONENT_SWIZZLE_A };
+		viewInfo.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		viewInfo.subresourceRange.layerCount = 1;
+		viewInfo.subresourceRange.levelCount = mipLevels;
+		VK_CHECK_RESULT(vkCreateImageView(device->logicalDevice, &viewInfo, nullptr, &view));
+
+		descriptor.sampler = sampler;
+		descriptor.imageView = view;
+		descriptor.imageLayout = imageLayout;
+	}
+	/***********************************************
+	 *	функция:			Mesh()
+	 *	назначение:			создание грани (блок параметров
+	 *						размещается в Model::PrepareUniformRing())
+	 *	входящие значения:	device - устройство
+	 *						matrix - матрица узла
+	 *	выходящие значения:	нет
+	 **********************************************/
+	Mesh::Mesh(VulkanDevice* device, mat4 matrix)
+	{
+		this->device = device;
+		this->uniformBlock.matrix = matrix;
+	}
+
+	/***********************************************
+	 *	функция:			UpdateUniforms()
+	 *	назначение:			записать блок параметров в область
+	 *						текущего кадра кольцевого буфера
+	 *	входящие значения:	нет
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Mesh::UpdateUniforms()
+	{
+		if (uniformRing && uniformRing->buffer.mapped)
+			uniformRing->Write(uniformSlot, &uniformBlock, sizeof(uniformBlock));
+	}
+	
+	/*************************************************************************
+	 * функции Node структуры
+	 *
+	***********************************************************************/
+	mat4 Node::localMatrix()
+	{
+		return translate(mat4(1.0f), translation) * mat4(rotation) * glm::scale(mat4(1.0f), scale) * matrix;
+	}
+	
+	mat4 Node::getMatrix()
+	{
+		glm::mat4 m = localMatrix();
+		vkglTF::Node* p = parent;
+		while (p) {
+			m = p->localMatrix() * m;
+			p = p->parent;
+		}
+		return m;
+	}
+	void Node::Update()
+	{
+		if (mesh) {
+			glm::mat4 m = getMatrix();
+			if (skin) {
+				mesh->uniformBlock.matrix = m;
+				// Update join matrices
+				glm::mat4 inverseTransform = glm::inverse(m);
+				for (size_t i = 0; i < skin->joints.size(); i++) {
+					vkglTF::Node* jointNode = skin->joints[i];
+					glm::mat4 jointMat = jointNode->getMatrix() * skin->inverseBindMatrices[i];
+					jointMat = inverseTransform * jointMat;
+					skin->jointMatrices[i] = jointMat;
+				}
+				if (mesh->uniformRing)
+					mesh->uniformRing->WriteJoints(skin->jointOffset, skin->jointMatrices, skin->joints.size());
+				mesh->uniformBlock.jointOffset = skin->jointOffset;
+				mesh->uniformBlock.jointCount = skin->computeSkinned ? 0 : static_cast<uint32_t>(skin->joints.size());
+			}
+			else {
+				mesh->uniformBlock.matrix = m;
+			}
+			mesh->boundsDirty = true;
+			mesh->UpdateUniforms();
+		}
+
+		for (Node* child : children) {
+			child->Update();
+		}
+	}
+	
+	/*************************************************************************
+	 * функции AnimationSampler структуры
+	 *
+	***********************************************************************/
+	static const float SMALLEST_THREE_RANGE = 0.70710678f;
+
+	static uint16_t QuantizeUnit(float value)
+	{
+		return static_cast<uint16_t>(glm::clamp(value, 0.0f, 1.0f) * 65535.0f + 0.5f);
+	}
+
+	//кватернион в 48 бит: индекс наибольшей компоненты (2 бита) и три остальные по 15 бит
+	static void EncodeSmallestThree(vec4 q, uint16_t* out)
+	{
+		q = normalize(q);
+		const float values[4] = { q.x, q.y, q.z, q.w };
+		uint32_t largest = 0;
+		for (uint32_t k = 1; k < 4; k++)
+		{
+			if (fabsf(values[k]) > fabsf(values[largest]))
+				largest = k;
+		}
+		const float sign = values[largest] < 0.0f ? -1.0f : 1.0f;
+
+		uint16_t packed[3];
+		for (uint32_t k = 0, j = 0; k < 4; k++)
+		{
+			if (k == largest)
+				continue;
+			const float unit = values[k] * sign / SMALLEST_THREE_RANGE * 0.5f + 0.5f;
+			packed[j++] = static_cast<uint16_t>(glm::clamp(unit, 0.0f, 1.0f) * 32767.0f + 0.5f);
+		}
+		out[0] = static_cast<uint16_t>(((largest >> 1) << 15) | packed[0]);
+		out[1] = static_cast<uint16_t>(((largest & 1) << 15) | packed[1]);
+		out[2] = packed[2];
+	}
+
+	static vec4 DecodeSmallestThree(const uint16_t* in)
+	{
+		const uint32_t largest = ((in[0] >> 15) << 1) | (in[1] >> 15);
+		float values[4];
+		float sum = 0.0f;
+		for (uint32_t k = 0, j = 0; k < 4; k++)
+		{
+			if (k == largest)
+				continue;
+			const float unit = static_cast<float>(in[j++] & 0x7FFF) / 32767.0f;
+			values[k] = (unit * 2.0f - 1.0f) * SMALLEST_THREE_RANGE;
+			sum += values[k] * values[k];
+		}
+		values[largest] = sqrtf(std::max(0.0f, 1.0f - sum));
+		return vec4(values[0], values[1], values[2], values[3]);
+	}
+
+	static vec4 InterpolateKey(const vec4& v0, const vec4& v1, float u, bool rotation)
+	{
+		if (rotation)
+		{
+			quat q = normalize(slerp(quat(v0.w, v0.x, v0.y, v0.z), quat(v1.w, v1.x, v1.y, v1.z), u));
+			return vec4(q.x, q.y, q.z, q.w);
+		}
+		return mix(v0, v1, u);
+	}
+
+	static float KeyError(const vec4& a, const vec4& b, bool rotation)
+	{
+		if (rotation)
+		{
+			//угол между кватернионами
+			const float dot = std::min(1.0f, fabsf(a.x * b.x + a.y * b.y + a.z * b.z + a.w * b.w));
+			return 2.0f * acosf(dot);
+		}
+		return glm::length(vec3(a) - vec3(b));
+	}
+
+	bool AnimationSampler::IsValid() const
+	{
+		if (IsCompressed())
+			return true;
+
+		if (inputs.empty())
+			return false;
+
+		//для CUBICSPLINE на каждый ключ приходится тройка (in-tangent, value, out-tangent)
+		const size_t stride = interpolation == CUBICSPLINE ? 3 : 1;
+		return std::max(outputsVec4.size(), outputs.size()) >= inputs.size() * stride;
+	}
+
+	size_t AnimationSampler::KeyCount() const
+	{
+		return IsCompressed() ? compressed.keyCount : inputs.size();
+	}
+
+	float AnimationSampler::KeyTime(size_t index) const
+	{
+		if (!IsCompressed())
+			return inputs[index];
+		return compressed.timeStart + static_cast<float>(compressed.times[index]) * (compressed.timeRange / 65535.0f);
+	}
+
+	/***********************************************
+	 *	функция:			Output()
+	 *	назначение:			значение из массива выходов (для CUBICSPLINE
+	 *						индекс включает касательные)
+	 *	входящие значения:	index - индекс в массиве выходов
+	 *	выходящие значения:	значение (распакованное, если ключи сжаты)
+	 **********************************************/
+	vec4 AnimationSampler::Output(size_t index) const
+	{
+		if (!IsCompressed())
+			return outputsVec4[index];
+
+		const uint16_t* value = &compressed.values[index * compressed.components];
+		if (compressed.smallestThree)
+			return DecodeSmallestThree(value);
+
+		vec4 result(0.0f);
+		for (uint32_t k = 0; k < compressed.components; k++)
+			result[k] = compressed.rangeMin[k] + static_cast<float>(value[k]) / 65535.0f * compressed.rangeExtent[k];
+		return result;
+	}
+
+	/***********************************************
+	 *	функция:			Sample()
+	 *	назначение:			значение канала в момент времени
+	 *	входящие значения:	time - время анимации
+	 *						path - тип канала (для вращения
+	 *						результат нормализуется)
+	 *	выходящие значения:	значение ключа (кватернион как x, y, z, w)
+	 **********************************************/
+	vec4 AnimationSampler::Sample(float time, AnimationChannel::PathType path) const
+	{
+		const bool cubic = interpolation == CUBICSPLINE;
+		const size_t stride = cubic ? 3 : 1;
+		const size_t valueOffset = cubic ? 1 : 0;
+		const bool rotation = path == AnimationChannel::PathType::ROTATION;
+		const size_t keyCount = KeyCount();
+
+		if ((keyCount == 1) || (time <= KeyTime(0)))
+			return Output(valueOffset);
+
+		if (time >= KeyTime(keyCount - 1))
+			return Output((keyCount - 1) * stride + valueOffset);
+
+		// KeyTime(i) <= time < KeyTime(i + 1)
+		size_t i = 0;
+		size_t last = keyCount - 1;
+		while (last - i > 1)
+		{
+			const size_t middle = (i + last) / 2;
+			if (KeyTime(middle) <= time)
+				i = middle;
+			else
+				last = middle;
+		}
+
+		const vec4 v0 = Output(i * stride + valueOffset);
+		const vec4 v1 = Output((i + 1) * stride + valueOffset);
+
+		if (interpolation == STEP)
+			return v0;
+
+		const float t0 = KeyTime(i);
+		const float dt = KeyTime(i + 1) - t0;
+		//ключи с одинаковым временем: берется следующий
+		const float u = dt > 0.0f ? (time - t0) / dt : 1.0f;
+
+		if (cubic)
+		{
+			//кубический сплайн Эрмита, касательные масштабируются на длину интервала
+			const vec4 outTangent = Output(i * 3 + 2);
+			const vec4 inTangent = Output((i + 1) * 3);
+			const float u2 = u * u;
+			const float u3 = u2 * u;
+			vec4 result = (2.0f * u3 - 3.0f * u2 + 1.0f) * v0
+				+ (u3 - 2.0f * u2 + u) * dt * outTangent
+				+ (-2.0f * u3 + 3.0f * u2) * v1
+				+ (u3 - u2) * dt * inTangent;
+			return rotation ? normalize(result) : result;
+		}
+
+		return InterpolateKey(v0, v1, u, rotation);
+	}
+
+	/***********************************************
+	 *	функция:			SampleWeights()
+	 *	назначение:			веса целей морфинга в момент времени
+	 *	входящие значения:	time - время анимации
+	 *						weights - веса для записи
+	 *						weightCount - число весов (целей морфинга грани)
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationSampler::SampleWeights(float time, float* weights, size_t weightCount) const
+	{
+		const bool cubic = interpolation == CUBICSPLINE;
+		const size_t stride = cubic ? 3 : 1;
+		const size_t keyCount = inputs.size();
+		if (keyCount == 0)
+			return;
+
+		const size_t width = outputs.size() / (keyCount * stride);
+		const size_t count = std::min(width, weightCount);
+		//для CUBICSPLINE значения ключа лежат после входящих касательных
+		const size_t valueOffset = cubic ? width : 0;
+
+		size_t i = 0;
+		float u = 0.0f;
+		if (time >= inputs.back())
+			i = keyCount - 1;
+		else if (time > inputs.front())
+		{
+			i = static_cast<size_t>(upper_bound(inputs.begin(), inputs.end(), time) - inputs.begin()) - 1;
+			const float dt = inputs[i + 1] - inputs[i];
+			u = dt > 0.0f ? (time - inputs[i]) / dt : 0.0f;
+		}
+
+		const float* v0 = &outputs[i * stride * width + valueOffset];
+		if ((u == 0.0f) || (interpolation == STEP))
+		{
+			copy(v0, v0 + count, weights);
+			return;
+		}
+
+		const float* v1 = &outputs[(i + 1) * stride * width + valueOffset];
+		if (!cubic)
+		{
+			for (size_t k = 0; k < count; k++)
+				weights[k] = v0[k] + (v1[k] - v0[k]) * u;
+			return;
+		}
+
+		const float dt = inputs[i + 1] - inputs[i];
+		const float* outTangent = v0 + width;
+		const float* inTangent = &outputs[(i + 1) * 3 * width];
+		const float u2 = u * u;
+		const float u3 = u2 * u;
+		for (size_t k = 0; k < count; k++)
+		{
+			weights[k] = (2.0f * u3 - 3.0f * u2 + 1.0f) * v0[k]
+				+ (u3 - 2.0f * u2 + u) * dt * outTangent[k]
+				+ (-2.0f * u3 + 3.0f * u2) * v1[k]
+				+ (u3 - u2) * dt * inTangent[k];
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Compress()
+	 *	назначение:			удалить ключи, восстанавливаемые с ошибкой
+	 *						не больше tolerance, и квантовать оставшиеся:
+	 *						время и смещение/масштаб - 16 бит по диапазону,
+	 *						вращение - smallest-three (48 бит). Ошибка
+	 *						считается по квантованным временам, из ключей
+	 *						с одинаковым квантованным временем остается
+	 *						последний
+	 *	входящие значения:	path - тип канала
+	 *						tolerance - допустимая ошибка
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationSampler::Compress(AnimationChannel::PathType path, float tolerance)
+	{
+		if (IsCompressed() || !IsValid())
+			return;
+
+		const bool cubic = interpolation == CUBICSPLINE;
+		const bool rotation = path == AnimationChannel::PathType::ROTATION;
+		const size_t stride = cubic ? 3 : 1;
+		const size_t count = inputs.size();
+
+		//время квантуется по всему диапазону до отбора, чтобы ошибка считалась так, как ключи будут читаться
+		compressed.timeStart = inputs.front();
+		compressed.timeRange = inputs.back() - compressed.timeStart;
+		vector<uint16_t> quantizedTimes(count);
+		vector<float> times(count);
+		for (size_t k = 0; k < count; k++)
+		{
+			quantizedTimes[k] = compressed.timeRange > 0.0f ? QuantizeUnit((inputs[k] - compressed.timeStart) / compressed.timeRange) : 0;
+			times[k] = compressed.timeStart + static_cast<float>(quantizedTimes[k]) * (compressed.timeRange / 65535.0f);
+		}
+
+		//из ключей с одним квантованным временем остается последний, иначе интервал
+		//между ними нулевой; разрыв значения в этот момент теряется
+		vector<size_t> candidates;
+		for (size_t k = 0; k < count; k++)
+		{
+			if (!candidates.empty() && (quantizedTimes[candidates.back()] == quantizedTimes[k]))
+				candidates.back() = k;
+			else
+				candidates.push_back(k);
+		}
+
+		//отбор ключей (касательные CUBICSPLINE зависят от соседей, такие ключи не удаляются)
+		vector<size_t> keys{ candidates.front() };
+		if (cubic)
+		{
+			keys = candidates;
+		}
+		else if (candidates.size() > 1)
+		{
+			size_t anchor = candidates.front();
+			for (size_t c = 2; c < candidates.size(); c++)
+			{
+				//проверяются все исходные ключи интервала, в том числе слитые
+				const size_t next = candidates[c];
+				bool fits = true;
+				for (size_t k = anchor + 1; (k < next) && fits; k++)
+				{
+					vec4 approx = outputsVec4[anchor];
+					if (interpolation == LINEAR)
+					{
+						const float dt = times[next] - times[anchor];
+						approx = dt > 0.0f ? InterpolateKey(outputsVec4[anchor], outputsVec4[next], (times[k] - times[anchor]) / dt, rotation) : outputsVec4[next];
+					}
+					fits = KeyError(approx, outputsVec4[k], rotation) <= tolerance;
+				}
+				//слитые ключи между соседними кандидатами не восстановить, новый ключ не поможет
+				if (!fits && (candidates[c - 1] != anchor))
+				{
+					anchor = candidates[c - 1];
+					keys.push_back(anchor);
+				}
+			}
+			keys.push_back(candidates.back());
+		}
+
+		compressed.smallestThree = rotation && !cubic;
+		compressed.components = (rotation && cubic) ? 4 : 3;
+
+		vec4 minValue(FLT_MAX);
+		vec4 maxValue(-FLT_MAX);
+		for (size_t key : keys)
+		{
+			for (size_t j = 0; j < stride; j++)
+			{
+				minValue = glm::min(minValue, outputsVec4[key * stride + j]);
+				maxValue = glm::max(maxValue, outputsVec4[key * stride + j]);
+			}
+		}
+		compressed.rangeMin = minValue;
+		compressed.rangeExtent = maxValue - minValue;
+
+		compressed.times.reserve(keys.size());
+		compressed.values.reserve(keys.size() * stride * compressed.components);
+		for (size_t key : keys)
+		{
+			compressed.times.push_back(quantizedTimes[key]);
+
+			for (size_t j = 0; j < stride; j++)
+			{
+				const vec4& value = outputsVec4[key * stride + j];
+				if (compressed.smallestThree)
+				{
+					uint16_t packed[3];
+					EncodeSmallestThree(value, packed);
+					compressed.values.insert(compressed.values.end(), packed, packed + 3);
+					continue;
+				}
+				for (uint32_t k = 0; k < compressed.components; k++)
+				{
+					const float extent = compressed.rangeExtent[k];
+					compressed.values.push_back(extent > 0.0f ? QuantizeUnit((value[k] - compressed.rangeMin[k]) / extent) : 0);
+				}
+			}
+		}
+		compressed.keyCount = static_cast<uint32_t>(keys.size());
+
+		inputs.clear();
+		inputs.shrink_to_fit();
+		outputsVec4.clear();
+		outputsVec4.shrink_to_fit();
+	}
+
+	/*************************************************************************
+	 * функции AnimationPose структуры
+	 *
+	***********************************************************************/
+	void AnimationPose::Resize(size_t count)
+	{
+		for (uint32_t c = 0; c < 3; c++)
+		{
+			translation[c].resize(count);
+			scale[c].resize(count);
+		}
+		for (uint32_t c = 0; c < 4; c++)
+			rotation[c].resize(count);
+	}
+
+	void AnimationPose::Set(size_t slot, const vec3& t, const quat& r, const vec3& s)
+	{
+		translation[0][slot] = t.x;
+		translation[1][slot] = t.y;
+		translation[2][slot] = t.z;
+		rotation[0][slot] = r.x;
+		rotation[1][slot] = r.y;
+		rotation[2][slot] = r.z;
+		rotation[3][slot] = r.w;
+		scale[0][slot] = s.x;
+		scale[1][slot] = s.y;
+		scale[2][slot] = s.z;
+	}
+
+	/*************************************************************************
+	 * функции AnimationClip структуры
+	 *
+	***********************************************************************/
+	static void LerpTrack(const float* a, const float* b, float* out, size_t count, float u)
+	{
+		for (size_t i = 0; i < count; i++)
+			out[i] = a[i] + (b[i] - a[i]) * u;
+	}
+
+	/***********************************************
+	 *	функция:			Compile()
+	 *	назначение:			пересэмплировать анимацию с постоянным шагом
+	 *	входящие значения:	animation - исходная анимация glTF
+	 *						sampleRate - число кадров в секунду
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationClip::Compile(const Animation& animation, float sampleRate)
+	{
+		name = animation.name;
+		start = animation.start;
+		end = std::max(animation.end, animation.start);
+		this->sampleRate = sampleRate;
+		frameCount = static_cast<uint32_t>(ceil((end - start) * sampleRate)) + 1;
+
+		nodes.clear();
+		paths.clear();
+		vector<size_t> channelSlots;
+		for (auto& channel : animation.channels)
+		{
+			//веса морфинга остаются в исходных каналах
+			if (channel.path == AnimationChannel::PathType::WEIGHTS)
+			{
+				channelSlots.push_back(0);
+				continue;
+			}
+
+			size_t slot = static_cast<size_t>(find(nodes.begin(), nodes.end(), channel.node) - nodes.begin());
+			if (slot == nodes.size())
+			{
+				nodes.push_back(channel.node);
+				paths.push_back(0);
+			}
+			paths[slot] |= static_cast<uint8_t>(1 << channel.path);
+			channelSlots.push_back(slot);
+		}
+
+		const size_t count = nodes.size();
+		frames.Resize(frameCount * count);
+
+		//неанимированные компоненты берутся из исходной позы узла
+		for (uint32_t f = 0; f < frameCount; f++)
+			for (size_t slot = 0; slot < count; slot++)
+				frames.Set(f * count + slot, nodes[slot]->translation, nodes[slot]->rotation, nodes[slot]->scale);
+
+		for (size_t c = 0; c < animation.channels.size(); c++)
+		{
+			const AnimationChannel& channel = animation.channels[c];
+			const AnimationSampler& sampler = animation.samplers[channel.samplerIndex];
+			if ((channel.path == AnimationChannel::PathType::WEIGHTS) || !sampler.IsValid())
+				continue;
+
+			for (uint32_t f = 0; f < frameCount; f++)
+			{
+				const float time = std::min(start + static_cast<float>(f) / sampleRate, end);
+				const vec4 value = sampler.Sample(time, channel.path);
+				const size_t i = f * count + channelSlots[c];
+				switch (channel.path)
+				{
+				case AnimationChannel::PathType::TRANSLATION:
+					for (uint32_t k = 0; k < 3; k++)
+						frames.translation[k][i] = value[k];
+					break;
+				case AnimationChannel::PathType::ROTATION:
+					for (uint32_t k = 0; k < 4; k++)
+						frames.rotation[k][i] = value[k];
+					break;
+				case AnimationChannel::PathType::SCALE:
+					for (uint32_t k = 0; k < 3; k++)
+						frames.scale[k][i] = value[k];
+					break;
+				}
+			}
+		}
+
+		//соседние кадры приводятся к одной полусфере, тогда nlerp не требует проверки знака
+		for (uint32_t f = 1; f < frameCount; f++)
+		{
+			for (size_t slot = 0; slot < count; slot++)
+			{
+				const size_t prev = (f - 1) * count + slot;
+				const size_t cur = f * count + slot;
+				float dot = 0.0f;
+				for (uint32_t k = 0; k < 4; k++)
+					dot += frames.rotation[k][prev] * frames.rotation[k][cur];
+				if (dot < 0.0f)
+				{
+					for (uint32_t k = 0; k < 4; k++)
+						frames.rotation[k][cur] = -frames.rotation[k][cur];
+				}
+			}
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Sample()
+	 *	назначение:			получить позу клипа в момент времени
+	 *	входящие значения:	time - время анимации
+	 *						pose - поза для записи результата
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationClip::Sample(float time, AnimationPose& pose) const
+	{
+		const size_t count = nodes.size();
+		pose.Resize(count);
+		if ((count == 0) || (frameCount == 0))
+			return;
+
+		const float frame = glm::clamp((time - start) * sampleRate, 0.0f, static_cast<float>(frameCount - 1));
+		const uint32_t f0 = static_cast<uint32_t>(frame);
+		const uint32_t f1 = std::min(f0 + 1, frameCount - 1);
+		const float u = frame - static_cast<float>(f0);
+		const size_t a = f0 * count;
+		const size_t b = f1 * count;
+
+		for (uint32_t k = 0; k < 3; k++)
+		{
+			LerpTrack(&frames.translation[k][a], &frames.translation[k][b], pose.translation[k].data(), count, u);
+			LerpTrack(&frames.scale[k][a], &frames.scale[k][b], pose.scale[k].data(), count, u);
+		}
+		for (uint32_t k = 0; k < 4; k++)
+			LerpTrack(&frames.rotation[k][a], &frames.rotation[k][b], pose.rotation[k].data(), count, u);
+
+		// nlerp: нормализация интерполированных кватернионов
+		float* x = pose.rotation[0].data();
+		float* y = pose.rotation[1].data();
+		float* z = pose.rotation[2].data();
+		float* w = pose.rotation[3].data();
+		for (size_t i = 0; i < count; i++)
+		{
+			const float length = sqrtf(x[i] * x[i] + y[i] * y[i] + z[i] * z[i] + w[i] * w[i]);
+			const float invLength = length > 0.0f ? 1.0f / length : 0.0f;
+			x[i] *= invLength;
+			y[i] *= invLength;
+			z[i] *= invLength;
+			w[i] *= invLength;
+		}
+	}
+
+	/***********************************************
+	 *	функция:			Apply()
+	 *	назначение:			записать позу в анимированные узлы
+	 *	входящие значения:	pose - поза, полученная из Sample()
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void AnimationClip::Apply(const AnimationPose& pose) const
+	{
+		for (size_t slot = 0; slot < nodes.size(); slot++)
+		{
+			Node* node = nodes[slot];
+			if (paths[slot] & TRANSLATION_BIT)
+				node->translation = vec3(pose.translation[0][slot], pose.translation[1][slot], pose.translation[2][slot]);
+			if (paths[slot] & ROTATION_BIT)
+				node->rotation = quat(pose.rotation[3][slot], pose.rotation[0][slot], pose.rotation[1][slot], pose.rotation[2][slot]);
+			if (paths[slot] & SCALE_BIT)
+				node->scale = vec3(pose.scale[0][slot], pose.scale[1][slot], pose.scale[2][slot]);
+		}
+	}
+
+	/*************************************************************************
+	 * функции Vertex структуры
+	 *
+	***********************************************************************/
+	VkVertexInputBindingDescription Vertex::vertexInputBindingDescription;
+	std::vector<VkVertexInputAttributeDescription> Vertex::vertexInputAttributeDescriptions;
+	VkPipelineVertexInputStateCreateInfo Vertex::pipelineVertexInputStateCreateInfo;
+	
+	/***********************************************
+	 *	функция:			InputBindingDescription()
+	 *	назначение:			Загрузка шейдеров из файла
+	 *	входящие значения:	fileName - имя файла
+	 *						device - устройство вулкан
+	 *	выходящие значения:	нет
+	 **********************************************/
+	VkVertexInputBindingDescription Vertex::InputBindingDescription(uint32_t binding)
+	{
+		return VkVertexInputBindingDescription({ binding, sizeof(Vertex), VK_VERTEX_INPUT_RATE_VERTEX });
+	}
+	
+	/***********************************************
+	 *	функция:			InputAttributeDescription()
+	 *	назначение:			Загрузка шейдеров из файла
+	 *	входящие значения:	fileName - имя файла
+	 *						device - устройство вулкан
+	 *	выходящие значения:	нет
+	 **********************************************/
+	VkVertexInputAttributeDescription Vertex::InputAttributeDescription(uint32_t binding, uint32_t location, VertexComponent component)
+	{
+		switch (component) {
+		case VertexComponent::Position:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, pos) });
+		case VertexComponent::Normal:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32_SFLOAT, offsetof(Vertex, normal) });
+		case VertexComponent::UV:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32_SFLOAT, offsetof(Vertex, uv) });
+		case VertexComponent::Color:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, color) });
+		case VertexComponent::Tangent:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, tangent) });
+		case VertexComponent::Joint0:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, joint0) });
+		case VertexComponent::Weight0:
+			return VkVertexInputAttributeDescription({ location, binding, VK_FORMAT_R32G32B32A32_SFLOAT, offsetof(Vertex, weight0) });
+		default:
+			return VkVertexInputAttributeDescription({});
+		}
+	}
+	
+	/***********************************************
+	 *	функция:			InputAttributeDescriptions()
+	 *	назначение:			Загрузка шейдеров из файла
+	 *	входящие значения:	fileName - имя файла
+	 *						device - устройство вулкан
+	 *	выходящие значения:	нет
+	 **********************************************/
+	vector<VkVertexInputAttributeDescription> Vertex::InputAttributeDescriptions(uint32_t binding, const vector<VertexComponent> components)
+	{
+		std::vector<VkVertexInputAttributeDescription> result;
+		uint32_t location = 0;
+		for (VertexComponent component : components) {
+			result.push_back(Vertex::InputAttributeDescription(binding, location, component));
+			location++;
+		}
+		return result;
+	}
+	
+	/***********************************************
+	 *	функция:			GetPipelineVertexInputState()
+	 *	назначение:			Загрузка шейдеров из файла
+	 *	входящие значения:	fileName - имя файла
+	 *						device - устройство вулкан
+	 *	выходящие значения:	нет
+	 **********************************************/
+	VkPipelineVertexInputStateCreateInfo* Vertex::GetPipelineVertexInputState(const vector<VertexComponent> components)
+	{
+		vertexInputBindingDescription = InputBindingDescription(0);
+		vertexInputAttributeDescriptions = InputAttributeDescriptions(0, components);
+		pipelineVertexInputStateCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+		pipelineVertexInputStateCreateInfo.vertexBindingDescriptionCount = 1;
+		pipelineVertexInputStateCreateInfo.pVertexBindingDescriptions = &Vertex::vertexInputBindingDescription;
+		pipelineVertexInputStateCreateInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(vertexInputAttributeDescriptions.size());
+		pipelineVertexInputStateCreateInfo.pVertexAttributeDescriptions = vertexInputAttributeDescriptions.data();
+		return &pipelineVertexInputStateCreateInfo;
+	}
+
+	/***********************************************
+	 *	функция:			CreateDescriptorSet()
+	 *	назначение:			Загрузка шейдеров из файла
+	 *	входящие значения:	fileName - имя файла
+	 *						device - устройство вулкан
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Material::CreateDescriptorSet(VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout)
+	{
+		VkDescriptorSetAllocateInfo descriptorSetAllocInfo{};
+		descriptorSetAllocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		descriptorSetAllocInfo.descriptorPool = descriptorPool;
+		descriptorSetAllocInfo.pSetLayouts = &descriptorSetLayout;
+		descriptorSetAllocInfo.descriptorSetCount = 1;
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(device->logicalDevice, &descriptorSetAllocInfo, &descriptorSet));
+
+		std::vector<VkDescriptorImageInfo> imageDescriptors = {
+			baseColorTexture->descriptor,
+		};
+
+		VkWriteDescriptorSet writeDescriptorSet{};
+		writeDescriptorSet.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+		writeDescriptorSet.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+		writeDescriptorSet.descriptorCount = 1;
+		writeDescriptorSet.dstSet = descriptorSet;
+		writeDescriptorSet.dstBinding = 0;
+		writeDescriptorSet.pImageInfo = &baseColorTexture->descriptor;
+		vkUpdateDescriptorSets(device->logicalDevice, 1, &writeDescriptorSet, 0, nullptr);
+	}
+	
+	/***********************************************
+	 *	функция:			SetDimensions()
+	 *	назначение:			Загрузка шейдеров из файла
+	 *	входящие значения:	fileName - имя файла
+	 *						device - устройство вулкан
+	 *	выходящие значения:	нет
+	 **********************************************/
+	void Primitive::SetDimensions(vec3 min, vec3 max)
+	{
+		dimensions.min = min;
+		dimensions.max = max;
+		dimensions.size = max - min;
+		dimensions.center = (min + max) / 2.0f;
+		dimensions.radius = glm::distance(min, max) / 2.0f;
+	}
+}
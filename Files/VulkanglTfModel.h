@@ -1,300 +1,667 @@
-#pragma once
-
-#include "vulkan/vulkan.h"
-#include "VulkanDevice.h"
-
-#include <ktx.h>
-#include <ktxvulkan.h>
-
-#include "glm/glm.hpp"
-#include "glm/gtc/type_ptr.hpp"
-#include "glm/gtc/matrix_transform.hpp"
-#include "tiny_gltf.h"
-
-using namespace vks;
-using namespace std;
-using namespace glm;
-
-namespace vkglTF
-{
-	extern VkDescriptorSetLayout descriptorSetLayoutImage;
-	extern VkDescriptorSetLayout descriptorSetLayoutUbo;
-	extern VkMemoryPropertyFlags memoryPropertyFlags;
-
-	struct Node;
-
-	/*************************************************************************
-	 *    glTF 
-	 *
-	***********************************************************************/
-
-	struct Texture
-	{
-		VulkanDevice* device;
-		VkImage image;
-		VkImageLayout imageLayout;
-		VkDeviceMemory deviceMemory;
-		VkImageView view;
-		uint32_t width, height;
-		uint32_t mipLevels;
-		uint32_t layerCount;
-		VkDescriptorImageInfo descriptor;
-		VkSampler sampler;
-		void UpdateDescriptor();
-		void Destroy();
-		void FromglTfImage(tinygltf::Image& gltfimage, string path, VulkanDevice* device, VkQueue copyQueue);
-	};
-	
-	/*************************************************************************
-	 *   glTF 
-	 *
-	***********************************************************************/
-	struct Material
-	{
-		VulkanDevice* device;
-		enum AlphaMode {ALPHAMODE_OPAQUE, ALPHAMODE_MASK, ALPHAMODE_BLEND };
-		AlphaMode alphaMode = ALPHAMODE_OPAQUE;
-		float alphaCutoff = 1.0f;
-		float metallicFactor = 1.0f;
-		float roughnessFactor = 1.0f;
-		vec4 baseColorFactor = vec4(1.0f);
-		Texture* baseColorTexture = nullptr;
-		Texture* metallicRoughnessTexture = nullptr;
-		Texture* normalTexture = nullptr;
-		Texture* occlusionTexture = nullptr;
-		Texture* emissiveTexture = nullptr;
-
-		Texture* specularGlossinessTexture;
-		Texture* diffuseTexture;
-
-		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
-		Material(vks::VulkanDevice* device) :device(device) {};
-		void CreateDescriptorSet(VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout);
-	};
-	
-	/*************************************************************************
-	 * glTF 
-	 *
-	***********************************************************************/
-	struct Primitive
-	{
-		uint32_t firstIndex;
-		uint32_t indexCount;
-		uint32_t firstVertex;
-		uint32_t vertexCount;
-		Material& material;
-
-		struct Dimensions
-		{
-			vec3 min = vec3(FLT_MAX);
-			vec3 max = vec3(-FLT_MAX);
-			vec3 size;
-			vec3 center;
-			float radius;
-		}dimensions;
-
-		void SetDimensions(vec3 min, vec3 max);
-		Primitive(uint32_t firstIndex, uint32_t indexCount, Material material) :firstIndex(firstIndex), indexCount(indexCount), material(material) {};
-	};
-	
-	/*************************************************************************
-	 * glTF 
-	 *
-	***********************************************************************/
-	struct Mesh
-	{
-		VulkanDevice* device;
-		vector<Primitive*>primitives;
-		string name;
-
-		struct UniformBuffer
-		{
-			VkBuffer buffer;
-			VkDeviceMemory memory;
-			VkDescriptorBufferInfo descriptor;
-			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
-			void* mapped;
-		}uniformBuffer;
-
-		struct UniformBlock
-		{
-			mat4 matrix;
-			mat4 jointMatrix[64];
-			float jointcount{ 0 };
-		}uniformBlock;
-
-		
-		Mesh(VulkanDevice* device, mat4 mtrix);
-		~Mesh();
-	};
-
-	/*************************************************************************
-	 * glTF 
-	 *
-	***********************************************************************/
-	struct Skin
-	{
-		string name;
-		Node* skeletonRoot = nullptr;
-		vector<mat4>inverseBindMatrices;
-		vector<Node*>joints;
-	};
-
-	/*************************************************************************
-	 * glTF 
-	 *
-	***********************************************************************/
-	struct Node
-	{
-		Node* parent;
-		uint32_t index;
-		vector<Node*>children;
-		mat4 matrix;
-		string name;
-		Mesh* mesh;
-		Skin* skin;
-		int32_t skinIndex = -1;
-		vec3 translation{};
-		vec3 scale{ 1.0f };
-		quat rotation{};
-		mat4 localMatrix();
-		mat4 getMatrix();
-		void Update();
-		~Node();
-	};
-	
-	/*************************************************************************
-	 *   glTF 
-	 *
-	***********************************************************************/
-	struct AnimationChannel
-	{
-		enum PathType{TRANSLATION, ROTATION, SCALE };
-		PathType path;
-		Node* node;
-		uint32_t samplerIndex;
-	};
-	
-	/*************************************************************************
-	 *   glTF 
-	 *
-	***********************************************************************/
-	struct AnimationSampler
-	{
-		enum InterpolationType {LINEAR, STEP, CUBICSPLINE };
-		InterpolationType interpolation;
-		vector<float>inputs;
-		vector<vec4>outputsVec4;
-	};
-	
-	/*************************************************************************
-	 *   glTF 
-	 *
-	***********************************************************************/
-	struct Animation
-	{
-		string name;
-		vector<AnimationChannel>channels;
-		vector<AnimationSampler>samplers;
-		float start = numeric_limits<float>::max();
-		float end = numeric_limits<float>::min();
-	};
-	
-	/*************************************************************************
-	 *  glTF 
-	 *
-	***********************************************************************/
-	enum class VertexComponent{Position, Normal, UV, Color, Tangent, Joint0, Weight0};
-
-	struct Vertex
-	{
-		vec3 pos;
-		vec3 normal;
-		vec2 uv;
-		vec4 color;
-		vec4 joint0;
-		vec4 weight0;
-		vec4 tangent;
-		static VkVertexInputBindingDescription vertexInputBindingDescription;
-		static vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions;
-		static VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo;
-
-		static VkVertexInputBindingDescription InputBindingDescription(uint32_t binding);
-		static VkVertexInputAttributeDescription InputAttributeDescription(uint32_t binding, uint32_t location, VertexComponent component);
-		static vector<VkVertexInputAttributeDescription> InputAttributeDescriptions(uint32_t binding, const vector<VertexComponent> components);
-		static VkPipelineVertexInputStateCreateInfo* GetPipelineVertexInputState(const vector<VertexComponent> components);
-	};
-
-	enum FileLoadingFlags { None = 0x0, PreTransformVertices = 0x1, PreMultiplyVertexColors = 0x2, FlipY = 0x4, DontLoadImages = 0x8 };
-	
-	enum RenderFlag { BindImages = 0x1 };
-	
-	/*************************************************************************
-	 *      glTF 
-	 *
-	***********************************************************************/
-	class Model
-	{
-		Texture* GetTexture(uint32_t index);
-
-	public:
-		VulkanDevice* device;
-		VkDescriptorPool descriptorPool;
-		
-		struct Vertices
-		{
-			int count;
-			VkBuffer buffer;
-			VkDeviceMemory memory;
-		}vertices;
-
-		struct Indices
-		{
-			int count;
-			VkBuffer buffer;
-			VkDeviceMemory memory;
-		}indices;
-
-		vector<Node*> nodes;
-		vector<Node*> linearNodes;
-
-		vector<Skin*>skins;
-
-		vector<Texture>textures;
-		vector<Material>materials;
-		vector<Animation>animations;
-
-		struct Dimensions
-		{
-			vec3 min = vec3(FLT_MAX);
-			vec3 max = vec3(FLT_MIN);
-			vec3 size;
-			vec3 center;
-			float radius;
-		}dimensions;
-
-		bool metallicRoughnessWorkflow = true;
-		bool buffersBound = false;
-		string path;
-		
-		Model();
-		~Model();
-
-		void LoadNode(Node* parent, const tinygltf::Node& node, uint32_t nodeIndex, const tinygltf::Model& model, vector<uint32_t>
-		              & indexBuffer, vector<Vertex>& vertexBuffer, float globalScale);
-		void LoadSkins(tinygltf::Model& gltfModel);
-		void loadImage(tinygltf::Model& gltfModel, VulkanDevice* device, VkQueue transferQueue);
-		void LoadMaterials(tinygltf::Model& gltfModel);
-		void LoadAnimations(tinygltf::Model& gltfModel);
-		void LoadFromFile(string filename, VulkanDevice* device, VkQueue transferQueue, uint32_t fileLoadingFlags = FileLoadingFlags::None, float scale = 1.0f);
-		void BindBuffers(VkCommandBuffer commandBuffer);
-		static void DrawNode(Node* node, VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1);
-		void draw(VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1);
-		void GetNodeDimensions(Node* node, vec3& min, vec3& max);
-		void GetSceneDimensions();
-		void UpdateAnimation(uint32_t index, float time);
-		static Node* FindNode(Node* parent, uint32_t index);
-		Node* nodeFromIndex(uint32_t index);
-		void prepareNodeDescriptor(Node* node, VkDescriptorSetLayout descriptorSetlayout);
-	};
-}
+#pragma once
+
+#include "vulkan/vulkan.h"
+#include "VulkanDevice.h"
+#include "VulkanBuffer.h"
+#include "Frustum.h"
+#include "OcclusionBuffer.h"
+#include "CommandRecorder.h"
+
+#include <ktx.h>
+#include <ktxvulkan.h>
+
+#include <cassert>
+#include <memory>
+#include <new>
+
+#include "glm/glm.hpp"
+#include "glm/gtc/type_ptr.hpp"
+#include "glm/gtc/matrix_transform.hpp"
+#include "tiny_gltf.h"
+
+using namespace vks;
+using namespace std;
+using namespace glm;
+
+namespace vkglTF
+{
+	extern VkDescriptorSetLayout descriptorSetLayoutImage;
+	extern VkDescriptorSetLayout descriptorSetLayoutUbo;
+	extern VkDescriptorSetLayout descriptorSetLayoutIndirect;
+	extern VkDescriptorSetLayout descriptorSetLayoutBindless;
+	//размер массива изображений descriptorSetLayoutBindless (MAX_BINDLESS_TEXTURES в пределах устройства)
+	extern uint32_t bindlessTextureCapacity;
+	extern VkMemoryPropertyFlags memoryPropertyFlags;
+
+	struct Node;
+
+	/*************************************************************************
+	 * пул объектов модели: один непрерывный блок памяти на все объекты
+	 * типа, емкость задается до загрузки, объекты не перемещаются
+	 *
+	***********************************************************************/
+	template<typename T>
+	class Pool
+	{
+	public:
+		Pool() = default;
+		Pool(const Pool&) = delete;
+		Pool& operator=(const Pool&) = delete;
+		~Pool() { Clear(); }
+
+		void Reserve(size_t capacity)
+		{
+			Clear();
+			data = allocator.allocate(capacity);
+			this->capacity = capacity;
+		}
+
+		template<typename... Args>
+		T* Create(Args&&... args)
+		{
+			assert(count < capacity);
+			return new (&data[count++]) T(std::forward<Args>(args)...);
+		}
+
+		//count подряд идущих объектов, созданных по умолчанию
+		T* CreateRange(size_t rangeCount)
+		{
+			T* first = data + count;
+			for (size_t i = 0; i < rangeCount; i++)
+				Create();
+			return first;
+		}
+
+		size_t Size() const { return count; }
+		T* begin() { return data; }
+		T* end() { return data + count; }
+
+		void Clear()
+		{
+			for (size_t i = 0; i < count; i++)
+				data[i].~T();
+			if (data)
+				allocator.deallocate(data, capacity);
+			data = nullptr;
+			count = capacity = 0;
+		}
+
+	private:
+		std::allocator<T> allocator;
+		T* data = nullptr;
+		size_t count = 0;
+		size_t capacity = 0;
+	};
+
+	/*************************************************************************
+	 * класс для загрузки glTF текстуры
+	 *
+	***********************************************************************/
+
+	struct Texture
+	{
+		VulkanDevice* device;
+		VkImage image;
+		VkImageLayout imageLayout;
+		vks::Allocation deviceMemory;
+		VkImageView view;
+		uint32_t width, height;
+		uint32_t mipLevels;
+		uint32_t layerCount;
+		VkDescriptorImageInfo descriptor;
+		VkSampler sampler;
+		void UpdateDescriptor();
+		void Destroy();
+		void FromglTfImage(tinygltf::Image& gltfimage, string path, VulkanDevice* device, VkQueue copyQueue);
+	};
+	
+	/*************************************************************************
+	 * класс материала glTF текстуры
+	 *
+	***********************************************************************/
+	struct Material
+	{
+		VulkanDevice* device;
+		enum AlphaMode {ALPHAMODE_OPAQUE, ALPHAMODE_MASK, ALPHAMODE_BLEND };
+		AlphaMode alphaMode = ALPHAMODE_OPAQUE;
+		float alphaCutoff = 1.0f;
+		float metallicFactor = 1.0f;
+		float roughnessFactor = 1.0f;
+		vec4 baseColorFactor = vec4(1.0f);
+		Texture* baseColorTexture = nullptr;
+		Texture* metallicRoughnessTexture = nullptr;
+		Texture* normalTexture = nullptr;
+		Texture* occlusionTexture = nullptr;
+		Texture* emissiveTexture = nullptr;
+
+		Texture* specularGlossinessTexture = nullptr;
+		Texture* diffuseTexture = nullptr;
+
+		//номер в Model::materials и в буфере материалов
+		uint32_t index = 0;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		Material(vks::VulkanDevice* device) :device(device) {};
+		void CreateDescriptorSet(VkDescriptorPool descriptorPool, VkDescriptorSetLayout descriptorSetLayout);
+	};
+	
+	/*************************************************************************
+	 * glTF примитив
+	 *
+	***********************************************************************/
+	struct Primitive
+	{
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+		//индекс границ в Model::worldBounds
+		uint32_t cullIndex = 0;
+		Material& material;
+
+		struct Dimensions
+		{
+			vec3 min = vec3(FLT_MAX);
+			vec3 max = vec3(-FLT_MAX);
+			vec3 size;
+			vec3 center;
+			float radius;
+		}dimensions;
+
+		void SetDimensions(vec3 min, vec3 max);
+		Primitive(uint32_t firstIndex, uint32_t indexCount, Material& material) :firstIndex(firstIndex), indexCount(indexCount), material(material) {};
+	};
+	
+	/*************************************************************************
+	 * цель морфинга glTF: смещения хранятся только для изменяемых вершин,
+	 * vertices - номера строк в Mesh::morphVertices
+	 *
+	***********************************************************************/
+	struct MorphTarget
+	{
+		vector<uint32_t> vertices;
+		vector<vec3> positions;
+		vector<vec3> normals;
+	};
+
+	/*************************************************************************
+	 * кольцевой буфер параметров граней: постоянно отображенный буфер
+	 * с отдельной областью на каждый кадр в полете, блок грани читается
+	 * по динамическому смещению frame * frameSize + slot * stride.
+	 * Матрицы суставов (Model::jointBuffer) устроены так же: область
+	 * кадра выбирается вторым динамическим смещением frame * jointFrameSize
+	 *
+	***********************************************************************/
+	struct NodeUniformRing
+	{
+		Buffer buffer;
+		VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+		VkDeviceSize stride = 0;
+		VkDeviceSize frameSize = 0;
+		uint32_t frameCount = 1;
+		uint32_t frame = 0;
+
+		Buffer* jointBuffer = nullptr;
+		VkDeviceSize jointFrameSize = 0;
+
+		uint32_t Offset(uint32_t slot) const { return static_cast<uint32_t>(frame * frameSize + slot * stride); }
+		uint32_t JointOffset() const { return static_cast<uint32_t>(frame * jointFrameSize); }
+		void Write(uint32_t slot, const void* data, size_t size) { memcpy(static_cast<uint8_t*>(buffer.mapped) + Offset(slot), data, size); }
+		void WriteJoints(uint32_t first, const mat4* matrices, size_t count)
+		{
+			if (jointBuffer && jointBuffer->mapped)
+				memcpy(static_cast<uint8_t*>(jointBuffer->mapped) + JointOffset() + first * sizeof(mat4), matrices, count * sizeof(mat4));
+		}
+	};
+
+	/*************************************************************************
+	 * glTF грани
+	 *
+	***********************************************************************/
+	struct Mesh
+	{
+		VulkanDevice* device;
+		vector<Primitive*>primitives;
+		string name;
+
+		//морфинг: индексы изменяемых вершин в буфере вершин модели и их исходные значения
+		vector<MorphTarget> morphTargets;
+		vector<float> weights;
+		//начало весов грани в ModelPose::morphWeights
+		uint32_t weightOffset = 0;
+		vector<uint32_t> morphVertices;
+		vector<vec3> morphBasePositions;
+		vector<vec3> morphBaseNormals;
+
+		//место блока грани в кольцевом буфере модели (Model::uniformRing)
+		NodeUniformRing* uniformRing = nullptr;
+		uint32_t uniformSlot = 0;
+		//матрица изменилась, мировые границы примитивов нужно пересчитать
+		bool boundsDirty = true;
+
+		//матрицы суставов лежат в общем буфере модели (Model::jointBuffer)
+		struct UniformBlock
+		{
+			mat4 matrix;
+			uint32_t jointOffset{ 0 };
+			uint32_t jointCount{ 0 };
+		}uniformBlock;
+
+		
+		Mesh(VulkanDevice* device, mat4 mtrix);
+		void UpdateUniforms();
+	};
+
+	/*************************************************************************
+	 * glTF скины
+	 *
+	***********************************************************************/
+	struct Skin
+	{
+		string name;
+		Node* skeletonRoot = nullptr;
+		vector<mat4>inverseBindMatrices;
+		vector<Node*>joints;
+		//место скина в общем буфере матриц суставов, jointMatrices -
+		//копия на процессоре (Model::jointPalette), в буфер ее пишет Node::Update()
+		uint32_t jointOffset = 0;
+		mat4* jointMatrices = nullptr;
+		//вершины скина считаются вычислительным шейдером (SkinningPass)
+		bool computeSkinned = false;
+	};
+
+	/*************************************************************************
+	 * дочерние узлы: непрерывный диапазон в пуле узлов модели
+	 *
+	***********************************************************************/
+	struct NodeRange
+	{
+		struct Iterator
+		{
+			Node* node;
+			Node* operator*() const { return node; }
+			Iterator& operator++();
+			bool operator!=(const Iterator& other) const { return node != other.node; }
+		};
+
+		Node* first = nullptr;
+		uint32_t count = 0;
+
+		Iterator begin() const { return { first }; }
+		Iterator end() const;
+		size_t size() const { return count; }
+		bool empty() const { return count == 0; }
+		Node* operator[](size_t i) const;
+	};
+
+	/*************************************************************************
+	 * glTF узлы
+	 *
+	***********************************************************************/
+	struct Node
+	{
+		Node* parent;
+		uint32_t index;
+		NodeRange children;
+		mat4 matrix;
+		string name;
+		Mesh* mesh;
+		Skin* skin;
+		int32_t skinIndex = -1;
+		vec3 translation{};
+		vec3 scale{ 1.0f };
+		quat rotation{};
+		mat4 localMatrix();
+		mat4 getMatrix();
+		void Update();
+	};
+
+	inline NodeRange::Iterator& NodeRange::Iterator::operator++() { ++node; return *this; }
+	inline NodeRange::Iterator NodeRange::end() const { return { first + count }; }
+	inline Node* NodeRange::operator[](size_t i) const { return first + i; }
+	
+	/*************************************************************************
+	 * канал анимации glTF 
+	 *
+	***********************************************************************/
+	struct AnimationChannel
+	{
+		enum PathType{TRANSLATION, ROTATION, SCALE, WEIGHTS };
+		PathType path;
+		Node* node;
+		uint32_t samplerIndex;
+	};
+	
+	/*************************************************************************
+	 * образцы анимации glTF 
+	 *
+	***********************************************************************/
+	struct AnimationSampler
+	{
+		enum InterpolationType {LINEAR, STEP, CUBICSPLINE };
+		InterpolationType interpolation;
+		vector<float>inputs;
+		vector<vec4>outputsVec4;
+		//скалярные выходы (веса морфинга), на ключ приходится число целей морфинга значений
+		vector<float>outputs;
+
+		//сжатое представление: после Compress() inputs и outputsVec4 освобождаются
+		struct Compressed
+		{
+			uint32_t keyCount = 0;
+			//слов uint16_t на одно значение: 3 (smallest-three или xyz), 4 (xyzw)
+			uint32_t components = 0;
+			bool smallestThree = false;
+			float timeStart = 0.0f;
+			float timeRange = 0.0f;
+			vec4 rangeMin{};
+			vec4 rangeExtent{};
+			vector<uint16_t> times;
+			vector<uint16_t> values;
+		}compressed;
+
+		bool IsValid() const;
+		bool IsCompressed() const { return compressed.keyCount > 0; }
+		size_t KeyCount() const;
+		float KeyTime(size_t index) const;
+		vec4 Output(size_t index) const;
+		vec4 Sample(float time, AnimationChannel::PathType path) const;
+		void SampleWeights(float time, float* weights, size_t weightCount) const;
+		void Compress(AnimationChannel::PathType path, float tolerance);
+	};
+
+	/*************************************************************************
+	 *  анимация glTF
+	 *
+	***********************************************************************/
+	struct Animation
+	{
+		string name;
+		vector<AnimationChannel>channels;
+		vector<AnimationSampler>samplers;
+		float start = numeric_limits<float>::max();
+		float end = numeric_limits<float>::min();
+	};
+
+	/*************************************************************************
+	 * поза анимации в формате SoA (по массиву на компоненту)
+	 *
+	***********************************************************************/
+	struct AnimationPose
+	{
+		vector<float> translation[3];
+		vector<float> rotation[4];
+		vector<float> scale[3];
+
+		size_t Size() const { return translation[0].size(); }
+		void Resize(size_t count);
+		void Set(size_t slot, const vec3& t, const quat& r, const vec3& s);
+	};
+
+	/*************************************************************************
+	 * скомпилированный клип анимации: кадры с постоянным шагом,
+	 * узлы одного кадра идут подряд (frame * nodes.size() + slot)
+	 *
+	***********************************************************************/
+	struct AnimationClip
+	{
+		enum PathMask { TRANSLATION_BIT = 0x1, ROTATION_BIT = 0x2, SCALE_BIT = 0x4 };
+
+		string name;
+		float start = 0.0f;
+		float end = 0.0f;
+		float sampleRate = 30.0f;
+		uint32_t frameCount = 0;
+		vector<Node*> nodes;
+		vector<uint8_t> paths;
+		AnimationPose frames;
+
+		void Compile(const Animation& animation, float sampleRate);
+		void Sample(float time, AnimationPose& pose) const;
+		void Apply(const AnimationPose& pose) const;
+	};
+
+	/*************************************************************************
+	 * рассчитанная поза модели без записи в память устройства:
+	 * мировые матрицы узлов (по Node::index), палитры всех скинов
+	 * (в раскладке Model::jointBuffer) и веса морфинга всех граней
+	 * (по Mesh::weightOffset)
+	 *
+	***********************************************************************/
+	struct ModelPose
+	{
+		vector<mat4> worldMatrices;
+		vector<mat4> jointMatrices;
+		vector<float> morphWeights;
+	};
+
+	/*************************************************************************
+	 * слои glTF модели
+	 *
+	***********************************************************************/
+	enum class VertexComponent{Position, Normal, UV, Color, Tangent, Joint0, Weight0};
+
+	struct Vertex
+	{
+		vec3 pos;
+		vec3 normal;
+		vec2 uv;
+		vec4 color;
+		vec4 joint0;
+		vec4 weight0;
+		vec4 tangent;
+		static VkVertexInputBindingDescription vertexInputBindingDescription;
+		static vector<VkVertexInputAttributeDescription> vertexInputAttributeDescriptions;
+		static VkPipelineVertexInputStateCreateInfo pipelineVertexInputStateCreateInfo;
+
+		static VkVertexInputBindingDescription InputBindingDescription(uint32_t binding);
+		static VkVertexInputAttributeDescription InputAttributeDescription(uint32_t binding, uint32_t location, VertexComponent component);
+		static vector<VkVertexInputAttributeDescription> InputAttributeDescriptions(uint32_t binding, const vector<VertexComponent> components);
+		static VkPipelineVertexInputStateCreateInfo* GetPipelineVertexInputState(const vector<VertexComponent> components);
+	};
+
+	enum FileLoadingFlags { None = 0x0, PreTransformVertices = 0x1, PreMultiplyVertexColors = 0x2, FlipY = 0x4, DontLoadImages = 0x8, CompiledAnimations = 0x10, CompressedAnimations = 0x20, BindlessMaterials = 0x40 };
+	
+	//PushMaterialIndex: Material::index передается константой uint offset 0 (стадии вершин и фрагментов)
+	//PushNodeMatrix: матрица грани без скина передается константой mat4 offset PUSH_NODE_MATRIX_OFFSET
+	//(стадия вершин) вместо набора грани, грани со скином связывают набор при BindNodeUniforms.
+	//Матрица копируется в командный буфер при записи: с PushNodeMatrix буфер нужно
+	//перезаписывать каждый кадр, заранее записанный буфер годится только для
+	//неподвижных узлов (анимированные узлы останутся в позе момента записи)
+	enum RenderFlag { BindImages = 0x1, BindNodeUniforms = 0x2, PushMaterialIndex = 0x4, PushNodeMatrix = 0x8 };
+	static constexpr uint32_t PUSH_NODE_MATRIX_OFFSET = 16;
+
+	/*************************************************************************
+	 * данные непрямой отрисовки примитива (std430), индекс записи
+	 * передается в firstInstance команды и читается как gl_InstanceIndex
+	 * (ненулевой firstInstance в непрямой команде требует возможности
+	 * drawIndirectFirstInstance, без нее Model::DrawIndirect рисует
+	 * прямыми командами)
+	 *
+	***********************************************************************/
+	struct DrawData
+	{
+		//начало блока грани в кольцевом буфере в единицах vec4
+		uint32_t transformIndex;
+		uint32_t materialIndex;
+		uint32_t firstIndex;
+		uint32_t indexCount;
+		//ограничивающая сфера примитива в системе координат узла: xyz - центр, w - радиус
+		vec4 bounds;
+	};
+
+	/*************************************************************************
+	 * параметры материала в буфере материалов (std430) для режима
+	 * BindlessMaterials, текстуры - индексы в массиве изображений
+	 * набора descriptorSetLayoutBindless, -1 - текстуры нет
+	 *
+	***********************************************************************/
+	struct MaterialData
+	{
+		vec4 baseColorFactor;
+		float metallicFactor;
+		float roughnessFactor;
+		float alphaCutoff;
+		uint32_t alphaMode;
+		int32_t baseColorTexture;
+		int32_t metallicRoughnessTexture;
+		int32_t normalTexture;
+		int32_t occlusionTexture;
+		int32_t emissiveTexture;
+		int32_t padding[3];
+	};
+
+	//диапазон команд непрямой отрисовки одного конвейера (по Material::AlphaMode)
+	struct IndirectBatch
+	{
+		uint32_t firstCommand = 0;
+		uint32_t commandCount = 0;
+	};
+	
+	/*************************************************************************
+	 * класс для загрузки и отображения glTF модели
+	 *
+	***********************************************************************/
+	class Model
+	{
+		Texture* GetTexture(uint32_t index);
+
+	public:
+		VulkanDevice* device = nullptr;
+		VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+		
+		struct Vertices
+		{
+			int count = 0;
+			VkBuffer buffer = VK_NULL_HANDLE;
+			vks::Allocation memory;
+		}vertices;
+
+		struct Indices
+		{
+			int count = 0;
+			VkBuffer buffer = VK_NULL_HANDLE;
+			vks::Allocation memory;
+		}indices;
+
+		//владельцы объектов сцены, дети узла лежат в nodePool подряд
+		Pool<Node> nodePool;
+		Pool<Mesh> meshPool;
+		Pool<Primitive> primitivePool;
+		Pool<Skin> skinPool;
+
+		vector<Node*> nodes;
+		vector<Node*> linearNodes;
+
+		vector<Skin*>skins;
+		//палитры всех скинов: копия на процессоре и буфер с областью на каждый кадр в полете
+		vector<mat4> jointPalette;
+		Buffer jointBuffer;
+		//число весов морфинга всех граней (размер ModelPose::morphWeights)
+		uint32_t morphWeightCount = 0;
+		//число кадров в полете, LoadFromFile() берет его из VulkanDevice::framesInFlight
+		uint32_t framesInFlight = 1;
+		NodeUniformRing uniformRing;
+
+		//непрямая отрисовка: команда и данные на каждый примитив сцены
+		Buffer indirectBuffer;
+		Buffer drawDataBuffer;
+		VkDescriptorSet indirectDescriptorSet = VK_NULL_HANDLE;
+		uint32_t indirectCommandCount = 0;
+		IndirectBatch indirectBatches[3];
+		//копия команд на процессоре для прямой отрисовки без drawIndirectFirstInstance
+		vector<VkDrawIndexedIndirectCommand> indirectCommands;
+
+		//все материалы одним буфером, все текстуры одним массивом (FileLoadingFlags::BindlessMaterials),
+		//массив не больше пределов устройства на сэмплеры и изображения (bindlessTextureCapacity)
+		static constexpr uint32_t MAX_BINDLESS_TEXTURES = 4096;
+		Buffer materialBuffer;
+		VkDescriptorSet bindlessDescriptorSet = VK_NULL_HANDLE;
+
+		//мировые границы примитивов для отсечения на процессоре
+		BoxArray worldBounds;
+		vector<uint8_t> visiblePrimitives;
+
+		//примитивы по Material::AlphaMode, собираются при загрузке в порядке обхода узлов
+		struct PrimitiveDraw
+		{
+			Node* node;
+			Primitive* primitive;
+		};
+		vector<PrimitiveDraw> alphaBuckets[3];
+
+		vector<Texture>textures;
+		vector<Material>materials;
+		vector<Animation>animations;
+		vector<AnimationClip>clips;
+		AnimationPose animationPose;
+		float animationSampleRate = 30.0f;
+		float animationTolerance = 0.001f;
+
+		struct Dimensions
+		{
+			vec3 min = vec3(FLT_MAX);
+			vec3 max = vec3(FLT_MIN);
+			vec3 size;
+			vec3 center;
+			float radius;
+		}dimensions;
+
+		bool metallicRoughnessWorkflow = true;
+		bool buffersBound = false;
+		string path;
+		
+		Model();
+		~Model();
+
+		void LoadNode(Node* parent, Node* newNode, const tinygltf::Node& node, uint32_t nodeIndex, const tinygltf::Model& model, vector<uint32_t>
+		              & indexBuffer, vector<Vertex>& vertexBuffer, float globalScale);
+		void LoadSkins(tinygltf::Model& gltfModel);
+		void PrepareJointBuffer();
+		void loadImage(tinygltf::Model& gltfModel, VulkanDevice* device, VkQueue transferQueue);
+		void LoadMaterials(tinygltf::Model& gltfModel);
+		void LoadAnimations(tinygltf::Model& gltfModel);
+		void LoadFromFile(string filename, VulkanDevice* device, VkQueue transferQueue, uint32_t fileLoadingFlags = FileLoadingFlags::None, float scale = 1.0f);
+		void Unload();
+		void BindBuffers(VkCommandBuffer commandBuffer);
+		void BindBuffers(VkCommandBuffer commandBuffer, VkBuffer vertexBuffer, VkDeviceSize vertexOffset = 0);
+		void BindBuffers(vks::CommandRecorder& recorder);
+		void BindBuffers(vks::CommandRecorder& recorder, VkBuffer vertexBuffer, VkDeviceSize vertexOffset = 0);
+		static void BindNodeTransform(vks::CommandRecorder& recorder, const Mesh* mesh, uint32_t renderFlags, VkPipelineLayout pipelineLayout, uint32_t bindNodeSet);
+		static vks::CommandRecorder::Statistics DrawNode(Node* node, VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		static void DrawNode(Node* node, vks::CommandRecorder& recorder, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		vks::CommandRecorder::Statistics draw(VkCommandBuffer commandBuffer, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0);
+		void draw(vks::CommandRecorder& recorder, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0);
+		vks::CommandRecorder::Statistics draw(VkCommandBuffer commandBuffer, const vks::Frustum& frustum, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const vks::OcclusionBuffer* occlusion = nullptr);
+		void draw(vks::CommandRecorder& recorder, const vks::Frustum& frustum, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const vks::OcclusionBuffer* occlusion = nullptr);
+		vks::CommandRecorder::Statistics DrawVisible(VkCommandBuffer commandBuffer, const uint8_t* visible, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0);
+		void DrawVisible(vks::CommandRecorder& recorder, const uint8_t* visible, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0);
+		void UpdateBounds();
+		void BuildAlphaBuckets();
+		vks::CommandRecorder::Statistics DrawAlphaMode(VkCommandBuffer commandBuffer, Material::AlphaMode alphaMode, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		void DrawAlphaMode(vks::CommandRecorder& recorder, Material::AlphaMode alphaMode, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		vks::CommandRecorder::Statistics DrawDepthPrepass(VkCommandBuffer commandBuffer, VkPipeline opaquePipeline, VkPipeline maskPipeline, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		void DrawDepthPrepass(vks::CommandRecorder& recorder, VkPipeline opaquePipeline, VkPipeline maskPipeline, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		vks::CommandRecorder::Statistics DrawBlended(VkCommandBuffer commandBuffer, vec3 cameraPosition, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		void DrawBlended(vks::CommandRecorder& recorder, vec3 cameraPosition, uint32_t renderFlags = 0, VkPipelineLayout pipelineLayout = VK_NULL_HANDLE, uint32_t bindImageSet = 1, uint32_t bindNodeSet = 0, const uint8_t* visible = nullptr);
+		void BindIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t bindSet = 1);
+		void BindIndirect(vks::CommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t bindSet = 1);
+		vks::CommandRecorder::Statistics DrawIndirect(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, Material::AlphaMode alphaMode, uint32_t bindSet = 1);
+		void DrawIndirect(vks::CommandRecorder& recorder, VkPipelineLayout pipelineLayout, Material::AlphaMode alphaMode, uint32_t bindSet = 1);
+		void BindMaterials(VkCommandBuffer commandBuffer, VkPipelineLayout pipelineLayout, uint32_t bindSet = 2);
+		void BindMaterials(vks::CommandRecorder& recorder, VkPipelineLayout pipelineLayout, uint32_t bindSet = 2);
+		void BeginFrame(uint32_t frameIndex);
+		void GetNodeDimensions(Node* node, vec3& min, vec3& max);
+		void GetSceneDimensions();
+		void CompileAnimations(float sampleRate);
+		void CompressAnimations(float tolerance);
+		void UpdateAnimation(uint32_t index, float time);
+		bool AnimateNodes(uint32_t index, float time, ModelPose* pose = nullptr);
+		void EvaluatePose(ModelPose& pose);
+		void UploadPose(const ModelPose& pose);
+		static Node* FindNode(Node* parent, uint32_t index);
+		Node* nodeFromIndex(uint32_t index);
+		void PrepareUniformRing(VkDescriptorSetLayout descriptorSetLayout);
+		void PrepareIndirect(VkDescriptorSetLayout descriptorSetLayout);
+		void PrepareBindless(VkDescriptorSetLayout descriptorSetLayout);
+	};
+}
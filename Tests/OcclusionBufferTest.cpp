@@ -0,0 +1,147 @@
+/*************************************************************************
+ *      
+ *
+ *    Vulkan,   0 -   .
+ *  (  Tests),     -mavx2   :
+ *	g++ -std=c++17 -O2 -I../Files OcclusionBufferTest.cpp ../Files/OcclusionBuffer.cpp -pthread
+ *
+***********************************************************************/
+#include "OcclusionBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+static int failures = 0;
+
+static void Check(bool condition, const char* name)
+{
+	if (!condition)
+	{
+		std::printf("FAILED: %s\n", name);
+		failures++;
+	}
+}
+
+// z = const    ( ), x, y  [-1, 1]
+static void AddWall(vks::OcclusionBuffer& buffer, float minX, float minY, float maxX, float maxY, float z)
+{
+	const std::vector<glm::vec3> positions = { { minX, minY, z }, { maxX, minY, z }, { maxX, maxY, z }, { minX, maxY, z } };
+	const std::vector<uint32_t> indices = { 0, 1, 2, 0, 2, 3 };
+	buffer.AddOccluder(positions, indices);
+}
+
+int main()
+{
+	const glm::mat4 identity(1.0f);
+
+	//   ,       
+	{
+		vks::OcclusionBuffer buffer;
+		buffer.Init(256, 128, 4);
+		AddWall(buffer, -0.5f, -0.5f, 0.5f, 0.5f, 0.5f);
+		buffer.Render(identity);
+		Check(!buffer.TestBox({ -0.2f, -0.2f, 0.6f }, { 0.2f, 0.2f, 0.7f }), "box behind wall is occluded");
+		Check(buffer.TestBox({ -0.2f, -0.2f, 0.3f }, { 0.2f, 0.2f, 0.4f }), "box in front of wall is visible");
+		Check(buffer.TestBox({ -0.7f, -0.2f, 0.6f }, { 0.2f, 0.2f, 0.7f }), "box past wall edge is visible");
+		Check(buffer.TestBox({ -0.2f, -0.2f, 0.6f }, { 0.2f, 0.2f, 0.7f }) == false, "repeated test is stable");
+	}
+
+	//       : , 
+	//  ,    
+	{
+		vks::OcclusionBuffer buffer;
+		buffer.Init(256, 128, 1);
+		//  x: (x + 1) * 128,    192.6,   192.9
+		AddWall(buffer, -0.5f, -0.5f, 192.6f / 128.0f - 1.0f, 0.5f, 0.5f);
+		buffer.Render(identity);
+		Check(buffer.TestBox({ 0.0f, -0.2f, 0.6f }, { 192.9f / 128.0f - 1.0f, 0.2f, 0.7f }), "box over partially covered pixel is visible");
+		Check(!buffer.TestBox({ 0.0f, -0.2f, 0.6f }, { 191.9f / 128.0f - 1.0f, 0.2f, 0.7f }), "box over fully covered pixels is occluded");
+	}
+
+	// :         
+	{
+		vks::OcclusionBuffer buffer;
+		buffer.Init(64, 64, 2);
+		const std::vector<glm::vec3> positions = { { -1.0f, -1.0f, 0.2f }, { 1.0f, -1.0f, 0.8f }, { 1.0f, 1.0f, 0.8f }, { -1.0f, 1.0f, 0.2f } };
+		const std::vector<uint32_t> indices = { 0, 1, 2, 0, 2, 3 };
+		buffer.AddOccluder(positions, indices);
+		buffer.Render(identity);
+		bool conservative = true;
+		for (uint32_t y = 0; y < buffer.height; y++)
+		{
+			for (uint32_t x = 0; x < buffer.width; x++)
+			{
+				//z    x: 0.2   , 0.8  
+				const float farthest = 0.2f + 0.6f * (x + 1.0f) / buffer.width;
+				const float stored = buffer.Depth(x, y);
+				if (stored < 1.0f && stored < farthest - 1e-5f)
+					conservative = false;
+			}
+		}
+		Check(conservative, "sloped wall depth is the pixel maximum");
+	}
+
+	//   :     ,    
+	//     
+	{
+		vks::OcclusionBuffer buffer;
+		buffer.Init(64, 64, 2);
+		const std::vector<glm::vec3> positions = {
+			{ -1.0f, -1.0f, 0.8f }, { 0.0f, -1.0f, 0.2f }, { 1.0f, -1.0f, 0.8f },
+			{ -1.0f, 1.0f, 0.8f }, { 0.0f, 1.0f, 0.2f }, { 1.0f, 1.0f, 0.8f } };
+		const std::vector<uint32_t> indices = { 0, 1, 4, 0, 4, 3, 1, 2, 5, 1, 5, 4 };
+		buffer.AddOccluder(positions, indices);
+		buffer.Render(identity);
+		bool conservative = true;
+		for (uint32_t y = 0; y < buffer.height; y++)
+		{
+			for (uint32_t x = 0; x < buffer.width; x++)
+			{
+				//z = 0.2 + 0.6 * |x|,        
+				const float left = std::fabs(2.0f * x / buffer.width - 1.0f);
+				const float right = std::fabs(2.0f * (x + 1.0f) / buffer.width - 1.0f);
+				const float farthest = 0.2f + 0.6f * std::max(left, right);
+				const float stored = buffer.Depth(x, y);
+				if (stored < 1.0f && stored < farthest - 1e-5f)
+					conservative = false;
+			}
+		}
+		Check(conservative, "ridge depth is the pixel maximum");
+		Check(buffer.Depth(31, 32) < 1.0f && buffer.Depth(32, 32) < 1.0f, "no crack along the ridge");
+		Check(!buffer.TestBox({ -0.5f, -0.5f, 0.9f }, { 0.5f, 0.5f, 0.95f }), "box behind ridge is occluded");
+	}
+
+	//           
+	{
+		vks::OcclusionBuffer buffer;
+		buffer.Init(128, 64, 2);
+		const std::vector<glm::vec3> positions = { { -0.5f, -0.5f, 0.5f }, { 1e12f, -0.5f, 0.5f }, { -0.5f, 1e12f, 0.5f } };
+		const std::vector<uint32_t> indices = { 0, 1, 2 };
+		buffer.AddOccluder(positions, indices);
+		buffer.Render(identity);
+		Check(!buffer.TestBox({ 0.0f, 0.0f, 0.6f }, { 0.5f, 0.5f, 0.7f }), "huge triangle occludes box");
+	}
+
+	//    
+	{
+		vks::OcclusionBuffer single, parallel;
+		single.Init(256, 128, 1);
+		parallel.Init(256, 128, 8);
+		for (vks::OcclusionBuffer* buffer : { &single, &parallel })
+		{
+			AddWall(*buffer, -0.9f, -0.3f, 0.1f, 0.7f, 0.4f);
+			AddWall(*buffer, -0.2f, -0.8f, 0.6f, 0.2f, 0.6f);
+			buffer->Render(identity);
+		}
+		bool same = true;
+		for (uint32_t y = 0; y < single.height; y++)
+			for (uint32_t x = 0; x < single.width; x++)
+				same &= single.Depth(x, y) == parallel.Depth(x, y);
+		Check(same, "thread count does not change depth");
+	}
+
+	if (failures == 0)
+		std::printf("all occlusion buffer checks passed\n");
+	return failures == 0 ? 0 : 1;
+}
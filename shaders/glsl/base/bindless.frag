@@ -0,0 +1,56 @@
+#version 450
+#extension GL_EXT_nonuniform_qualifier : require
+
+// Материалы без набора на примитив (FileLoadingFlags::BindlessMaterials)
+// Номер материала приходит из indirect.vert (DrawData) или константой RenderFlag::PushMaterialIndex
+
+layout (location = 0) in vec3 inNormal;
+layout (location = 1) in vec4 inColor;
+layout (location = 2) in vec2 inUV;
+layout (location = 3) flat in uint inMaterialIndex;
+
+struct MaterialData
+{
+	vec4 baseColorFactor;
+	float metallicFactor;
+	float roughnessFactor;
+	float alphaCutoff;
+	uint alphaMode;
+	int baseColorTexture;
+	int metallicRoughnessTexture;
+	int normalTexture;
+	int occlusionTexture;
+	int emissiveTexture;
+};
+
+layout (std430, set = 2, binding = 0) readonly buffer Materials
+{
+	MaterialData materials[];
+};
+
+layout (set = 2, binding = 1) uniform sampler2D textures[];
+
+layout (location = 0) out vec4 outFragColor;
+
+const uint ALPHAMODE_MASK = 1;
+
+vec4 sampleTexture(int index, vec4 fallback)
+{
+	return index < 0 ? fallback : texture(textures[nonuniformEXT(index)], inUV);
+}
+
+void main()
+{
+	MaterialData material = materials[inMaterialIndex];
+	vec4 color = material.baseColorFactor * inColor * sampleTexture(material.baseColorTexture, vec4(1.0));
+	if (material.alphaMode == ALPHAMODE_MASK && color.a < material.alphaCutoff)
+		discard;
+
+	float occlusion = sampleTexture(material.occlusionTexture, vec4(1.0)).r;
+	vec3 emissive = sampleTexture(material.emissiveTexture, vec4(0.0)).rgb;
+
+	vec3 N = normalize(inNormal);
+	vec3 L = normalize(vec3(0.5, 1.0, 0.3));
+	float diffuse = max(dot(N, L), 0.0);
+	outFragColor = vec4(color.rgb * (0.1 + diffuse) * occlusion + emissive, color.a);
+}
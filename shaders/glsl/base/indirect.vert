@@ -0,0 +1,74 @@
+#version 450
+
+// Непрямая отрисовка модели (Model::DrawIndirect)
+// Номер записи DrawData передается в firstInstance команды
+
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inUV;
+layout (location = 3) in vec4 inColor;
+layout (location = 4) in vec4 inJointIndices;
+layout (location = 5) in vec4 inJointWeights;
+
+layout (set = 0, binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+struct DrawData
+{
+	uint transformIndex;
+	uint materialIndex;
+	uint firstIndex;
+	uint indexCount;
+	vec4 bounds;
+};
+
+// блоки граней текущего кадра: mat4 matrix, uint jointOffset, uint jointCount
+layout (std430, set = 1, binding = 0) readonly buffer NodeBlocks
+{
+	vec4 nodeData[];
+};
+
+layout (std430, set = 1, binding = 1) readonly buffer JointMatrices
+{
+	mat4 jointMatrices[];
+};
+
+layout (std430, set = 1, binding = 2) readonly buffer Draws
+{
+	DrawData draws[];
+};
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec4 outColor;
+layout (location = 2) out vec2 outUV;
+layout (location = 3) flat out uint outMaterialIndex;
+
+void main()
+{
+	DrawData draw = draws[gl_InstanceIndex];
+	uint base = draw.transformIndex;
+	mat4 nodeMatrix = mat4(nodeData[base], nodeData[base + 1], nodeData[base + 2], nodeData[base + 3]);
+	uint jointOffset = floatBitsToUint(nodeData[base + 4].x);
+	uint jointCount = floatBitsToUint(nodeData[base + 4].y);
+
+	mat4 skinMatrix = mat4(1.0);
+	if (jointCount > 0)
+	{
+		uvec4 joints = uvec4(inJointIndices) + jointOffset;
+		skinMatrix =
+			inJointWeights.x * jointMatrices[joints.x] +
+			inJointWeights.y * jointMatrices[joints.y] +
+			inJointWeights.z * jointMatrices[joints.z] +
+			inJointWeights.w * jointMatrices[joints.w];
+	}
+
+	mat4 modelMatrix = nodeMatrix * skinMatrix;
+	outNormal = normalize(transpose(inverse(mat3(modelMatrix))) * inNormal);
+	outColor = inColor;
+	outUV = inUV;
+	outMaterialIndex = draw.materialIndex;
+	gl_Position = ubo.projection * ubo.view * modelMatrix * vec4(inPos, 1.0);
+}
@@ -0,0 +1,35 @@
+#version 450
+
+// Отрисовка граней без скина с матрицей в константах (RenderFlag::PushNodeMatrix)
+// Набор грани не связывается; materialIndex - RenderFlag::PushMaterialIndex
+
+layout (location = 0) in vec3 inPos;
+layout (location = 1) in vec3 inNormal;
+layout (location = 2) in vec2 inUV;
+layout (location = 3) in vec4 inColor;
+
+layout (set = 0, binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+layout (push_constant) uniform PushConsts
+{
+	uint materialIndex;
+	layout (offset = 16) mat4 model;
+} pushConsts;
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec4 outColor;
+layout (location = 2) out vec2 outUV;
+layout (location = 3) flat out uint outMaterialIndex;
+
+void main()
+{
+	outNormal = normalize(transpose(inverse(mat3(pushConsts.model))) * inNormal);
+	outColor = inColor;
+	outUV = inUV;
+	outMaterialIndex = pushConsts.materialIndex;
+	gl_Position = ubo.projection * ubo.view * pushConsts.model * vec4(inPos, 1.0);
+}
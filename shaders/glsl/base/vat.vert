@@ -0,0 +1,56 @@
+#version 450
+
+// Воспроизведение запеченной анимации вершин (VertexAnimationTexture)
+// Компоненты вершины: UV, Color; данные экземпляра с location 2
+
+layout (location = 0) in vec2 inUV;
+layout (location = 1) in vec4 inColor;
+layout (location = 2) in vec4 instancePosition;
+layout (location = 3) in vec4 instanceClip;
+
+layout (set = 0, binding = 0) uniform UBO
+{
+	mat4 projection;
+	mat4 view;
+} ubo;
+
+// слой 0 - позиции, слой 1 - нормали
+layout (set = 1, binding = 0) uniform sampler2DArray vatTexture;
+
+layout (push_constant) uniform PushConsts
+{
+	float time;
+	float sampleRate;
+	uint vertexCount;
+	uint width;
+} pushConsts;
+
+layout (location = 0) out vec3 outNormal;
+layout (location = 1) out vec4 outColor;
+layout (location = 2) out vec2 outUV;
+
+vec4 fetchTexel(uint frame, int layer)
+{
+	uint index = frame * pushConsts.vertexCount + uint(gl_VertexIndex);
+	return texelFetch(vatTexture, ivec3(index % pushConsts.width, index / pushConsts.width, layer), 0);
+}
+
+void main()
+{
+	// x - первый кадр клипа, y - число кадров, z - сдвиг по времени, w - скорость
+	// последний кадр совпадает с концом клипа: цикл из y - 1 интервалов без перехода от последнего к первому
+	float intervals = max(instanceClip.y - 1.0, 1.0);
+	float frame = mod((pushConsts.time * instanceClip.w + instanceClip.z) * pushConsts.sampleRate, intervals);
+	uint f0 = uint(frame);
+	uint f1 = min(f0 + 1u, uint(instanceClip.y) - 1u);
+	float u = fract(frame);
+	uint first = uint(instanceClip.x);
+
+	vec3 position = mix(fetchTexel(first + f0, 0).xyz, fetchTexel(first + f1, 0).xyz, u);
+	vec3 normal = mix(fetchTexel(first + f0, 1).xyz, fetchTexel(first + f1, 1).xyz, u);
+
+	outNormal = normalize(normal);
+	outColor = inColor;
+	outUV = inUV;
+	gl_Position = ubo.projection * ubo.view * vec4(position * instancePosition.w + instancePosition.xyz, 1.0);
+}